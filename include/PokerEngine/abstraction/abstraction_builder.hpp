@@ -0,0 +1,252 @@
+#ifndef POKER_ENGINE_ABSTRACTION_ABSTRACTION_BUILDER_HPP
+#define POKER_ENGINE_ABSTRACTION_ABSTRACTION_BUILDER_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+#include "PokerEngine/simulator/hand_strength.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+#include "PokerEngine/abstraction/bucket_table.hpp"
+#include "PokerEngine/abstraction/detail/kmeans.hpp"
+
+namespace PokerEngine::Abstraction {
+
+constexpr Core::CardMask FULL_DECK = (Core::CardMask{1} << Core::NUM_CARDS) - 1;
+
+namespace detail {
+    /**
+     * @brief Calls fn(mask) for every k card subset of available, in ascending order of the masks
+     */
+    template<typename Fn>
+    void for_each_subset_ascending(Core::CardMask available, int k, Fn&& fn) {
+        std::array<Core::CardMask, Core::NUM_CARDS> cards{};
+        int n = 0;
+        for (; available; available &= available - 1) cards[n++] = available & (~available + 1);
+        if (k < 0 || k > n) return;
+        if (k == 0) {
+            fn(Core::CardMask{0});
+            return;
+        }
+        // Gosper's hack over positions in cards, which ascend, so the card masks ascend with them
+        const uint64_t end = uint64_t{1} << n;
+        for (uint64_t positions = (uint64_t{1} << k) - 1; positions < end;) {
+            Core::CardMask mask = 0;
+            for (uint64_t p = positions; p; p &= p - 1) mask |= cards[std::countr_zero(p)];
+            fn(mask);
+            const uint64_t low = positions & (~positions + 1);
+            const uint64_t ripple = positions + low;
+            positions = (((ripple ^ positions) >> 2) / low) | ripple;
+        }
+    }
+}
+
+/**
+ * @brief Calls fn(board, hero) once for every suit canonical situation with board_size board cards,
+ * i.e. once per suit isomorphism class, in ascending situationKey order. Cards are drawn from deck,
+ * which must contain the same ranks in every suit.
+ */
+template<typename Fn>
+void forEachCanonicalSituation(Core::CardMask deck, int board_size, Fn&& fn) {
+    for (const auto& perm : Core::SUIT_PERMUTATIONS) {
+        if (Core::permuteSuits(deck, perm) != deck)
+            throw std::invalid_argument("Deck must be unchanged by suit relabelling");
+    }
+
+    std::vector<const Core::SuitPermutation*> stabiliser;
+    detail::for_each_subset_ascending(deck, board_size, [&](Core::CardMask board) {
+        // canonical means the board is the smallest relabelling and the hole cards are the smallest
+        // among relabellings leaving the board unchanged
+        stabiliser.clear();
+        for (const auto& perm : Core::SUIT_PERMUTATIONS) {
+            const Core::CardMask permuted = Core::permuteSuits(board, perm);
+            if (permuted < board) return;
+            if (permuted == board) stabiliser.push_back(&perm);
+        }
+
+        // the key orders hole cards by their combo index, which ascends with the mask
+        detail::for_each_subset_ascending(deck & ~board, 2, [&](Core::CardMask hero) {
+            for (const auto* perm : stabiliser) {
+                if (Core::permuteSuits(hero, *perm) < hero) return;
+            }
+            fn(board, hero);
+        });
+    });
+}
+
+struct AbstractionOptions {
+    // Cards in play, must be closed under suit relabelling. A reduced deck makes small test abstractions.
+    Core::CardMask deck = FULL_DECK;
+    // 3 flop, 4 turn, 5 river
+    int board_size = 3;
+    uint16_t num_buckets = 200;
+    // Equity histogram bins per situation, river situations are clustered on their equity alone
+    size_t bins = 50;
+    int max_iterations = 100;
+    // Clustering stops once at most this fraction of situations change bucket in an iteration
+    double tolerance = 1e-3;
+    unsigned threads = std::thread::hardware_concurrency();
+    uint32_t seed = 1;
+    // Where histograms are streamed while clustering, defaults to the output path with ".features" appended
+    std::string scratch_path;
+    // Called with (stage, done, total) from worker threads, stages are "histograms" and "clustering"
+    std::function<void(const char*, size_t, size_t)> progress;
+};
+
+struct AbstractionStats {
+    size_t situations = 0;
+    int iterations = 0;
+    double inertia = 0.0;
+};
+
+/**
+ * @brief Cluster every canonical situation of one street by its equity histogram against a random hand
+ * and write the resulting BucketTable to path.
+ *
+ * Nothing held in memory grows with the number of situations, so the river's 2.4 billion build on an
+ * ordinary machine given the disk space. Situations are enumerated in key order and their keys streamed
+ * straight into the table file. Histograms are computed in parallel into a scratch file, and k-means
+ * reads them and writes bucket ids through memory mappings of the scratch and table files. Histograms are
+ * stored cumulatively, which makes the Euclidean k-means distance an approximation of the earth mover's
+ * distance between the histograms. This is an offline job, the full flop abstraction takes hours of CPU
+ * time. On failure neither file is left behind.
+ */
+inline AbstractionStats buildAbstraction(const std::string& path, const AbstractionOptions& options = {}) {
+    if (options.board_size < 3 || options.board_size > Simulator::detail::MAX_BOARD_SIZE_NLH)
+        throw std::invalid_argument("Abstractions are built for the flop, turn or river");
+    if (options.num_buckets == 0 || options.bins == 0)
+        throw std::invalid_argument("Need at least one bucket and one histogram bin");
+
+    using Header = BucketTable::BucketTableHeader;
+    AbstractionStats stats{};
+    const unsigned num_threads = std::max(1u, options.threads);
+    // a river situation has a single runout, its equity is the whole distribution
+    const bool river = options.board_size == Simulator::detail::MAX_BOARD_SIZE_NLH;
+    const size_t dim = river ? 1 : options.bins;
+    const size_t row_bytes = dim * sizeof(float);
+    const std::string scratch = options.scratch_path.empty() ? path + ".features" : options.scratch_path;
+
+    try {
+        // keys follow a placeholder header, which is filled in last once the table is complete
+        size_t count = 0;
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot open file for writing: " + path);
+            const Header placeholder{};
+            out.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+
+            std::vector<uint64_t> buffer;
+            buffer.reserve(size_t{1} << 16);
+            auto flush = [&] {
+                out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(uint64_t)));
+                buffer.clear();
+            };
+            forEachCanonicalSituation(options.deck, options.board_size, [&](Core::CardMask board, Core::CardMask hero) {
+                buffer.push_back(situationKey(board, hero));
+                if (buffer.size() == buffer.capacity()) flush();
+                ++count;
+            });
+            flush();
+            if (!out) throw std::runtime_error("Failed writing bucket table: " + path);
+        }
+        stats.situations = count;
+        std::filesystem::resize_file(path, sizeof(Header) + count * (sizeof(uint64_t) + sizeof(uint16_t)));
+
+        Core::detail::MappedFile table(path, Core::detail::MappedFile::Access::ReadWrite);
+        const uint64_t* keys = reinterpret_cast<const uint64_t*>(table.data() + sizeof(Header));
+        uint16_t* buckets = reinterpret_cast<uint16_t*>(table.writableData() + sizeof(Header) + count * sizeof(uint64_t));
+
+        {
+            std::ofstream out(scratch, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot open file for writing: " + scratch);
+            if (count > 0) {
+                out.seekp(static_cast<std::streamoff>(count * row_bytes - 1));
+                out.put('\0');
+            }
+            if (!out) throw std::runtime_error("Cannot size scratch file: " + scratch);
+        }
+
+        constexpr size_t BLOCK = 256;
+        std::atomic<size_t> next_block{0}, done{0};
+        std::vector<std::exception_ptr> errors(num_threads);
+        {
+            std::vector<std::jthread> workers;
+            for (unsigned t = 0; t < num_threads; ++t) {
+                workers.emplace_back([&, t] {
+                    try {
+                        Simulator::HandStrengthEngine engine{dim};
+                        std::fstream out(scratch, std::ios::binary | std::ios::in | std::ios::out);
+                        if (!out) throw std::runtime_error("Cannot open scratch file: " + scratch);
+                        std::vector<float> rows(BLOCK * dim);
+
+                        for (size_t begin = next_block++ * BLOCK; begin < count; begin = next_block++ * BLOCK) {
+                            const size_t end = std::min(begin + BLOCK, count);
+                            for (size_t i = begin; i < end; ++i) {
+                                const auto hs = engine.compute(keyHero(keys[i]), keyBoard(keys[i]), FULL_DECK & ~options.deck);
+                                float* row = rows.data() + (i - begin) * dim;
+                                if (river) {
+                                    row[0] = static_cast<float>(hs.ehs);
+                                    continue;
+                                }
+                                double cumulative = 0.0;
+                                for (size_t b = 0; b < dim; ++b) row[b] = static_cast<float>(cumulative += hs.histogram[b]);
+                            }
+                            out.seekp(static_cast<std::streamoff>(begin * row_bytes));
+                            out.write(reinterpret_cast<const char*>(rows.data()), static_cast<std::streamsize>((end - begin) * row_bytes));
+                            if (!out) throw std::runtime_error("Failed writing scratch file: " + scratch);
+
+                            const size_t finished = done += end - begin;
+                            if (options.progress) options.progress("histograms", finished, count);
+                        }
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                        next_block = count; // stop the other workers early
+                    }
+                });
+            }
+        }
+        for (const auto& e : errors) {
+            if (e) std::rethrow_exception(e);
+        }
+
+        {
+            Core::detail::MappedFile features(scratch);
+            const auto clusters = detail::kmeans_into(reinterpret_cast<const float*>(features.data()), count, dim,
+                                                      options.num_buckets, buckets, options.max_iterations,
+                                                      options.tolerance, num_threads, options.seed,
+                                                      [&](int, size_t changed) {
+                                                          if (options.progress) options.progress("clustering", count - changed, count);
+                                                      });
+            stats.iterations = clusters.iterations;
+            stats.inertia = clusters.inertia;
+        }
+        std::filesystem::remove(scratch);
+
+        const Header header = BucketTable::makeHeader(options.board_size, options.num_buckets, count);
+        std::memcpy(table.writableData(), &header, sizeof(header));
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(scratch, ignored);
+        std::filesystem::remove(path, ignored);
+        throw;
+    }
+    return stats;
+}
+
+}
+
+#endif
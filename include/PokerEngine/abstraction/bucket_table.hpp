@@ -0,0 +1,148 @@
+#ifndef POKER_ENGINE_ABSTRACTION_BUCKET_TABLE_HPP
+#define POKER_ENGINE_ABSTRACTION_BUCKET_TABLE_HPP
+
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+
+namespace PokerEngine::Abstraction {
+
+/**
+ * @brief Packs a board and hole cards into one sortable key: board mask above the 11 bit combo index
+ */
+constexpr inline uint64_t situationKey(Core::CardMask board, Core::CardMask hero) noexcept {
+    const int low = std::countr_zero(hero);
+    const int high = 63 - std::countl_zero(hero);
+    return board << 11 | static_cast<uint64_t>(Core::comboIndex(low, high));
+}
+
+constexpr inline Core::CardMask keyBoard(uint64_t key) noexcept { return key >> 11; }
+
+constexpr inline Core::CardMask keyHero(uint64_t key) noexcept {
+    const auto [low, high] = Core::comboCardsFromIndex(static_cast<int>(key & 0x7FF));
+    return (Core::CardMask{1} << low) | (Core::CardMask{1} << high);
+}
+
+/**
+ * @brief Key of the suit canonical form of the situation, shared by all its suit relabellings
+ */
+constexpr inline uint64_t canonicalSituationKey(Core::CardMask board, Core::CardMask hero) noexcept {
+    const auto canonical = Core::canonicalise(std::array<Core::CardMask, 2>{board, hero});
+    return situationKey(canonical[0], canonical[1]);
+}
+
+/**
+ * @brief Bucket id of every suit canonical (board, hole cards) situation of one street, read from a
+ * memory mapped file written by buildAbstraction.
+ *
+ * File layout (native endian): BucketTableHeader, then count situation keys in ascending order
+ * (uint64) followed by their bucket ids (uint16).
+ */
+class BucketTable {
+public:
+    struct BucketTableHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t board_size;
+        uint32_t num_buckets;
+        uint64_t count;
+    };
+
+    static constexpr std::array<char, 4> MAGIC{'P', 'E', 'B', 'K'};
+    static constexpr uint32_t VERSION = 1;
+
+    explicit BucketTable(const std::string& path);
+
+    /**
+     * @brief Bucket of hero on board, any suit labelling
+     * @throws std::out_of_range if the situation is not in the table, e.g. a different street
+     */
+    uint16_t bucket(Core::CardMask hero, Core::CardMask board) const {
+        const uint64_t key = canonicalSituationKey(board, hero);
+        const uint64_t* it = std::lower_bound(keys_, keys_ + count_, key);
+        if (it == keys_ + count_ || *it != key)
+            throw std::out_of_range("Situation not in bucket table");
+        return buckets_[it - keys_];
+    }
+
+    size_t size() const noexcept { return count_; }
+    int boardSize() const noexcept { return board_size_; }
+    uint16_t numBuckets() const noexcept { return num_buckets_; }
+
+    std::span<const uint64_t> keys() const noexcept { return {keys_, count_}; }
+    std::span<const uint16_t> buckets() const noexcept { return {buckets_, count_}; }
+
+    static BucketTableHeader makeHeader(int board_size, uint16_t num_buckets, uint64_t count) noexcept {
+        BucketTableHeader header{};
+        std::memcpy(header.magic, MAGIC.data(), MAGIC.size());
+        header.version = VERSION;
+        header.board_size = static_cast<uint32_t>(board_size);
+        header.num_buckets = num_buckets;
+        header.count = count;
+        return header;
+    }
+
+    /**
+     * @brief Write a table file, keys must be canonical situation keys in ascending order
+     */
+    static void write(const std::string& path, int board_size, uint16_t num_buckets,
+                      std::span<const uint64_t> keys, std::span<const uint16_t> buckets);
+
+private:
+    Core::detail::MappedFile file_;
+    const uint64_t* keys_ = nullptr;
+    const uint16_t* buckets_ = nullptr;
+    size_t count_ = 0;
+    int board_size_ = 0;
+    uint16_t num_buckets_ = 0;
+};
+
+inline BucketTable::BucketTable(const std::string& path) : file_(path) {
+    BucketTableHeader header{};
+    if (file_.size() < sizeof(header))
+        throw std::runtime_error("Bucket table is truncated: " + path);
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC.data(), MAGIC.size()) != 0 || header.version != VERSION)
+        throw std::runtime_error("Not a compatible bucket table: " + path);
+    if (file_.size() != sizeof(header) + header.count * (sizeof(uint64_t) + sizeof(uint16_t)))
+        throw std::runtime_error("Bucket table has unexpected size: " + path);
+
+    count_ = static_cast<size_t>(header.count);
+    board_size_ = static_cast<int>(header.board_size);
+    num_buckets_ = static_cast<uint16_t>(header.num_buckets);
+    keys_ = reinterpret_cast<const uint64_t*>(file_.data() + sizeof(header));
+    buckets_ = reinterpret_cast<const uint16_t*>(keys_ + count_);
+}
+
+inline void BucketTable::write(const std::string& path, int board_size, uint16_t num_buckets,
+                               std::span<const uint64_t> keys, std::span<const uint16_t> buckets)
+{
+    if (keys.size() != buckets.size())
+        throw std::invalid_argument("Every key needs a bucket");
+    if (!std::is_sorted(keys.begin(), keys.end()))
+        throw std::invalid_argument("Bucket table keys must be sorted");
+
+    const BucketTableHeader header = makeHeader(board_size, num_buckets, keys.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot open file for writing: " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(uint16_t));
+    if (!out) throw std::runtime_error("Failed writing bucket table: " + path);
+}
+
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef POKER_ENGINE_ABSTRACTION_DETAIL_KMEANS_HPP
+#define POKER_ENGINE_ABSTRACTION_DETAIL_KMEANS_HPP
+
+#include <vector>
+#include <random>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace PokerEngine::Abstraction::detail {
+
+struct KMeansResult {
+    std::vector<uint16_t> assignment; // empty when the caller provides the storage
+    std::vector<float> centroids; // k rows of dim
+    int iterations = 0;
+    double inertia = 0.0;         // sum of squared distances to the assigned centroid
+};
+
+inline double squared_distance(const float* a, const float* b, size_t dim) noexcept {
+    double d = 0.0;
+    for (size_t i = 0; i < dim; ++i) {
+        const double diff = static_cast<double>(a[i]) - b[i];
+        d += diff * diff;
+    }
+    return d;
+}
+
+inline size_t nearest_centroid(const float* point, const std::vector<float>& centroids, size_t k, size_t dim,
+                               double& best_distance) noexcept
+{
+    size_t best = 0;
+    best_distance = std::numeric_limits<double>::max();
+    for (size_t c = 0; c < k; ++c) {
+        const double d = squared_distance(point, centroids.data() + c * dim, dim);
+        if (d < best_distance) {
+            best_distance = d;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief k-means++ seeding on a random sample of the points, so seeding cost does not grow with n
+ */
+inline std::vector<float> seed_centroids(const float* points, size_t n, size_t dim, size_t k, std::mt19937& rng) {
+    const size_t sample_size = std::min(n, std::max<size_t>(k * 32, 1024));
+    std::vector<size_t> sample(sample_size);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (size_t i = 0; i < sample_size; ++i) sample[i] = sample_size == n ? i : pick(rng);
+
+    std::vector<float> centroids;
+    centroids.reserve(k * dim);
+    const float* first = points + sample[pick(rng) % sample_size] * dim;
+    centroids.insert(centroids.end(), first, first + dim);
+
+    std::vector<double> distance(sample_size, std::numeric_limits<double>::max());
+    for (size_t c = 1; c < k; ++c) {
+        const float* last = centroids.data() + (c - 1) * dim;
+        double total = 0.0;
+        for (size_t i = 0; i < sample_size; ++i) {
+            distance[i] = std::min(distance[i], squared_distance(points + sample[i] * dim, last, dim));
+            total += distance[i];
+        }
+
+        size_t chosen = pick(rng) % sample_size;
+        if (total > 0.0) {
+            std::uniform_real_distribution<double> u(0.0, total);
+            double target = u(rng);
+            for (chosen = 0; chosen + 1 < sample_size && target >= distance[chosen]; ++chosen) target -= distance[chosen];
+        }
+        const float* next = points + sample[chosen] * dim;
+        centroids.insert(centroids.end(), next, next + dim);
+    }
+    return centroids;
+}
+
+/**
+ * @brief Lloyd's k-means over n row major points, each iteration split into contiguous slices across threads
+ * with per thread centroid sums reduced at the end. Stops after max_iterations or once fewer than
+ * tolerance * n points change cluster. Empty clusters keep their previous centroid.
+ * @param assignment n cluster ids, written in place so they can live in a memory mapped file
+ */
+inline KMeansResult kmeans_into(const float* points, size_t n, size_t dim, size_t k, uint16_t* assignment,
+                                int max_iterations, double tolerance, unsigned num_threads, uint32_t seed,
+                                const std::function<void(int, size_t)>& on_iteration = {})
+{
+    KMeansResult result{};
+    std::fill_n(assignment, n, uint16_t{0});
+    if (n == 0 || k == 0) return result;
+    k = std::min(k, n);
+
+    std::mt19937 rng(seed);
+    result.centroids = seed_centroids(points, n, dim, k, rng);
+    num_threads = static_cast<unsigned>(std::clamp<size_t>(num_threads, 1, n));
+
+    struct Partial {
+        std::vector<double> sums;
+        std::vector<size_t> counts;
+        size_t changed = 0;
+        double inertia = 0.0;
+    };
+    std::vector<Partial> partials(num_threads);
+
+    for (int iteration = 0; iteration < std::max(max_iterations, 1); ++iteration) {
+        {
+            std::vector<std::jthread> workers;
+            for (unsigned t = 0; t < num_threads; ++t) {
+                workers.emplace_back([&, t] {
+                    Partial& p = partials[t];
+                    p.sums.assign(k * dim, 0.0);
+                    p.counts.assign(k, 0);
+                    p.changed = 0;
+                    p.inertia = 0.0;
+
+                    const size_t begin = n * t / num_threads, end = n * (t + 1) / num_threads;
+                    for (size_t i = begin; i < end; ++i) {
+                        const float* point = points + i * dim;
+                        double d = 0.0;
+                        const auto c = static_cast<uint16_t>(nearest_centroid(point, result.centroids, k, dim, d));
+                        if (iteration == 0 || c != assignment[i]) ++p.changed;
+                        assignment[i] = c;
+                        p.inertia += d;
+                        ++p.counts[c];
+                        double* sum = p.sums.data() + c * dim;
+                        for (size_t j = 0; j < dim; ++j) sum[j] += point[j];
+                    }
+                });
+            }
+        }
+
+        size_t changed = 0;
+        result.inertia = 0.0;
+        for (size_t c = 0; c < k; ++c) {
+            size_t count = 0;
+            for (const auto& p : partials) count += p.counts[c];
+            if (count == 0) continue;
+            for (size_t j = 0; j < dim; ++j) {
+                double sum = 0.0;
+                for (const auto& p : partials) sum += p.sums[c * dim + j];
+                result.centroids[c * dim + j] = static_cast<float>(sum / count);
+            }
+        }
+        for (const auto& p : partials) {
+            changed += p.changed;
+            result.inertia += p.inertia;
+        }
+
+        result.iterations = iteration + 1;
+        if (on_iteration) on_iteration(result.iterations, changed);
+        if (iteration > 0 && static_cast<double>(changed) <= tolerance * n) break;
+    }
+
+    return result;
+}
+
+/**
+ * @brief kmeans_into with the cluster ids returned in KMeansResult::assignment
+ */
+inline KMeansResult kmeans(const float* points, size_t n, size_t dim, size_t k,
+                           int max_iterations, double tolerance, unsigned num_threads, uint32_t seed,
+                           const std::function<void(int, size_t)>& on_iteration = {})
+{
+    std::vector<uint16_t> assignment(n);
+    KMeansResult result = kmeans_into(points, n, dim, k, assignment.data(), max_iterations, tolerance,
+                                      num_threads, seed, on_iteration);
+    result.assignment = std::move(assignment);
+    return result;
+}
+
+}
+
+#endif
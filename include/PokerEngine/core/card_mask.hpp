@@ -0,0 +1,67 @@
+#ifndef POKER_ENGINE_CORE_CARD_MASK_HPP
+#define POKER_ENGINE_CORE_CARD_MASK_HPP
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+#include "PokerEngine/core/card.hpp"
+#include "PokerEngine/core/range.hpp"
+
+namespace PokerEngine::Core {
+
+/**
+ * @brief 52 bit card set, bit (suit * 13 + rank - 2) is set for each card.
+ * Same layout as the evaluator's HandMask so the two can be mixed freely.
+ */
+using CardMask = std::uint64_t;
+
+constexpr int NUM_CARDS = 52;
+constexpr int NUM_COMBOS = 1326;
+
+constexpr inline int cardIndex(Card c) noexcept {
+    return static_cast<int>(c.suit()) * 13 + static_cast<int>(c.rank()) - 2;
+}
+
+constexpr inline Card cardFromIndex(int index) noexcept {
+    return Card{static_cast<Rank>(index % 13 + 2), static_cast<Suit>(index / 13)};
+}
+
+constexpr inline CardMask cardMask(Card c) noexcept {
+    return CardMask{1} << cardIndex(c);
+}
+
+constexpr inline CardMask cardsMask(const std::vector<Card>& cards) noexcept {
+    CardMask mask = 0;
+    for (const auto& c : cards) mask |= cardMask(c);
+    return mask;
+}
+
+constexpr inline CardMask comboMask(const Combo& combo) noexcept {
+    return cardMask(combo.c1) | cardMask(combo.c2);
+}
+
+/**
+ * @brief Dense id in [0, NUM_COMBOS) for the unordered pair of card indices {a, b}, a != b
+ */
+constexpr inline int comboIndex(int a, int b) noexcept {
+    if (b < a) std::swap(a, b);
+    return b * (b - 1) / 2 + a;
+}
+
+constexpr inline int comboIndex(const Combo& combo) noexcept {
+    return comboIndex(cardIndex(combo.c1), cardIndex(combo.c2));
+}
+
+/**
+ * @brief Inverse of comboIndex, returns the pair of card indices {low, high}
+ */
+constexpr inline std::pair<int, int> comboCardsFromIndex(int id) noexcept {
+    int high = 1;
+    while ((high + 1) * high / 2 <= id) ++high;
+    return {id - high * (high - 1) / 2, high};
+}
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef POKER_ENGINE_CORE_DETAIL_MAPPED_FILE_HPP
+#define POKER_ENGINE_CORE_DETAIL_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace PokerEngine::Core::detail {
+
+/**
+ * @brief Memory mapping of a whole file, read only unless opened for writing, unmapped on destruction.
+ * Writes through a writable mapping reach the file.
+ */
+class MappedFile {
+public:
+    enum class Access { ReadOnly, ReadWrite };
+
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path, Access access = Access::ReadOnly);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            MappedFile tmp{std::move(other)};
+            swap(tmp);
+        }
+        return *this;
+    }
+    ~MappedFile() { unmap(); }
+
+    const std::byte* data() const noexcept { return data_; }
+    // Only valid for a mapping opened with Access::ReadWrite
+    std::byte* writableData() noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    void swap(MappedFile& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#ifdef _WIN32
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+    void unmap() noexcept;
+
+    std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+#ifdef _WIN32
+
+inline MappedFile::MappedFile(const std::string& path, Access access) {
+    const bool write = access == Access::ReadWrite;
+    file_ = CreateFileA(path.c_str(), write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open file " + path);
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file_, &file_size)) {
+        unmap();
+        throw std::runtime_error("Cannot read size of file " + path);
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ == 0) return;
+
+    mapping_ = CreateFileMappingA(file_, nullptr, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) {
+        unmap();
+        throw std::runtime_error("Cannot map file " + path);
+    }
+    data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        unmap();
+        throw std::runtime_error("Cannot map file " + path);
+    }
+}
+
+inline void MappedFile::unmap() noexcept {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+    size_ = 0;
+}
+
+#else
+
+inline MappedFile::MappedFile(const std::string& path, Access access) {
+    const bool write = access == Access::ReadWrite;
+    const int fd = ::open(path.c_str(), write ? O_RDWR : O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file " + path);
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read size of file " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            throw std::runtime_error("Cannot map file " + path);
+        }
+        data_ = static_cast<std::byte*>(mapped);
+    }
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+}
+
+inline void MappedFile::unmap() noexcept {
+    if (data_) ::munmap(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef POKER_ENGINE_CORE_DETAIL_WEIGHT_TREE_HPP
+#define POKER_ENGINE_CORE_DETAIL_WEIGHT_TREE_HPP
+
+#include <vector>
+#include <bit>
+#include <cstddef>
+
+namespace PokerEngine::Core::detail {
+
+/**
+ * @brief Fenwick tree over non-negative weights: update one weight, append, or find the element a
+ * cumulative weight falls in, each in O(log n).
+ */
+class WeightTree {
+public:
+    WeightTree() = default;
+
+    template<typename Weights>
+    void assign(const Weights& weights) {
+        tree_.assign(weights.size() + 1, 0.0);
+        total_ = 0.0;
+        size_t i = 1;
+        for (double w : weights) {
+            tree_[i] += w;
+            total_ += w;
+            const size_t parent = i + (i & (~i + 1));
+            if (parent < tree_.size()) tree_[parent] += tree_[i];
+            ++i;
+        }
+    }
+
+    void clear() {
+        tree_.clear();
+        total_ = 0.0;
+    }
+
+    size_t size() const noexcept { return tree_.empty() ? 0 : tree_.size() - 1; }
+    double total() const noexcept { return total_; }
+
+    void push_back(double weight) {
+        if (tree_.empty()) tree_.push_back(0.0);
+        const size_t i = tree_.size();
+        // node i covers (i - lowbit(i), i], i.e. the new weight plus its lowbit - 1 predecessors
+        const size_t low = i & (~i + 1);
+        tree_.push_back(weight + prefix(i - 1) - prefix(i - low));
+        total_ += weight;
+    }
+
+    void add(size_t index, double delta) noexcept {
+        total_ += delta;
+        for (size_t i = index + 1; i < tree_.size(); i += i & (~i + 1)) tree_[i] += delta;
+    }
+
+    /**
+     * @brief Sum of the first count weights
+     */
+    double prefix(size_t count) const noexcept {
+        double sum = 0.0;
+        for (size_t i = count; i > 0; i &= i - 1) sum += tree_[i];
+        return sum;
+    }
+
+    /**
+     * @brief Smallest index whose cumulative weight exceeds target, size() - 1 if none does
+     */
+    size_t find(double target) const noexcept {
+        const size_t n = size();
+        size_t pos = 0;
+        for (size_t step = std::bit_floor(n); step > 0; step >>= 1) {
+            if (pos + step <= n && tree_[pos + step] <= target) {
+                pos += step;
+                target -= tree_[pos];
+            }
+        }
+        return pos < n ? pos : n - 1;
+    }
+
+private:
+    std::vector<double> tree_;
+    double total_ = 0.0;
+};
+
+}
+
+#endif
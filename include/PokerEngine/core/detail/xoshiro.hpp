@@ -0,0 +1,64 @@
+#ifndef POKER_ENGINE_CORE_DETAIL_XOSHIRO_HPP
+#define POKER_ENGINE_CORE_DETAIL_XOSHIRO_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace PokerEngine::Core::detail {
+
+/**
+ * @brief xoshiro256** generator: 32 bytes of state and a few instructions per draw, for hot loops that
+ * keep one generator per thread. Satisfies UniformRandomBitGenerator.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    /**
+     * @brief State expanded from seed with splitmix64, so nearby seeds give unrelated streams
+     */
+    explicit Xoshiro256(uint64_t seed = 1) noexcept {
+        for (auto& word : state_) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() noexcept {
+        const uint64_t result = std::rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniform double in [0, 1) from the top 53 bits
+     */
+    double uniform() noexcept { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief Uniform integer in [0, n), multiply-shift without the rejection step (bias below 2^-32 for n < 2^32)
+     */
+    uint32_t below(uint32_t n) noexcept {
+        return static_cast<uint32_t>(((*this)() >> 32) * n >> 32);
+    }
+
+private:
+    std::array<uint64_t, 4> state_{};
+};
+
+}
+
+#endif
@@ -19,7 +19,7 @@ namespace {
     constexpr int SHORT_DECK_SIZE = 36;
 }
 
-Deck DeckFactory::createStandardDeck() {
+inline Deck DeckFactory::createStandardDeck() {
     std::vector<Card> cards;
     cards.reserve(STANDARD_DECK_SIZE);
     
@@ -33,7 +33,7 @@ Deck DeckFactory::createStandardDeck() {
     return Deck{std::move(cards)};
 }
 
-Deck DeckFactory::createShortDeck() {
+inline Deck DeckFactory::createShortDeck() {
     std::vector<Card> cards;
     cards.reserve(SHORT_DECK_SIZE);
     
@@ -3,6 +3,9 @@
 
 #include <unordered_map>
 #include <numeric>
+#include <span>
+#include <vector>
+#include <algorithm>
 
 namespace PokerEngine::Core {
 
@@ -10,12 +13,18 @@ class Pot {
 public:
     using PlayerId = int;
 
+    struct SidePot {
+        int amount = 0;
+        std::vector<PlayerId> eligible;
+    };
+
     Pot() = default;
 
     void addContribution(PlayerId id, int chips);
     int getContribution(PlayerId id) const;
     int getTotal() const;
     int getWinningsForPlayer(PlayerId id);
+    std::vector<SidePot> sidePots(std::span<const PlayerId> live) const;
 
     bool empty() { return contributions_.empty() || getTotal() == 0; }
     void clear() { 
@@ -30,12 +39,12 @@ private:
     void removeContribution(PlayerId id, int chips_to_remove);
 };
 
-void Pot::addContribution(PlayerId id, int chips) {
+inline void Pot::addContribution(PlayerId id, int chips) {
     contributions_[id] += chips;
     pot_total_ += chips;
 }
 
-int Pot::getContribution(PlayerId id) const {
+inline int Pot::getContribution(PlayerId id) const {
     int contribution = 0;
     if (auto it = contributions_.find(id); it != contributions_.end()) {
         contribution = it->second;
@@ -43,11 +52,11 @@ int Pot::getContribution(PlayerId id) const {
     return contribution;
 }
 
-int Pot::getTotal() const {
+inline int Pot::getTotal() const {
     return pot_total_;
 }
 
-void Pot::removeContribution(PlayerId id, int chips_to_remove) {
+inline void Pot::removeContribution(PlayerId id, int chips_to_remove) {
     if(contributions_.contains(id)) {
         int contribution = contributions_[id];
         int to_remove = std::min(chips_to_remove, contribution);
@@ -60,7 +69,7 @@ void Pot::removeContribution(PlayerId id, int chips_to_remove) {
  * @brief Given player id, their winnings will be returned. They can only win as much money from other players as they have put into the pot.
  * 
  */
-int Pot::getWinningsForPlayer(PlayerId id) {
+inline int Pot::getWinningsForPlayer(PlayerId id) {
     int player_max_winning_per_player = contributions_[id];
     removeContribution(id, player_max_winning_per_player);
     int total = player_max_winning_per_player;
@@ -75,6 +84,61 @@ int Pot::getWinningsForPlayer(PlayerId id) {
     return total;
 }
 
+/**
+ * @brief Walk the main pot and side pots in order without allocating: one pot per distinct contribution
+ * level of the players still in the hand, eligible to the live players who put in at least that level.
+ * Chips of other players (e.g. folded) go into every pot their contribution reaches, anything above
+ * the largest live contribution into the last pot.
+ * @param contributions Called with a visitor, calls it as visit(id, chips) for every contribution
+ * @param is_live is_live(id), whether the player is still in the hand
+ * @param on_pot on_pot(level, amount) for each pot, from the main pot up
+ */
+template<typename Contributions, typename IsLive, typename OnPot>
+void forEachSidePot(Contributions&& contributions, IsLive&& is_live, OnPot&& on_pot) {
+    int previous = 0;
+    while (true) {
+        int level = 0;
+        contributions([&](auto id, int chips) {
+            if (chips > previous && (level == 0 || chips < level) && is_live(id)) level = chips;
+        });
+        if (level == 0) return;
+
+        int amount = 0;
+        bool top = true;
+        contributions([&](auto id, int chips) {
+            amount += std::min(chips, level) - std::min(chips, previous);
+            if (chips > level && is_live(id)) top = false;
+        });
+        if (top) {
+            contributions([&](auto, int chips) { amount += std::max(0, chips - level); });
+        }
+        on_pot(level, amount);
+        previous = level;
+    }
+}
+
+/**
+ * @brief Split the pot into a main pot and side pots between the players still in the hand, without
+ * changing it, as forEachSidePot walks them
+ */
+inline std::vector<Pot::SidePot> Pot::sidePots(std::span<const PlayerId> live) const {
+    std::vector<SidePot> pots;
+    forEachSidePot(
+        [&](auto&& visit) {
+            for (auto [pid, chips] : contributions_) visit(pid, chips);
+        },
+        [&](PlayerId id) { return std::ranges::find(live, id) != live.end(); },
+        [&](int level, int amount) {
+            SidePot pot{};
+            pot.amount = amount;
+            for (PlayerId id : live) {
+                if (getContribution(id) >= level) pot.eligible.push_back(id);
+            }
+            pots.push_back(std::move(pot));
+        });
+    return pots;
+}
+
 }
 
 
@@ -7,9 +7,14 @@
 #include <numeric>
 #include <optional>
 #include <random>
+#include <span>
+#include <concepts>
+#include <cmath>
+#include <stdexcept>
 
 #include "PokerEngine/core/card.hpp"
 #include "PokerEngine/core/range_notation.hpp"
+#include "PokerEngine/core/detail/weight_tree.hpp"
 
 namespace PokerEngine::Core {
 
@@ -45,69 +50,144 @@ public:
 
     std::optional<Combo> sample(std::mt19937& rng) const;
 
+    /**
+     * @brief Set the weight of combos()[index] in place, O(log n)
+     * @throws std::invalid_argument if the weight is negative or not finite
+     */
+    void setWeight(size_t index, double weight);
+
+    /**
+     * @brief Bayesian update after an observed action: each combo's weight is multiplied by the
+     * likelihood of the action given that combo, then the weights are normalised to sum to 1.
+     * @param likelihood One entry per combo, aligned with combos()
+     * @return Probability of the action under the weights before the update
+     */
+    double reweight(std::span<const double> likelihood);
+
+    /**
+     * @brief As reweight, with likelihood(combo) called once per combo in order
+     */
+    template<typename Likelihood>
+        requires std::invocable<Likelihood&, const Combo&>
+    double reweight(Likelihood&& likelihood);
+
+    /**
+     * @brief Scale the weights to sum to 1, no-op for a range without weight
+     */
+    void normalise();
+
+    double totalWeight() const noexcept { return weights_.total(); }
+
     const std::vector<Combo>& combos() const noexcept {return combos_;}
     size_t size() const noexcept { return combos_.size(); }
 
 private:
+    void rebuildWeights() { weights_.assign(combos_ | std::views::transform(&Combo::weight)); }
+    double applyLikelihood(const std::vector<double>& posterior);
+
     std::vector<Combo> combos_;
+    // prefix sums of the combo weights, kept in step with combos_ for O(log n) sampling and updates
+    detail::WeightTree weights_;
 
 };
 
-void Range::addCombo(const RangeToken& token) {
+inline void Range::addCombo(const RangeToken& token) {
     std::vector<Hand> expanded_combos = getHands(token);
     combos_.reserve(combos_.size() + expanded_combos.size());
 
     for(auto& c : expanded_combos) {
         combos_.emplace_back(c.get()[0], c.get()[1], 1.0);
+        weights_.push_back(1.0);
     }
 }
 
-void Range::addCombo(Card c1, Card c2, double weight) {
+inline void Range::addCombo(Card c1, Card c2, double weight) {
     Combo combo{c1,c2,weight};
 
     if (std::ranges::find(combos_, combo) == combos_.end()) {
         combos_.push_back(combo);
+        weights_.push_back(weight);
     }
 }
 
-Range::Range(const RangeToken& token) {
+inline Range::Range(const RangeToken& token) {
     std::vector<Hand> expanded_combos = getHands(token);
     combos_.reserve(expanded_combos.size());
 
     for(auto& c : expanded_combos) {
         combos_.emplace_back(c.get()[0], c.get()[1], 1.0);
     }
+    rebuildWeights();
 }
 
 //TODO: this needs to be more efficient -> don't actually erase, just mark as erased
 //The search is O(N)
-void Range::removeBlocked(const std::vector<Card>& known) {
+inline void Range::removeBlocked(const std::vector<Card>& known) {
     std::erase_if(combos_, 
         [&](const Combo& c) {
             return std::ranges::find(known, c.c1) != known.end() ||
                 std::ranges::find(known, c.c2) != known.end();
         }
     );
+    rebuildWeights();
 }
 
-//TODO: replace with prefix sums and O(logN) sampling
-std::optional<Combo> Range::sample(std::mt19937& rng) const {
+inline std::optional<Combo> Range::sample(std::mt19937& rng) const {
     if(combos_.empty()) return std::nullopt;
 
-    double total_weight = std::accumulate(
-        combos_.begin(), combos_.end(), 0.0,
-        [](double sum, const Combo& c) {return sum + c.weight;}
-    );
+    std::uniform_real_distribution<double> dist(0.0, weights_.total());
+    return combos_[weights_.find(dist(rng))];
+}
+
+inline void Range::setWeight(size_t index, double weight) {
+    if (index >= combos_.size()) throw std::out_of_range("Combo index out of range");
+    if (weight < 0.0 || !std::isfinite(weight))
+        throw std::invalid_argument("Weights must be finite and non-negative");
+    weights_.add(index, weight - combos_[index].weight);
+    combos_[index].weight = weight;
+}
 
-    std::uniform_real_distribution<double> dist(0.0, total_weight);
-    double pick = dist(rng);
+inline double Range::applyLikelihood(const std::vector<double>& posterior) {
+    const double prior_total = weights_.total();
+    const double total = std::accumulate(posterior.begin(), posterior.end(), 0.0);
+    if (!(total > 0.0))
+        throw std::invalid_argument("Action has zero likelihood for every combo in the range");
 
-    for (const auto& c : combos_) {
-        pick -= c.weight;
-        if(pick <= 0.0) return c; 
+    for (size_t i = 0; i < combos_.size(); ++i) combos_[i].weight = posterior[i] / total;
+    rebuildWeights();
+    return prior_total > 0.0 ? total / prior_total : 0.0;
+}
+
+inline double Range::reweight(std::span<const double> likelihood) {
+    if (likelihood.size() != combos_.size())
+        throw std::invalid_argument("Likelihood size does not match the number of combos");
+
+    // posterior built aside so a rejected update leaves the range untouched
+    thread_local std::vector<double> posterior;
+    posterior.resize(combos_.size());
+    for (size_t i = 0; i < combos_.size(); ++i) {
+        if (likelihood[i] < 0.0 || !std::isfinite(likelihood[i]))
+            throw std::invalid_argument("Likelihoods must be finite and non-negative");
+        posterior[i] = combos_[i].weight * likelihood[i];
     }
+    return applyLikelihood(posterior);
+}
+
+template<typename Likelihood>
+    requires std::invocable<Likelihood&, const Combo&>
+inline double Range::reweight(Likelihood&& likelihood) {
+    thread_local std::vector<double> values;
+    values.clear();
+    values.reserve(combos_.size());
+    for (const auto& c : combos_) values.push_back(static_cast<double>(likelihood(c)));
+    return reweight(std::span<const double>(values));
+}
 
-    return combos_.back(); // fallback
+inline void Range::normalise() {
+    const double total = weights_.total();
+    if (!(total > 0.0)) return;
+    for (auto& c : combos_) c.weight /= total;
+    rebuildWeights();
 }
 
 
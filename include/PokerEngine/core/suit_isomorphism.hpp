@@ -0,0 +1,77 @@
+#ifndef POKER_ENGINE_CORE_SUIT_ISOMORPHISM_HPP
+#define POKER_ENGINE_CORE_SUIT_ISOMORPHISM_HPP
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+
+namespace PokerEngine::Core {
+
+/**
+ * @brief Maps each suit index to the suit index it is relabelled as
+ */
+using SuitPermutation = std::array<std::uint8_t, 4>;
+
+namespace detail {
+    constexpr std::array<SuitPermutation, 24> make_suit_permutations() {
+        std::array<SuitPermutation, 24> perms{};
+        SuitPermutation p{0, 1, 2, 3};
+        std::size_t i = 0;
+        do {
+            perms[i++] = p;
+        } while (std::next_permutation(p.begin(), p.end()));
+        return perms;
+    }
+
+    constexpr CardMask SUIT_BLOCK = 0x1FFF;
+}
+
+constexpr std::array<SuitPermutation, 24> SUIT_PERMUTATIONS = detail::make_suit_permutations();
+
+/**
+ * @brief Relabel the suits of every card in the mask
+ */
+constexpr inline CardMask permuteSuits(CardMask mask, const SuitPermutation& perm) noexcept {
+    CardMask result = 0;
+    for (int s = 0; s < 4; ++s) {
+        result |= ((mask >> (s * 13)) & detail::SUIT_BLOCK) << (perm[s] * 13);
+    }
+    return result;
+}
+
+/**
+ * @brief Canonical representative of an ordered tuple of card groups (e.g. board, hero, villain) under suit relabelling.
+ * Two situations are suit isomorphic exactly when their canonical forms are equal.
+ * @param groups Card masks, compared lexicographically in the given order
+ * @return Index into SUIT_PERMUTATIONS of the permutation producing the canonical form
+ */
+template<std::size_t N>
+constexpr std::size_t canonicalPermutation(const std::array<CardMask, N>& groups) noexcept {
+    std::size_t best = 0;
+    std::array<CardMask, N> best_groups{};
+    for (std::size_t g = 0; g < N; ++g) best_groups[g] = permuteSuits(groups[g], SUIT_PERMUTATIONS[0]);
+
+    for (std::size_t p = 1; p < SUIT_PERMUTATIONS.size(); ++p) {
+        std::array<CardMask, N> candidate{};
+        for (std::size_t g = 0; g < N; ++g) candidate[g] = permuteSuits(groups[g], SUIT_PERMUTATIONS[p]);
+        if (candidate < best_groups) {
+            best_groups = candidate;
+            best = p;
+        }
+    }
+    return best;
+}
+
+template<std::size_t N>
+constexpr std::array<CardMask, N> canonicalise(const std::array<CardMask, N>& groups) noexcept {
+    const auto& perm = SUIT_PERMUTATIONS[canonicalPermutation(groups)];
+    std::array<CardMask, N> result{};
+    for (std::size_t g = 0; g < N; ++g) result[g] = permuteSuits(groups[g], perm);
+    return result;
+}
+
+}
+
+#endif
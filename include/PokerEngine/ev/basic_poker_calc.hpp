@@ -1,6 +1,9 @@
 #ifndef POKER_ENGINE_EV_BASIC_POKER_CALC_HPP
 #define POKER_ENGINE_EV_BASIC_POKER_CALC_HPP
 
+#include <span>
+#include <stdexcept>
+
 #include "PokerEngine/ev/ev_calculator.hpp"
 
 namespace PokerEngine::EV {
@@ -8,24 +11,55 @@ namespace PokerEngine::EV {
 /**
  * @brief Single street heads up ev calculation, assuming you are caling a raise
  */
-static double calcCallEV(double equity, int pot, int call_amount) {
-    WeightedOutcome wo1 {.weight = equity, .outcome = pot + call_amount};
-    WeightedOutcome wo2 {.weight = 1.0 - equity, .outcome = -call_amount};
-    return calculateEV({wo1, wo2});
+inline constexpr double calcCallEV(double equity, double pot, double call_amount) noexcept {
+    return equity * (pot + call_amount) - (1.0 - equity) * call_amount;
 }
 
 /**
  * @brief Single street heads up ev calculation, assuming you raise and get called
  */
-static double calcRaiseEV(double equity, int pot, int raise_amount, int opponent_call) {
-    WeightedOutcome wo1 {.weight = equity, .outcome = pot + raise_amount + opponent_call};
-    WeightedOutcome wo2 {.weight = 1.0 - equity, .outcome = -raise_amount};
-    return calculateEV({wo1, wo2});
+inline constexpr double calcRaiseEV(double equity, double pot, double raise_amount, double opponent_call) noexcept {
+    return equity * (pot + raise_amount + opponent_call) - (1.0 - equity) * raise_amount;
 }
 
 static constexpr double calcFoldEV() {
     return 0.0;
 }
+
+/**
+ * @brief calcCallEV of every (equity, pot, call) triple, one element per spot.
+ * The loop has no branches or calls, so it compiles to packed arithmetic.
+ */
+inline void calcCallEV(std::span<const double> equity, std::span<const double> pot,
+                       std::span<const double> call_amount, std::span<double> out) {
+    const size_t n = equity.size();
+    if (pot.size() != n || call_amount.size() != n || out.size() != n)
+        throw std::invalid_argument("Batch EV arrays differ in size");
+
+    const double* e = equity.data();
+    const double* p = pot.data();
+    const double* c = call_amount.data();
+    double* o = out.data();
+    for (size_t i = 0; i < n; ++i) o[i] = e[i] * (p[i] + c[i]) - (1.0 - e[i]) * c[i];
+}
+
+/**
+ * @brief calcRaiseEV of every (equity, pot, raise, call) spot
+ */
+inline void calcRaiseEV(std::span<const double> equity, std::span<const double> pot,
+                        std::span<const double> raise_amount, std::span<const double> opponent_call,
+                        std::span<double> out) {
+    const size_t n = equity.size();
+    if (pot.size() != n || raise_amount.size() != n || opponent_call.size() != n || out.size() != n)
+        throw std::invalid_argument("Batch EV arrays differ in size");
+
+    const double* e = equity.data();
+    const double* p = pot.data();
+    const double* r = raise_amount.data();
+    const double* c = opponent_call.data();
+    double* o = out.data();
+    for (size_t i = 0; i < n; ++i) o[i] = e[i] * (p[i] + r[i] + c[i]) - (1.0 - e[i]) * r[i];
+}
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,308 @@
+#ifndef POKER_ENGINE_EV_BET_SIZING_HPP
+#define POKER_ENGINE_EV_BET_SIZING_HPP
+
+#include <vector>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+#include "PokerEngine/ev/basic_poker_calc.hpp"
+
+namespace PokerEngine::EV {
+
+/**
+ * @brief How much of villain's range continues against a bet. Villain always continues with the
+ * combos that do best against hero's range, so a model only chooses how much of the range that is.
+ */
+struct FoldEquityModel {
+    // Fraction in [0, 1] of villain's range weight that calls a bet of the given size, as a fraction of the pot
+    std::function<double(double pot_fraction)> continue_fraction;
+
+    /**
+     * @brief Villain defends exactly enough that a pure bluff breaks even: pot / (pot + bet)
+     */
+    static FoldEquityModel minimumDefense() {
+        return {[](double f) { return 1.0 / (1.0 + f); }};
+    }
+
+    /**
+     * @brief Villain folds the same fraction whatever the size
+     */
+    static FoldEquityModel constant(double fold) {
+        return {[fold](double) { return 1.0 - fold; }};
+    }
+
+    /**
+     * @brief (pot / (pot + bet))^elasticity, below 1 villain overdefends against large bets, above 1 overfolds
+     */
+    static FoldEquityModel elastic(double elasticity) {
+        return {[elasticity](double f) { return std::pow(1.0 / (1.0 + f), elasticity); }};
+    }
+};
+
+struct BetSizingOptions {
+    // Candidate bets as fractions of the pot, capped at the effective stack
+    std::vector<double> pot_fractions{0.25, 0.33, 0.5, 0.75, 1.0, 1.5, 2.0};
+    FoldEquityModel model = FoldEquityModel::minimumDefense();
+};
+
+/**
+ * @brief Every size evaluated for one hero combo. EVs are chips won net of hero's bet: a called bet is
+ * worth calcCallEV(equity, pot, bet), a fold the pot and checking equity * pot.
+ */
+struct ComboSizing {
+    explicit ComboSizing(const Core::Combo& c) : combo(c) {}
+
+    Core::Combo combo;
+    // Equity against villain's whole range, what checking realises
+    double equity = 0.0;
+    double check_ev = 0.0;
+    // One entry per size, in BetSizingResult::sizes order
+    std::vector<double> ev;
+    // Index into the sizes of the best bet, -1 if checking is best
+    int best = -1;
+    double best_ev = 0.0;
+};
+
+struct BetSizingResult {
+    // Bet in chips for each candidate
+    std::vector<double> sizes;
+    // Fraction of villain's range weight continuing against each size
+    std::vector<double> continue_fraction;
+    // One per hero combo in range order, skipping combos touching the board or without weight
+    std::vector<ComboSizing> combos;
+};
+
+/**
+ * @brief Bet sizing advisor for one street, hero betting first and villain calling or folding.
+ *
+ * Construction computes the equity of every hero combo against every villain combo once, over every
+ * runout of the board (or max_runouts sampled runouts when there are more), scoring each hand once per
+ * runout. Villain's combos are then ordered by equity against hero's range; a continuing range is a
+ * prefix of that order, so hero's equity against it for any size is a lookup in per combo prefix sums.
+ * evaluate() therefore costs O(hero x villain) once plus O(hero x sizes), and can be called again with
+ * other pots, stacks, sizes or fold models without touching the evaluator.
+ *
+ * Construction itself is O(hero x villain x runouts) and dominates. One combo against a range on the
+ * flop takes milliseconds, but two ranges of a few hundred combos each take around half a second with
+ * all 1176 turn and river runouts, and full ranges take seconds. Within a tight latency budget, build
+ * range against range once per spot, or pass a smaller max_runouts: 100 sampled runouts cut the
+ * cost about twelvefold for noisier per combo equities.
+ */
+class BetSizingOptimizer {
+public:
+    /**
+     * @param max_runouts Enumerate when the board has at most this many runouts, otherwise sample as many.
+     * Construction time grows linearly with it, see the class comment.
+     */
+    BetSizingOptimizer(const Core::Range& hero, const Core::Range& villain, const Core::Board& board,
+                       size_t max_runouts = 1176, unsigned seed = 1);
+
+    /**
+     * @param pot Chips in the pot before hero bets
+     * @param effective_stack Most hero can bet, larger sizes become all in
+     */
+    BetSizingResult evaluate(double pot, double effective_stack, const BetSizingOptions& options = {}) const;
+
+    /**
+     * @brief Equity of hero combo h against villain combo v, NaN when they share a card
+     */
+    double pairEquity(size_t h, size_t v) const noexcept { return equity_[h * villain_.size() + v]; }
+
+    size_t runouts() const noexcept { return runouts_; }
+
+private:
+    struct Hand {
+        Core::Combo combo;
+        Core::CardMask mask;
+        double weight;
+    };
+
+    std::vector<Hand> hero_, villain_;
+    // hero x villain, row major
+    std::vector<double> equity_;
+    // villain indices, strongest against hero's range first
+    std::vector<size_t> order_;
+    size_t runouts_ = 0;
+};
+
+inline BetSizingOptimizer::BetSizingOptimizer(const Core::Range& hero, const Core::Range& villain,
+                                              const Core::Board& board, size_t max_runouts, unsigned seed)
+{
+    const Core::CardMask board_mask = Core::cardsMask(board.get());
+    if (board.size() > static_cast<size_t>(Simulator::detail::MAX_BOARD_SIZE_NLH))
+        throw std::invalid_argument("Board has too many cards");
+    if (max_runouts == 0) throw std::invalid_argument("At least one runout is needed");
+
+    for (const auto& c : hero.combos()) {
+        if (!(Core::comboMask(c) & board_mask) && c.weight > 0.0) hero_.push_back({c, Core::comboMask(c), c.weight});
+    }
+    for (const auto& c : villain.combos()) {
+        if (!(Core::comboMask(c) & board_mask) && c.weight > 0.0) villain_.push_back({c, Core::comboMask(c), c.weight});
+    }
+    if (hero_.empty() || villain_.empty()) throw std::invalid_argument("No live combo left in a range");
+
+    // runouts are drawn from every card not on the board, each pair skips those it holds
+    const int missing = Simulator::detail::MAX_BOARD_SIZE_NLH - static_cast<int>(board.size());
+    const Core::CardMask available = ~board_mask & ((Core::CardMask{1} << Core::NUM_CARDS) - 1);
+    std::vector<Core::CardMask> runouts;
+    if (Simulator::detail::choose(std::popcount(available), missing) <= static_cast<long long>(max_runouts)) {
+        Simulator::detail::for_each_subset(available, missing, [&](Core::CardMask r) { runouts.push_back(r); });
+    } else {
+        std::vector<Core::CardMask> cards;
+        for (Core::CardMask m = available; m; m &= m - 1) cards.push_back(m & (~m + 1));
+        std::mt19937 rng(seed);
+        for (size_t i = 0; i < max_runouts; ++i) {
+            // partial shuffle of the first `missing` cards
+            Core::CardMask r = 0;
+            for (int k = 0; k < missing; ++k) {
+                std::uniform_int_distribution<size_t> pick(static_cast<size_t>(k), cards.size() - 1);
+                std::swap(cards[static_cast<size_t>(k)], cards[pick(rng)]);
+                r |= cards[static_cast<size_t>(k)];
+            }
+            runouts.push_back(r);
+        }
+    }
+    runouts_ = runouts.size();
+
+    const size_t n = hero_.size(), m = villain_.size();
+    std::vector<double> points(n * m, 0.0), counts(n * m, 0.0);
+    std::vector<uint64_t> hero_scores(n), villain_scores(m);
+    const Evaluator::HandEvaluator eval{};
+
+    for (Core::CardMask runout : runouts) {
+        const Core::CardMask full = board_mask | runout;
+        for (size_t h = 0; h < n; ++h) hero_scores[h] = hero_[h].mask & runout ? 0 : eval.score(full | hero_[h].mask);
+        for (size_t v = 0; v < m; ++v) villain_scores[v] = villain_[v].mask & runout ? 0 : eval.score(full | villain_[v].mask);
+
+        for (size_t h = 0; h < n; ++h) {
+            if (hero_[h].mask & runout) continue;
+            const uint64_t hs = hero_scores[h];
+            const Core::CardMask blocked = hero_[h].mask | runout;
+            double* row_points = points.data() + h * m;
+            double* row_counts = counts.data() + h * m;
+            for (size_t v = 0; v < m; ++v) {
+                if (villain_[v].mask & blocked) continue;
+                // 2 for a win and 1 for a tie, halved below
+                row_points[v] += hs > villain_scores[v] ? 2.0 : hs == villain_scores[v] ? 1.0 : 0.0;
+                row_counts[v] += 1.0;
+            }
+        }
+    }
+
+    equity_.resize(n * m);
+    for (size_t i = 0; i < n * m; ++i) {
+        equity_[i] = counts[i] > 0.0 ? points[i] / (2.0 * counts[i]) : std::nan("");
+    }
+
+    // villain strength is its equity against hero's range, weighted by hero combo and card removal
+    std::vector<double> villain_equity(m, 0.0);
+    for (size_t v = 0; v < m; ++v) {
+        double weight = 0.0, sum = 0.0;
+        for (size_t h = 0; h < n; ++h) {
+            const double e = equity_[h * m + v];
+            if (std::isnan(e)) continue;
+            weight += hero_[h].weight;
+            sum += hero_[h].weight * (1.0 - e);
+        }
+        villain_equity[v] = weight > 0.0 ? sum / weight : 0.0;
+    }
+    order_.resize(m);
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    std::stable_sort(order_.begin(), order_.end(),
+                     [&](size_t a, size_t b) { return villain_equity[a] > villain_equity[b]; });
+}
+
+inline BetSizingResult BetSizingOptimizer::evaluate(double pot, double effective_stack,
+                                                    const BetSizingOptions& options) const
+{
+    if (pot <= 0.0 || effective_stack < 0.0) throw std::invalid_argument("Pot must be positive and stack non-negative");
+    if (!options.model.continue_fraction) throw std::invalid_argument("Fold equity model has no continue fraction");
+
+    const size_t n = hero_.size(), m = villain_.size();
+    const size_t num_sizes = options.pot_fractions.size();
+
+    BetSizingResult result{};
+    result.sizes.reserve(num_sizes);
+    result.continue_fraction.reserve(num_sizes);
+
+    // each size cuts villain's ordered range at a weight, held as (whole combos, fraction of the next)
+    double total_weight = 0.0;
+    for (const auto& v : villain_) total_weight += v.weight;
+    std::vector<size_t> cut_index(num_sizes);
+    std::vector<double> cut_fraction(num_sizes);
+    for (size_t s = 0; s < num_sizes; ++s) {
+        const double bet = std::min(options.pot_fractions[s] * pot, effective_stack);
+        const double cont = std::clamp(options.model.continue_fraction(bet / pot), 0.0, 1.0);
+        result.sizes.push_back(bet);
+        result.continue_fraction.push_back(cont);
+
+        double left = cont * total_weight;
+        size_t k = 0;
+        while (k < m && villain_[order_[k]].weight <= left) left -= villain_[order_[k++]].weight;
+        cut_index[s] = k;
+        cut_fraction[s] = k < m ? left / villain_[order_[k]].weight : 0.0;
+    }
+
+    // prefix sums along villain's order of live weight and of live weight times hero's equity
+    std::vector<double> live(m + 1), wins(m + 1);
+    result.combos.reserve(n);
+    for (size_t h = 0; h < n; ++h) {
+        const double* row = equity_.data() + h * m;
+        live[0] = wins[0] = 0.0;
+        for (size_t k = 0; k < m; ++k) {
+            const size_t v = order_[k];
+            const bool blocked = std::isnan(row[v]);
+            live[k + 1] = live[k] + (blocked ? 0.0 : villain_[v].weight);
+            wins[k + 1] = wins[k] + (blocked ? 0.0 : villain_[v].weight * row[v]);
+        }
+
+        ComboSizing combo(hero_[h].combo);
+        if (live[m] <= 0.0) {
+            // no villain combo left to face, the pot is hero's whatever the size
+            combo.equity = 1.0;
+            combo.check_ev = pot;
+            combo.ev.assign(num_sizes, pot);
+            combo.best_ev = pot;
+            result.combos.push_back(std::move(combo));
+            continue;
+        }
+        combo.equity = wins[m] / live[m];
+        combo.check_ev = combo.equity * pot;
+        combo.best_ev = combo.check_ev;
+        combo.ev.resize(num_sizes);
+
+        for (size_t s = 0; s < num_sizes; ++s) {
+            const size_t k = cut_index[s];
+            double cont_weight = live[k], cont_wins = wins[k];
+            if (k < m) {
+                cont_weight += cut_fraction[s] * (live[k + 1] - live[k]);
+                cont_wins += cut_fraction[s] * (wins[k + 1] - wins[k]);
+            }
+            const double cont = cont_weight / live[m];
+            const double bet = result.sizes[s];
+            const double called = cont_weight > 0.0 ? calcCallEV(cont_wins / cont_weight, pot, bet) : 0.0;
+            combo.ev[s] = (1.0 - cont) * pot + cont * called;
+
+            if (combo.ev[s] > combo.best_ev) {
+                combo.best_ev = combo.ev[s];
+                combo.best = static_cast<int>(s);
+            }
+        }
+        result.combos.push_back(std::move(combo));
+    }
+    return result;
+}
+
+}
+
+#endif
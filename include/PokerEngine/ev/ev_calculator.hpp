@@ -1,9 +1,10 @@
 #ifndef POKER_ENGINE_EV_EV_CALCULATOR_HPP
 #define POKER_ENGINE_EV_EV_CALCULATOR_HPP
 
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
 #include <vector>
-#include <numeric>
-#include <utility>
 
 namespace PokerEngine::EV {
 
@@ -12,26 +13,44 @@ struct WeightedOutcome {
     double outcome;
 };
 
-namespace {
-    struct Accumulator {
-        double weighted_sum = 0.0;
-        double total_weight = 0.0;
-    };
+/**
+ * @brief Weighted mean of the outcomes, 0 if the weights sum to 0
+ */
+inline double calculateEV(std::span<const WeightedOutcome> outcomes) noexcept {
+    double weighted_sum = 0.0;
+    double total_weight = 0.0;
+    for (const auto& w_outcome : outcomes) {
+        weighted_sum += w_outcome.weight * w_outcome.outcome;
+        total_weight += w_outcome.weight;
+    }
+
+    return total_weight != 0.0 ? weighted_sum / total_weight : 0.0;
+}
+
+inline double calculateEV(std::initializer_list<WeightedOutcome> outcomes) noexcept {
+    return calculateEV(std::span<const WeightedOutcome>(outcomes.begin(), outcomes.size()));
 }
 
-double calculateEV(const std::vector<WeightedOutcome>& outcomes) {
-    Accumulator acc = std::accumulate(
-        outcomes.begin(), outcomes.end(),
-        Accumulator{},
-        [](Accumulator acc, const WeightedOutcome& w_outcome) {
-            acc.weighted_sum += w_outcome.weight * w_outcome.outcome;
-            acc.total_weight += w_outcome.weight;
-            return acc;
-        }
-    );
-
-    return acc.total_weight != 0.0 ? acc.weighted_sum / acc.total_weight : 0.0;
+inline double calculateEV(const std::vector<WeightedOutcome>& outcomes) noexcept {
+    return calculateEV(std::span<const WeightedOutcome>(outcomes));
+}
+
+/**
+ * @brief Weighted mean with weights and outcomes held as separate arrays
+ */
+inline double calculateEV(std::span<const double> weights, std::span<const double> outcomes) {
+    if (weights.size() != outcomes.size())
+        throw std::invalid_argument("Weights and outcomes differ in size");
+
+    double weighted_sum = 0.0;
+    double total_weight = 0.0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        weighted_sum += weights[i] * outcomes[i];
+        total_weight += weights[i];
+    }
+
+    return total_weight != 0.0 ? weighted_sum / total_weight : 0.0;
 }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,231 @@
+#ifndef POKER_ENGINE_EV_ICM_HPP
+#define POKER_ENGINE_EV_ICM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "PokerEngine/core/detail/xoshiro.hpp"
+
+namespace PokerEngine::EV {
+
+struct ICMOptions {
+    // Fields up to this many players with chips are solved exactly, larger ones by Monte Carlo
+    int max_exact_players = 18;
+    // Finishing orders sampled per Monte Carlo evaluation
+    int trials = 100000;
+    uint64_t seed = 1;
+};
+
+namespace detail {
+    inline constexpr size_t MAX_EXACT_ICM_PLAYERS = 24;
+
+    // CHOOSE[n][k] = n choose k
+    inline constexpr auto CHOOSE = [] {
+        std::array<std::array<size_t, MAX_EXACT_ICM_PLAYERS + 2>, MAX_EXACT_ICM_PLAYERS + 1> c{};
+        for (size_t n = 0; n <= MAX_EXACT_ICM_PLAYERS; ++n) {
+            c[n][0] = 1;
+            for (size_t k = 1; k <= n; ++k) c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+        }
+        return c;
+    }();
+}
+
+/**
+ * @brief Independent Chip Model (Malmuth-Harville): the chance of finishing first is proportional to
+ * stack, and each later place is decided the same way among the players left.
+ *
+ * Exact evaluation goes one place at a time over the sets of players holding the places above it: the
+ * probability that set S took the first |S| places, in any order, is pushed forward to every S + {j}.
+ * Only sets smaller than the number of paid places are visited, so k paid places among n players
+ * cost about n * C(n, k - 1) operations, O(n^3) when three places pay and at most 2^n * n for a
+ * final table paying every place. Players without chips finish below everyone with chips and split
+ * the remaining places evenly.
+ */
+class ICMCalculator {
+public:
+    /**
+     * @param payouts Prize for each place, first place first. Places past the end pay nothing.
+     */
+    explicit ICMCalculator(std::vector<double> payouts, ICMOptions options = {});
+
+    /**
+     * @brief Prize equity of each player, exact or Monte Carlo depending on the field size
+     */
+    std::vector<double> equity(std::span<const double> stacks) const;
+
+    void equity(std::span<const double> stacks, std::span<double> out) const;
+
+    /**
+     * @brief Equity of many candidate stack distributions, e.g. every outcome of an all-in.
+     * @param stacks rows of players stacks, row major
+     * @param out rows of players equities, row major
+     */
+    void equityBatch(std::span<const double> stacks, size_t players, std::span<double> out) const;
+
+    const std::vector<double>& payouts() const noexcept { return payouts_; }
+
+private:
+    void exact(std::span<const double> stacks, std::span<double> out) const;
+    void monteCarlo(std::span<const double> stacks, std::span<double> out) const;
+
+    std::vector<double> payouts_;
+    ICMOptions options_;
+};
+
+inline ICMCalculator::ICMCalculator(std::vector<double> payouts, ICMOptions options)
+    : payouts_(std::move(payouts)), options_(options)
+{
+    if (options_.max_exact_players < 0 || options_.max_exact_players > static_cast<int>(detail::MAX_EXACT_ICM_PLAYERS))
+        throw std::invalid_argument("Exact ICM is limited to 24 players");
+    if (options_.trials <= 0)
+        throw std::invalid_argument("Monte Carlo ICM needs at least one trial");
+}
+
+inline std::vector<double> ICMCalculator::equity(std::span<const double> stacks) const {
+    std::vector<double> out(stacks.size());
+    equity(stacks, out);
+    return out;
+}
+
+inline void ICMCalculator::equity(std::span<const double> stacks, std::span<double> out) const {
+    if (out.size() != stacks.size())
+        throw std::invalid_argument("Output size does not match the number of players");
+    for (double s : stacks) {
+        if (s < 0.0 || !std::isfinite(s)) throw std::invalid_argument("Stacks must be finite and non-negative");
+    }
+
+    const size_t alive = static_cast<size_t>(std::ranges::count_if(stacks, [](double s) { return s > 0.0; }));
+    // busted players share whatever the places below the players with chips pay
+    double busted_pool = 0.0;
+    for (size_t place = alive; place < std::min(stacks.size(), payouts_.size()); ++place) busted_pool += payouts_[place];
+    const double busted_share = alive < stacks.size() ? busted_pool / static_cast<double>(stacks.size() - alive) : 0.0;
+
+    std::fill(out.begin(), out.end(), 0.0);
+    if (alive == 0) {
+        std::fill(out.begin(), out.end(), busted_share);
+        return;
+    }
+    if (alive <= static_cast<size_t>(options_.max_exact_players)) exact(stacks, out);
+    else monteCarlo(stacks, out);
+
+    for (size_t i = 0; i < stacks.size(); ++i) {
+        if (stacks[i] <= 0.0) out[i] = busted_share;
+    }
+}
+
+inline void ICMCalculator::exact(std::span<const double> stacks, std::span<double> out) const {
+    using detail::CHOOSE;
+    // players with chips only, index i of the bitmask is player index_of[i]
+    thread_local std::vector<size_t> index_of;
+    thread_local std::vector<double> chips, reach, next;
+    index_of.clear();
+    chips.clear();
+    for (size_t i = 0; i < stacks.size(); ++i) {
+        if (stacks[i] > 0.0) {
+            index_of.push_back(i);
+            chips.push_back(stacks[i]);
+        }
+    }
+    const size_t n = chips.size();
+    const size_t places = std::min(n, payouts_.size());
+    if (places == 0) return;
+
+    double total = 0.0;
+    for (double c : chips) total += c;
+
+    // reach[r] is the probability that the r-th set of size place, in colex order, took the first
+    // place places. Gosper's hack visits the sets of one size in that order, and the colex rank of
+    // a set {c_1 < ... < c_k} is the sum of C(c_i, i).
+    reach.assign(1, 1.0);
+    std::array<size_t, detail::MAX_EXACT_ICM_PLAYERS + 1> member{}, below{}, above{};
+    for (size_t place = 0; place < places; ++place) {
+        const bool last = place + 1 == places;
+        if (!last) next.assign(CHOOSE[n][place + 1], 0.0);
+
+        size_t mask = (size_t{1} << place) - 1;
+        for (size_t r = 0; r < reach.size(); ++r) {
+            if (const double p = reach[r]; p != 0.0) {
+                // adding j above t members of the set moves the members above it up one index:
+                // rank(S + {j}) = below[t] + C(j, t + 1) + above[t]
+                double taken = 0.0;
+                for (size_t bits = mask, i = 0; bits; bits &= bits - 1, ++i) {
+                    member[i] = static_cast<size_t>(std::countr_zero(bits));
+                    taken += chips[member[i]];
+                }
+                for (size_t i = 0; i < place; ++i) below[i + 1] = below[i] + CHOOSE[member[i]][i + 1];
+                above[place] = 0;
+                for (size_t i = place; i-- > 0;) above[i] = above[i + 1] + CHOOSE[member[i]][i + 2];
+
+                const double left = total - taken;
+                size_t t = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    if (mask >> j & 1) {
+                        ++t;
+                        continue;
+                    }
+                    const double takes = p * chips[j] / left;
+                    out[index_of[j]] += payouts_[place] * takes;
+                    if (!last) next[below[t] + CHOOSE[j][t + 1] + above[t]] += takes;
+                }
+            }
+            if (r + 1 < reach.size()) {
+                const size_t low = mask & (~mask + 1);
+                const size_t ripple = mask + low;
+                mask = (((ripple ^ mask) >> 2) / low) | ripple;
+            }
+        }
+        if (!last) std::swap(reach, next);
+    }
+}
+
+inline void ICMCalculator::monteCarlo(std::span<const double> stacks, std::span<double> out) const {
+    // Malmuth-Harville orders are Plackett-Luce: sorting exponential clocks with rate equal to the
+    // stack gives the finishing order, so a trial is n draws and a partial sort of the paid places
+    thread_local std::vector<std::pair<double, size_t>> clocks;
+    thread_local std::vector<size_t> alive;
+    alive.clear();
+    for (size_t i = 0; i < stacks.size(); ++i) {
+        if (stacks[i] > 0.0) alive.push_back(i);
+    }
+    const size_t places = std::min(alive.size(), payouts_.size());
+    clocks.resize(alive.size());
+
+    Core::detail::Xoshiro256 rng(options_.seed);
+    for (int t = 0; t < options_.trials; ++t) {
+        for (size_t k = 0; k < alive.size(); ++k) {
+            const double u = 1.0 - rng.uniform(); // (0, 1]
+            clocks[k] = {-std::log(u) / stacks[alive[k]], alive[k]};
+        }
+        std::partial_sort(clocks.begin(), clocks.begin() + static_cast<std::ptrdiff_t>(places), clocks.end());
+        for (size_t place = 0; place < places; ++place) out[clocks[place].second] += payouts_[place];
+    }
+    for (size_t i : alive) out[i] /= options_.trials;
+}
+
+inline void ICMCalculator::equityBatch(std::span<const double> stacks, size_t players, std::span<double> out) const {
+    if (players == 0 || stacks.size() % players != 0)
+        throw std::invalid_argument("Stacks are not a whole number of rows");
+    if (out.size() != stacks.size())
+        throw std::invalid_argument("Output size does not match the stacks");
+    // the exact path keeps its scratch tables between rows, so a batch allocates once
+    for (size_t row = 0; row < stacks.size(); row += players) {
+        equity(stacks.subspan(row, players), out.subspan(row, players));
+    }
+}
+
+/**
+ * @brief ICM equity of each player with default options
+ */
+inline std::vector<double> icmEquity(std::span<const double> stacks, std::vector<double> payouts) {
+    return ICMCalculator{std::move(payouts)}.equity(stacks);
+}
+
+}
+
+#endif
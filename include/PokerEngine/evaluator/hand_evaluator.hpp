@@ -4,6 +4,7 @@
 #include <vector>
 #include <algorithm>
 #include <optional>
+#include <bit>
 
 #include "PokerEngine/core/card.hpp"
 #include "PokerEngine/evaluator/hand_rank.hpp"
@@ -14,6 +15,11 @@ namespace PokerEngine::Evaluator {
 class HandEvaluator {
 public:
     HandRank evaluate(const std::vector<Core::Card>&) const;
+    /**
+     * @brief Score only evaluation straight from a card mask, without building the best hand.
+     * Returns the same value as evaluate(cards).score and does not allocate.
+     */
+    uint64_t score(detail::HandMask mask) const noexcept;
 
 };
 
@@ -197,7 +203,7 @@ namespace {
     }
 }
 
-HandRank HandEvaluator::evaluate(const std::vector<Core::Card>& cards) const {
+inline HandRank HandEvaluator::evaluate(const std::vector<Core::Card>& cards) const {
     using namespace PokerEngine::Evaluator::detail;
 
     //flush check
@@ -226,6 +232,136 @@ HandRank HandEvaluator::evaluate(const std::vector<Core::Card>& cards) const {
     best_hand = pick_highest(best_hand, mask, 5);
     return HandRank{hand_type, best_hand, compute_score(hand_type, best_hand)};
 }
+namespace {
+    // Appends the ranks of the highest set bits of rank_bits to the score, in the same positions compute_score uses
+    inline void push_highest(uint64_t& s, int& pos, detail::RankMask rank_bits, int n) noexcept {
+        while (n-- > 0 && rank_bits && pos < 5) {
+            int r = std::bit_width(static_cast<unsigned>(rank_bits)) - 1;
+            s |= static_cast<uint64_t>(r + 2) << (16 - pos * 4);
+            rank_bits &= ~static_cast<detail::RankMask>(1u << r);
+            ++pos;
+        }
+    }
+
+    inline void push_rank(uint64_t& s, int& pos, int rank_index, int n) noexcept {
+        while (n-- > 0 && pos < 5) {
+            s |= static_cast<uint64_t>(rank_index + 2) << (16 - pos * 4);
+            ++pos;
+        }
+    }
+
+    inline int highest_index(detail::RankMask rank_bits) noexcept {
+        return std::bit_width(static_cast<unsigned>(rank_bits)) - 1;
+    }
+
+    inline uint64_t straight_score(HandType type, Core::Rank high_card, bool flush) noexcept {
+        uint64_t s = static_cast<uint64_t>(type) << 20;
+        int high = static_cast<int>(high_card);
+        for (int i = 0; i < 5; ++i) {
+            int r = high - i;
+            // Ace-low straights list the ace last as 14, evaluate() builds straight flushes down to rank 1
+            if (r < 2 && !flush) r = 14;
+            s |= static_cast<uint64_t>(r) << (16 - i * 4);
+        }
+        return s;
+    }
+}
+
+inline uint64_t HandEvaluator::score(detail::HandMask mask) const noexcept {
+    using namespace PokerEngine::Evaluator::detail;
+
+    const RankMask s0 = suit_mask(mask, Core::Suit::Hearts);
+    const RankMask s1 = suit_mask(mask, Core::Suit::Diamonds);
+    const RankMask s2 = suit_mask(mask, Core::Suit::Clubs);
+    const RankMask s3 = suit_mask(mask, Core::Suit::Spades);
+    const RankMask suits[4] = {s0, s1, s2, s3};
+
+    RankMask flush_mask = 0;
+    for (auto sm : suits) {
+        if (std::popcount(static_cast<unsigned>(sm)) >= 5) {
+            flush_mask = sm;
+            break;
+        }
+    }
+
+    if (flush_mask) {
+        auto sf = is_straight(flush_mask);
+        if (sf.is_straight) {
+            auto type = sf.high_card == Core::Rank::Ace ? HandType::RoyalFlush : HandType::StraightFlush;
+            return straight_score(type, sf.high_card, true);
+        }
+    }
+
+    // rank sets by multiplicity
+    const RankMask any = s0 | s1 | s2 | s3;
+    const RankMask quads = s0 & s1 & s2 & s3;
+    const RankMask at_least_two = (s0 & s1) | (s0 & s2) | (s0 & s3) | (s1 & s2) | (s1 & s3) | (s2 & s3);
+    const RankMask at_least_three = (s0 & s1 & s2) | (s0 & s1 & s3) | (s0 & s2 & s3) | (s1 & s2 & s3);
+    const RankMask trips = at_least_three & ~quads;
+    const RankMask pairs = at_least_two & ~at_least_three;
+
+    uint64_t s = 0;
+    int pos = 0;
+
+    if (quads) {
+        int q = highest_index(quads);
+        s = static_cast<uint64_t>(HandType::FourOfAKind) << 20;
+        push_rank(s, pos, q, 4);
+        push_highest(s, pos, any & ~static_cast<RankMask>(1u << q), 1);
+        return s;
+    }
+
+    if (trips) {
+        int t = highest_index(trips);
+        RankMask rest = (trips & ~static_cast<RankMask>(1u << t)) | pairs;
+        if (rest) {
+            s = static_cast<uint64_t>(HandType::FullHouse) << 20;
+            push_rank(s, pos, t, 3);
+            push_rank(s, pos, highest_index(rest), 2);
+            return s;
+        }
+    }
+
+    if (flush_mask) {
+        s = static_cast<uint64_t>(HandType::Flush) << 20;
+        push_highest(s, pos, flush_mask, 5);
+        return s;
+    }
+
+    if (auto straight = is_straight(any); straight.is_straight) {
+        return straight_score(HandType::Straight, straight.high_card, false);
+    }
+
+    if (trips) {
+        int t = highest_index(trips);
+        s = static_cast<uint64_t>(HandType::ThreeOfAKind) << 20;
+        push_rank(s, pos, t, 3);
+        push_highest(s, pos, any & ~static_cast<RankMask>(1u << t), 2);
+        return s;
+    }
+
+    if (std::popcount(static_cast<unsigned>(pairs)) >= 2) {
+        int p1 = highest_index(pairs);
+        int p2 = highest_index(pairs & ~static_cast<RankMask>(1u << p1));
+        s = static_cast<uint64_t>(HandType::TwoPair) << 20;
+        push_rank(s, pos, p1, 2);
+        push_rank(s, pos, p2, 2);
+        push_highest(s, pos, any & ~static_cast<RankMask>((1u << p1) | (1u << p2)), 1);
+        return s;
+    }
+
+    if (pairs) {
+        int p = highest_index(pairs);
+        s = static_cast<uint64_t>(HandType::OnePair) << 20;
+        push_rank(s, pos, p, 2);
+        push_highest(s, pos, any & ~static_cast<RankMask>(1u << p), 3);
+        return s;
+    }
+
+    s = static_cast<uint64_t>(HandType::HighCard) << 20;
+    push_highest(s, pos, any, 5);
+    return s;
+}
 }
 
 #endif
\ No newline at end of file
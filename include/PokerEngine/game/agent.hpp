@@ -0,0 +1,154 @@
+#ifndef POKER_ENGINE_GAME_AGENT_HPP
+#define POKER_ENGINE_GAME_AGENT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/detail/xoshiro.hpp"
+#include "PokerEngine/game/holdem_table.hpp"
+
+namespace PokerEngine::Game {
+
+/**
+ * @brief Everything the player to act can see, fixed size so batches are flat arrays
+ */
+struct Observation {
+    uint32_t table = 0;         // index of the table within the caller's batch, stable for a whole hand
+    uint8_t seat = 0;
+    uint8_t num_players = 0;
+    uint8_t button = 0;
+    uint8_t opponents = 0;      // other players who have not folded
+    Street street = Street::Preflop;
+    Core::CardMask hole = 0;
+    Core::CardMask board = 0;
+    int pot = 0;
+    int stack = 0;              // chips behind
+    int committed = 0;          // chips put in this street
+    int current_bet = 0;
+    int big_blind = 0;
+    LegalActions legal{};
+};
+
+/**
+ * @brief Observation of the player to act at a table
+ */
+inline Observation observe(const HoldemTable& table, uint32_t index = 0) noexcept {
+    const int seat = table.toAct();
+    Observation obs{};
+    obs.table = index;
+    obs.seat = static_cast<uint8_t>(seat);
+    obs.num_players = static_cast<uint8_t>(table.numPlayers());
+    obs.button = static_cast<uint8_t>(table.button());
+    for (int s = 0; s < table.numPlayers(); ++s) {
+        if (s != seat && table.inHand(s) && !table.hasFolded(s)) ++obs.opponents;
+    }
+    obs.street = table.street();
+    obs.hole = table.hole(seat);
+    obs.board = table.board();
+    obs.pot = table.potTotal();
+    obs.stack = table.stack(seat).chips();
+    obs.committed = table.committed(seat);
+    obs.current_bet = table.currentBet();
+    obs.big_blind = table.config().big_blind;
+    obs.legal = table.legalActions();
+    return obs;
+}
+
+/**
+ * @brief A player, deciding a batch of spots at once so costly agents can share work between them.
+ * actions has one slot per observation and each must be filled with a legal action.
+ */
+class Agent {
+public:
+    virtual ~Agent() = default;
+    virtual void decide(std::span<const Observation> observations, std::span<Action> actions) = 0;
+};
+
+/**
+ * @brief Adapter for agents that decide one spot at a time
+ */
+class SingleDecisionAgent : public Agent {
+public:
+    virtual Action act(const Observation& observation) = 0;
+
+    void decide(std::span<const Observation> observations, std::span<Action> actions) final {
+        for (size_t i = 0; i < observations.size(); ++i) actions[i] = act(observations[i]);
+    }
+};
+
+/**
+ * @brief Agent from a callable, either Action(const Observation&) or
+ * void(std::span<const Observation>, std::span<Action>)
+ */
+template<typename Fn>
+class FunctionAgent : public Agent {
+public:
+    explicit FunctionAgent(Fn fn) : fn_(std::move(fn)) {}
+
+    void decide(std::span<const Observation> observations, std::span<Action> actions) override {
+        if constexpr (std::is_invocable_r_v<Action, Fn&, const Observation&>) {
+            for (size_t i = 0; i < observations.size(); ++i) actions[i] = fn_(observations[i]);
+        } else {
+            fn_(observations, actions);
+        }
+    }
+
+private:
+    Fn fn_;
+};
+
+template<typename Fn>
+std::unique_ptr<Agent> makeAgent(Fn fn) {
+    return std::make_unique<FunctionAgent<Fn>>(std::move(fn));
+}
+
+// Makes one agent per worker thread, so agents need not be thread safe
+using AgentFactory = std::function<std::unique_ptr<Agent>()>;
+
+/**
+ * @brief Factory constructing T from copies of args
+ */
+template<typename T, typename... Args>
+AgentFactory agentFactory(Args... args) {
+    return [=] { return std::unique_ptr<Agent>(std::make_unique<T>(args...)); };
+}
+
+/**
+ * @brief Checks when it can and calls otherwise
+ */
+class CallingStationAgent : public SingleDecisionAgent {
+public:
+    Action act(const Observation& observation) override {
+        return observation.legal.can_check ? Action::check() : Action::call();
+    }
+};
+
+/**
+ * @brief Uniform over fold (when facing a bet), check or call, a min raise and all in
+ */
+class RandomAgent : public SingleDecisionAgent {
+public:
+    explicit RandomAgent(uint64_t seed = 1) : rng_(seed) {}
+
+    Action act(const Observation& observation) override {
+        const LegalActions& legal = observation.legal;
+        switch (rng_.below(legal.can_raise ? 4 : 2)) {
+        case 0: return legal.can_fold ? Action::fold() : Action::check();
+        case 1: return legal.can_check ? Action::check() : Action::call();
+        case 2: return Action::raiseTo(legal.min_raise_to);
+        default: return Action::raiseTo(legal.max_raise_to);
+        }
+    }
+
+private:
+    Core::detail::Xoshiro256 rng_;
+};
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef POKER_ENGINE_GAME_EQUITY_AGENT_HPP
+#define POKER_ENGINE_GAME_EQUITY_AGENT_HPP
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/detail/xoshiro.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/game/agent.hpp"
+
+namespace PokerEngine::Game {
+
+struct EquityAgentOptions {
+    // Monte Carlo runouts per decision
+    int trials = 200;
+    // Raise with at least this much equity, call when the pot odds are good enough
+    double raise_equity = 0.6;
+    // Raise size as a fraction of the pot after calling
+    double raise_pot_fraction = 1.0;
+    uint64_t seed = 1;
+};
+
+/**
+ * @brief Plays by Monte Carlo equity against random hands of every remaining opponent.
+ *
+ * The batch shares its runouts: each trial shuffles one deck and every decision deals its missing
+ * board cards and opponent hands from it in order, skipping the cards it can see. The shuffle is paid
+ * once per trial instead of once per decision and the evaluator tables stay hot across the batch.
+ */
+class EquityAgent : public Agent {
+public:
+    explicit EquityAgent(EquityAgentOptions options = {}) : options_(options), rng_(options.seed) {}
+
+    void decide(std::span<const Observation> observations, std::span<Action> actions) override;
+
+    /**
+     * @brief Equity of each observation, the same estimate decide acts on
+     */
+    void equities(std::span<const Observation> observations, std::span<double> out);
+
+private:
+    EquityAgentOptions options_;
+    Core::detail::Xoshiro256 rng_;
+    Evaluator::HandEvaluator eval_{};
+    std::vector<double> equity_;
+};
+
+inline void EquityAgent::equities(std::span<const Observation> observations, std::span<double> out) {
+    std::fill(out.begin(), out.end(), 0.0);
+    std::array<uint8_t, Core::NUM_CARDS> deck{};
+    std::iota(deck.begin(), deck.end(), uint8_t{0});
+
+    for (int trial = 0; trial < options_.trials; ++trial) {
+        for (int i = Core::NUM_CARDS - 1; i > 0; --i) std::swap(deck[i], deck[rng_.below(static_cast<uint32_t>(i + 1))]);
+
+        for (size_t o = 0; o < observations.size(); ++o) {
+            const Observation& obs = observations[o];
+            const Core::CardMask seen = obs.hole | obs.board;
+            size_t next = 0;
+            auto draw = [&]() {
+                while (seen >> deck[next] & 1) ++next;
+                return Core::CardMask{1} << deck[next++];
+            };
+
+            Core::CardMask board = obs.board;
+            for (int missing = 5 - std::popcount(obs.board); missing > 0; --missing) board |= draw();
+            const uint64_t hero = eval_.score(board | obs.hole);
+            bool beaten = false;
+            int ties = 0;
+            for (int v = 0; v < obs.opponents; ++v) {
+                const uint64_t score = eval_.score(board | draw() | draw());
+                beaten |= score > hero;
+                ties += score == hero;
+            }
+            if (!beaten) out[o] += 1.0 / (ties + 1);
+        }
+    }
+    for (double& e : out) e /= options_.trials;
+}
+
+inline void EquityAgent::decide(std::span<const Observation> observations, std::span<Action> actions) {
+    equity_.resize(observations.size());
+    equities(observations, equity_);
+
+    for (size_t i = 0; i < observations.size(); ++i) {
+        const Observation& obs = observations[i];
+        const LegalActions& legal = obs.legal;
+        const double equity = equity_[i];
+        if (legal.can_raise && equity >= options_.raise_equity) {
+            const int pot_after_call = obs.pot + legal.call_amount;
+            const int target = obs.current_bet + static_cast<int>(pot_after_call * options_.raise_pot_fraction);
+            actions[i] = Action::raiseTo(std::clamp(target, legal.min_raise_to, legal.max_raise_to));
+        } else if (legal.can_check) {
+            actions[i] = Action::check();
+        } else if (equity * (obs.pot + legal.call_amount) >= legal.call_amount) {
+            actions[i] = Action::call();
+        } else {
+            actions[i] = Action::fold();
+        }
+    }
+}
+
+}
+
+#endif
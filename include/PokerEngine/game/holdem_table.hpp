@@ -0,0 +1,420 @@
+#ifndef POKER_ENGINE_GAME_HOLDEM_TABLE_HPP
+#define POKER_ENGINE_GAME_HOLDEM_TABLE_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/stack.hpp"
+#include "PokerEngine/core/pot.hpp"
+#include "PokerEngine/core/detail/xoshiro.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+
+namespace PokerEngine::Game {
+
+constexpr int MAX_PLAYERS = 10;
+
+enum class Street : uint8_t { Preflop, Flop, Turn, River, Showdown };
+
+enum class ActionType : uint8_t { Fold, Check, Call, Raise };
+
+/**
+ * @brief A decision. For Raise, amount is the street total raised to, so a bet is a raise from 0.
+ */
+struct Action {
+    ActionType type = ActionType::Fold;
+    int amount = 0;
+
+    static constexpr Action fold() noexcept { return {ActionType::Fold, 0}; }
+    static constexpr Action check() noexcept { return {ActionType::Check, 0}; }
+    static constexpr Action call() noexcept { return {ActionType::Call, 0}; }
+    static constexpr Action raiseTo(int total) noexcept { return {ActionType::Raise, total}; }
+};
+
+/**
+ * @brief What the player to act may do. Raise totals are street commitments, min_raise_to may be
+ * below a full raise when the only raise left is all in.
+ */
+struct LegalActions {
+    bool can_fold = false;
+    bool can_check = false;
+    bool can_call = false;
+    bool can_raise = false;
+    int call_amount = 0;
+    int min_raise_to = 0;
+    int max_raise_to = 0;
+};
+
+struct TableConfig {
+    int num_players = 2;
+    int small_blind = 1;
+    int big_blind = 2;
+    int ante = 0;
+};
+
+/**
+ * @brief Hole cards for every seat and the five board cards, each card a single bit mask
+ */
+struct Deal {
+    std::array<Core::CardMask, MAX_PLAYERS> holes{};
+    std::array<Core::CardMask, 5> board{};
+};
+
+/**
+ * @brief Shuffle just enough of a fresh deck for num_players, without allocating
+ */
+inline Deal dealCards(int num_players, Core::detail::Xoshiro256& rng) noexcept {
+    std::array<uint8_t, Core::NUM_CARDS> deck{};
+    std::iota(deck.begin(), deck.end(), uint8_t{0});
+    int next = 0;
+    auto draw = [&]() {
+        const uint32_t pick = static_cast<uint32_t>(next) + rng.below(static_cast<uint32_t>(Core::NUM_CARDS - next));
+        std::swap(deck[next], deck[pick]);
+        return Core::CardMask{1} << deck[next++];
+    };
+
+    Deal deal{};
+    for (int p = 0; p < num_players; ++p) deal.holes[p] = draw() | draw();
+    for (auto& card : deal.board) card = draw();
+    return deal;
+}
+
+/**
+ * @brief No limit hold'em dealer for one table, reused hand after hand.
+ *
+ * Stacks are Core::Stacks and every other piece of state is a fixed size array or a seat bitmask, so
+ * startHand, apply and the showdown never allocate. Core::PlayerState, Core::GameState and Core::Deck
+ * are deliberately not used: they hold vectors, Hands and Ranges that would allocate on every hand, so
+ * seats are bits in masks and the Deal replaces the Deck. Cards are masks, showdowns score them with
+ * HandEvaluator::score, and side pots come from Core::forEachSidePot over the contributions, the walk
+ * behind Core::Pot::sidePots. Seats with no chips sit the hand out.
+ *
+ * Betting follows the usual rules: heads up the button posts the small blind and acts first preflop,
+ * antes are dead, a raise must be at least the previous raise (or the big blind), and an all in short
+ * of a full raise does not reopen the betting for players who already acted.
+ */
+class HoldemTable {
+public:
+    explicit HoldemTable(TableConfig config);
+
+    /**
+     * @param stacks Chips of every seat at the start of the hand
+     */
+    void startHand(std::span<const int> stacks, int button, const Deal& deal);
+
+    bool handOver() const noexcept { return street_ == Street::Showdown; }
+    Street street() const noexcept { return street_; }
+    int toAct() const noexcept { return to_act_; }
+    int button() const noexcept { return button_; }
+    int numPlayers() const noexcept { return config_.num_players; }
+    const TableConfig& config() const noexcept { return config_; }
+
+    LegalActions legalActions() const noexcept;
+
+    /**
+     * @brief Apply the decision of the player to act
+     * @throws std::invalid_argument if the action is not legal
+     */
+    void apply(Action action);
+
+    const Core::Stack& stack(int seat) const noexcept { return stacks_[seat]; }
+    Core::CardMask hole(int seat) const noexcept { return deal_.holes[seat]; }
+    // Board cards dealt so far
+    Core::CardMask board() const noexcept { return board_; }
+    int boardSize() const noexcept { return board_size_; }
+    int currentBet() const noexcept { return current_bet_; }
+    int committed(int seat) const noexcept { return committed_[seat]; }
+    int contributed(int seat) const noexcept { return contributed_[seat]; }
+    int potTotal() const noexcept { return std::accumulate(contributed_.begin(), contributed_.end(), 0); }
+    bool inHand(int seat) const noexcept { return in_hand_ >> seat & 1; }
+    bool hasFolded(int seat) const noexcept { return folded_ >> seat & 1; }
+    bool isAllIn(int seat) const noexcept { return all_in_ >> seat & 1; }
+
+    /**
+     * @brief Chips won or lost this hand, final once handOver()
+     */
+    int payoff(int seat) const noexcept { return stacks_[seat].chips() - start_chips_[seat]; }
+
+    /**
+     * @brief Contributions as a Core::Pot keyed by seat (allocates, for tooling rather than hot loops)
+     */
+    Core::Pot pot() const;
+
+private:
+    using SeatMask = uint32_t;
+
+    SeatMask active() const noexcept { return in_hand_ & ~folded_ & ~all_in_; }
+    int nextSeat(int from, SeatMask among) const noexcept;
+    void put(int seat, int chips);
+    void settle(int from);
+    void dealTo(int board_size);
+    void showdown();
+
+    TableConfig config_;
+    std::vector<Core::Stack> stacks_;
+    std::array<int, MAX_PLAYERS> start_chips_{};
+    std::array<int, MAX_PLAYERS> contributed_{};
+    std::array<int, MAX_PLAYERS> committed_{};
+    Deal deal_{};
+    Core::CardMask board_ = 0;
+    int board_size_ = 0;
+    SeatMask in_hand_ = 0;
+    SeatMask folded_ = 0;
+    SeatMask all_in_ = 0;
+    // players who still have to act this round, and those who may still raise
+    SeatMask pending_ = 0;
+    SeatMask may_raise_ = 0;
+    Street street_ = Street::Showdown;
+    int button_ = 0;
+    int to_act_ = -1;
+    int current_bet_ = 0;
+    int last_raise_ = 0;
+    Evaluator::HandEvaluator eval_{};
+};
+
+inline HoldemTable::HoldemTable(TableConfig config) : config_(config) {
+    if (config_.num_players < 2 || config_.num_players > MAX_PLAYERS)
+        throw std::invalid_argument("A table seats 2 to 10 players");
+    if (config_.small_blind < 0 || config_.big_blind <= 0 || config_.ante < 0)
+        throw std::invalid_argument("Blinds must be positive and the ante non-negative");
+    stacks_.assign(static_cast<size_t>(config_.num_players), Core::Stack{0});
+}
+
+inline int HoldemTable::nextSeat(int from, SeatMask among) const noexcept {
+    for (int k = 1; k <= config_.num_players; ++k) {
+        const int seat = (from + k) % config_.num_players;
+        if (among >> seat & 1) return seat;
+    }
+    return -1;
+}
+
+inline void HoldemTable::put(int seat, int chips) {
+    const int paid = stacks_[seat].removeChips(chips);
+    committed_[seat] += paid;
+    contributed_[seat] += paid;
+    if (stacks_[seat].empty()) all_in_ |= SeatMask{1} << seat;
+}
+
+inline void HoldemTable::startHand(std::span<const int> stacks, int button, const Deal& deal) {
+    if (stacks.size() != static_cast<size_t>(config_.num_players))
+        throw std::invalid_argument("One stack per seat is needed");
+    if (button < 0 || button >= config_.num_players)
+        throw std::invalid_argument("Button is not a seat");
+
+    in_hand_ = folded_ = all_in_ = 0;
+    for (int s = 0; s < config_.num_players; ++s) {
+        if (stacks[s] < 0) throw std::invalid_argument("Stacks cannot be negative");
+        stacks_[s] = Core::Stack{stacks[s]};
+        start_chips_[s] = stacks[s];
+        if (stacks[s] > 0) in_hand_ |= SeatMask{1} << s;
+    }
+    if (std::popcount(in_hand_) < 2) throw std::invalid_argument("A hand needs two players with chips");
+
+    contributed_.fill(0);
+    committed_.fill(0);
+    deal_ = deal;
+    board_ = 0;
+    board_size_ = 0;
+    street_ = Street::Preflop;
+
+    button_ = in_hand_ >> button & 1 ? button : nextSeat(button, in_hand_);
+    if (config_.ante > 0) {
+        for (int s = 0; s < config_.num_players; ++s) {
+            if (!inHand(s)) continue;
+            put(s, config_.ante);
+            committed_[s] = 0; // dead money, not part of the street's betting
+        }
+    }
+
+    const bool heads_up = std::popcount(in_hand_) == 2;
+    const int sb = heads_up ? button_ : nextSeat(button_, in_hand_);
+    const int bb = nextSeat(sb, in_hand_);
+    put(sb, config_.small_blind);
+    put(bb, config_.big_blind);
+
+    current_bet_ = config_.big_blind;
+    last_raise_ = config_.big_blind;
+    pending_ = may_raise_ = active();
+    settle(bb);
+}
+
+inline LegalActions HoldemTable::legalActions() const noexcept {
+    LegalActions legal{};
+    if (handOver()) return legal;
+
+    const int p = to_act_;
+    const int to_call = current_bet_ - committed_[p];
+    const int chips = stacks_[p].chips();
+    legal.can_check = to_call <= 0;
+    legal.can_fold = to_call > 0;
+    legal.can_call = to_call > 0;
+    legal.call_amount = std::min(std::max(to_call, 0), chips);
+
+    // a raise needs someone left to respond to it
+    const SeatMask others = active() & ~(SeatMask{1} << p);
+    legal.can_raise = (may_raise_ >> p & 1) && chips > to_call && others != 0;
+    if (legal.can_raise) {
+        legal.max_raise_to = committed_[p] + chips;
+        legal.min_raise_to = std::min(current_bet_ + last_raise_, legal.max_raise_to);
+    }
+    return legal;
+}
+
+inline void HoldemTable::apply(Action action) {
+    if (handOver()) throw std::invalid_argument("The hand is over");
+
+    const int p = to_act_;
+    const SeatMask bit = SeatMask{1} << p;
+    const LegalActions legal = legalActions();
+
+    switch (action.type) {
+    case ActionType::Fold:
+        if (!legal.can_fold) throw std::invalid_argument("Cannot fold when checking is free");
+        folded_ |= bit;
+        pending_ &= ~bit;
+        break;
+    case ActionType::Check:
+        if (!legal.can_check) throw std::invalid_argument("Cannot check facing a bet");
+        pending_ &= ~bit;
+        break;
+    case ActionType::Call:
+        if (!legal.can_call) throw std::invalid_argument("Nothing to call");
+        put(p, legal.call_amount);
+        pending_ &= ~bit;
+        break;
+    case ActionType::Raise: {
+        if (!legal.can_raise) throw std::invalid_argument("Raising is not allowed");
+        if (action.amount < legal.min_raise_to || action.amount > legal.max_raise_to)
+            throw std::invalid_argument("Raise size out of range");
+
+        const SeatMask pending_before = pending_;
+        const int raise = action.amount - current_bet_;
+        put(p, action.amount - committed_[p]);
+        current_bet_ = action.amount;
+
+        SeatMask facing = 0;
+        for (int s = 0; s < config_.num_players; ++s) {
+            if (s != p && committed_[s] < current_bet_) facing |= SeatMask{1} << s;
+        }
+        if (raise >= last_raise_) {
+            last_raise_ = raise;
+            pending_ = active() & ~bit;
+            may_raise_ = active() & ~bit;
+        } else {
+            // a short all in: those who already acted may only call or fold
+            pending_ = (pending_before | facing) & active() & ~bit;
+            may_raise_ &= pending_before & ~bit;
+        }
+        break;
+    }
+    }
+    settle(p);
+}
+
+inline void HoldemTable::settle(int from) {
+    while (true) {
+        const SeatMask live = in_hand_ & ~folded_;
+        if (std::popcount(live) == 1) {
+            // everyone else folded, uncalled chips included
+            const int winner = std::countr_zero(live);
+            stacks_[winner].addChips(potTotal());
+            street_ = Street::Showdown;
+            to_act_ = -1;
+            return;
+        }
+
+        pending_ &= active();
+        // a lone player with chips who has matched every all in has nobody left to bet against
+        if (std::popcount(active()) == 1) {
+            const int p = std::countr_zero(active());
+            int highest = 0;
+            for (int s = 0; s < config_.num_players; ++s) {
+                if (live >> s & 1) highest = std::max(highest, committed_[s]);
+            }
+            if (committed_[p] >= highest) pending_ = 0;
+        }
+
+        if (pending_) {
+            to_act_ = nextSeat(from, pending_);
+            return;
+        }
+
+        if (street_ == Street::River || std::popcount(active()) <= 1) {
+            dealTo(5);
+            showdown();
+            return;
+        }
+
+        street_ = static_cast<Street>(static_cast<int>(street_) + 1);
+        dealTo(street_ == Street::Flop ? 3 : street_ == Street::Turn ? 4 : 5);
+        committed_.fill(0);
+        current_bet_ = 0;
+        last_raise_ = config_.big_blind;
+        pending_ = may_raise_ = active();
+        from = button_;
+    }
+}
+
+inline void HoldemTable::dealTo(int board_size) {
+    while (board_size_ < board_size) board_ |= deal_.board[board_size_++];
+}
+
+inline void HoldemTable::showdown() {
+    street_ = Street::Showdown;
+    to_act_ = -1;
+
+    const SeatMask live = in_hand_ & ~folded_;
+    std::array<uint64_t, MAX_PLAYERS> scores{};
+    for (int s = 0; s < config_.num_players; ++s) {
+        if (live >> s & 1) scores[s] = eval_.score(board_ | deal_.holes[s]);
+    }
+
+    // the same pots as Core::Pot::sidePots, walked over the seat arrays
+    Core::forEachSidePot(
+        [&](auto&& visit) {
+            for (int s = 0; s < config_.num_players; ++s) visit(s, contributed_[s]);
+        },
+        [&](int s) { return (live >> s & 1) != 0; },
+        [&](int level, int amount) {
+            uint64_t best = 0;
+            SeatMask winners = 0;
+            for (int s = 0; s < config_.num_players; ++s) {
+                if (!(live >> s & 1) || contributed_[s] < level) continue;
+                if (scores[s] > best) {
+                    best = scores[s];
+                    winners = SeatMask{1} << s;
+                } else if (scores[s] == best) {
+                    winners |= SeatMask{1} << s;
+                }
+            }
+
+            const int count = std::popcount(winners);
+            const int share = amount / count;
+            int odd = amount - share * count;
+            // odd chips go to the first winners left of the button
+            for (int k = 1; k <= config_.num_players; ++k) {
+                const int s = (button_ + k) % config_.num_players;
+                if (!(winners >> s & 1)) continue;
+                stacks_[s].addChips(share + (odd > 0 ? 1 : 0));
+                --odd;
+            }
+        });
+}
+
+inline Core::Pot HoldemTable::pot() const {
+    Core::Pot pot{};
+    for (int s = 0; s < config_.num_players; ++s) {
+        if (contributed_[s] > 0) pot.addContribution(s, contributed_[s]);
+    }
+    return pot;
+}
+
+}
+
+#endif
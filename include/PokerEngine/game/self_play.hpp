@@ -0,0 +1,247 @@
+#ifndef POKER_ENGINE_GAME_SELF_PLAY_HPP
+#define POKER_ENGINE_GAME_SELF_PLAY_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/detail/xoshiro.hpp"
+#include "PokerEngine/game/holdem_table.hpp"
+#include "PokerEngine/game/agent.hpp"
+#include "PokerEngine/game/table_batch.hpp"
+
+namespace PokerEngine::Game {
+
+struct SelfPlayOptions {
+    TableConfig table{};
+    // Every seat starts every hand with this many chips
+    int starting_stack = 200;
+    // Deals to play, each one once per rotation of the lineup around the table
+    uint64_t duplicate_sets = 10000;
+    // Tables each worker steps together, the largest batch one agent call can see
+    size_t tables_per_thread = 64;
+    unsigned threads = std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+};
+
+struct AgentStats {
+    uint64_t hands = 0;
+    long long chips = 0;        // net chips won
+    double bb_per_100 = 0.0;
+    // Half width of the 95% confidence interval of bb_per_100
+    double ci95 = 0.0;
+};
+
+struct MatchResult {
+    std::vector<AgentStats> agents;     // by lineup position
+    uint64_t hands = 0;
+    uint64_t decisions = 0;
+    // Calls to Agent::decide, decisions / agent_calls is the mean batch size
+    uint64_t agent_calls = 0;
+};
+
+/**
+ * @brief Plays a lineup of agents against each other over many tables at once, with duplicate dealing.
+ *
+ * Each deal is played num_players times with the same cards and button, rotating the lineup one seat
+ * each time, so every agent holds every hand from every seat and card luck cancels out of the
+ * comparison. A set's total for each agent is one sample, and bb/100 and its confidence interval come
+ * from the sets, which are independent. Deals depend only on the seed and the set number.
+ *
+ * Workers take sets from a shared counter and step a TableBatch of tables_per_thread tables: each
+ * round the pending decisions of every table are gathered per agent and handed over in one decide call.
+ * Each worker makes its own agents from the factories.
+ */
+class SelfPlayHarness {
+public:
+    explicit SelfPlayHarness(SelfPlayOptions options = {});
+
+    /**
+     * @param lineup One factory per seat, the same factory may appear more than once
+     * @throws std::invalid_argument if the lineup does not fill the table, or what an agent throws,
+     * including std::invalid_argument for an illegal action
+     */
+    MatchResult run(std::span<const AgentFactory> lineup) const;
+
+    const SelfPlayOptions& options() const noexcept { return options_; }
+
+private:
+    struct WorkerTotals {
+        std::array<double, MAX_PLAYERS> sum{};
+        std::array<double, MAX_PLAYERS> sum_squares{};
+        uint64_t sets = 0;
+        uint64_t decisions = 0;
+        uint64_t agent_calls = 0;
+    };
+
+    void work(std::span<const AgentFactory> lineup, std::atomic<uint64_t>& next, WorkerTotals& totals) const;
+
+    SelfPlayOptions options_;
+};
+
+inline SelfPlayHarness::SelfPlayHarness(SelfPlayOptions options) : options_(std::move(options)) {
+    // validates the table
+    HoldemTable probe(options_.table);
+    if (options_.starting_stack <= 0) throw std::invalid_argument("Starting stack must be positive");
+    if (options_.tables_per_thread == 0) throw std::invalid_argument("Need at least one table per thread");
+}
+
+inline void SelfPlayHarness::work(std::span<const AgentFactory> lineup, std::atomic<uint64_t>& next,
+                                  WorkerTotals& totals) const
+{
+    const int n = options_.table.num_players;
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (const auto& make : lineup) agents.push_back(make());
+
+    struct Slot {
+        uint64_t set = 0;
+        int rotation = 0;
+        bool active = false;
+        Deal deal{};
+        std::array<long long, MAX_PLAYERS> won{};
+    };
+    const size_t num_tables = options_.tables_per_thread;
+    TableBatch tables(options_.table, num_tables);
+    std::vector<Slot> slots(num_tables);
+
+    std::array<int, MAX_PLAYERS> stacks{};
+    std::fill_n(stacks.begin(), n, options_.starting_stack);
+    const std::span<const int> start(stacks.data(), static_cast<size_t>(n));
+
+    auto deal = [&](Slot& slot) {
+        slot.set = next.fetch_add(1, std::memory_order_relaxed);
+        slot.active = slot.set < options_.duplicate_sets;
+        if (!slot.active) return;
+        Core::detail::Xoshiro256 rng(options_.seed + 0x9E3779B97F4A7C15ull * slot.set);
+        slot.deal = dealCards(n, rng);
+        slot.rotation = 0;
+        slot.won.fill(0);
+    };
+    // seat s is played by lineup position (s + rotation) % n
+    auto agentAt = [n](const Slot& slot, int seat) { return (seat + slot.rotation) % n; };
+
+    // start hands until the table has a decision pending or runs out of sets
+    auto advance = [&](size_t t) {
+        Slot& slot = slots[t];
+        HoldemTable& table = tables[t];
+        while (slot.active && table.handOver()) {
+            for (int s = 0; s < n; ++s) slot.won[agentAt(slot, s)] += table.payoff(s);
+            if (++slot.rotation == n) {
+                for (int a = 0; a < n; ++a) {
+                    const double x = static_cast<double>(slot.won[a]);
+                    totals.sum[a] += x;
+                    totals.sum_squares[a] += x * x;
+                }
+                ++totals.sets;
+                deal(slot);
+                if (!slot.active) return;
+            }
+            table.startHand(start, 0, slot.deal);
+        }
+    };
+
+    for (size_t t = 0; t < num_tables; ++t) {
+        deal(slots[t]);
+        if (!slots[t].active) break;
+        tables[t].startHand(start, 0, slots[t].deal);
+        advance(t);
+    }
+
+    std::vector<std::vector<Observation>> observations(static_cast<size_t>(n));
+    std::vector<std::vector<Action>> actions(static_cast<size_t>(n));
+    for (int a = 0; a < n; ++a) {
+        observations[a].reserve(num_tables);
+        actions[a].reserve(num_tables);
+    }
+    auto groupOf = [&](size_t t, int seat) { return agentAt(slots[t], seat); };
+
+    while (true) {
+        for (auto& batch : observations) batch.clear();
+        if (tables.gather(std::span(observations), groupOf) == 0) break;
+
+        for (int a = 0; a < n; ++a) {
+            if (observations[a].empty()) continue;
+            actions[a].assign(observations[a].size(), Action{});
+            agents[a]->decide(observations[a], actions[a]);
+            ++totals.agent_calls;
+            totals.decisions += observations[a].size();
+            tables.apply(observations[a], actions[a]);
+            for (const auto& obs : observations[a]) advance(obs.table);
+        }
+    }
+}
+
+inline MatchResult SelfPlayHarness::run(std::span<const AgentFactory> lineup) const {
+    const int n = options_.table.num_players;
+    if (lineup.size() != static_cast<size_t>(n))
+        throw std::invalid_argument("The lineup needs one agent per seat");
+
+    const unsigned workers = static_cast<unsigned>(std::clamp<uint64_t>(options_.duplicate_sets, 1, std::max(1u, options_.threads)));
+    std::vector<WorkerTotals> totals(workers);
+    std::vector<std::exception_ptr> errors(workers);
+    std::atomic<uint64_t> next{0};
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            pool.emplace_back([&, w] {
+                try {
+                    work(lineup, next, totals[w]);
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                    // stop the other workers taking new sets
+                    next.store(options_.duplicate_sets, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    WorkerTotals all{};
+    for (const auto& t : totals) {
+        for (int a = 0; a < n; ++a) {
+            all.sum[a] += t.sum[a];
+            all.sum_squares[a] += t.sum_squares[a];
+        }
+        all.sets += t.sets;
+        all.decisions += t.decisions;
+        all.agent_calls += t.agent_calls;
+    }
+
+    MatchResult result{};
+    result.hands = all.sets * static_cast<uint64_t>(n);
+    result.decisions = all.decisions;
+    result.agent_calls = all.agent_calls;
+    result.agents.resize(static_cast<size_t>(n));
+    if (all.sets == 0) return result;
+
+    const double sets = static_cast<double>(all.sets);
+    // chips per set to bb per 100 hands
+    const double scale = 100.0 / (n * static_cast<double>(options_.table.big_blind));
+    for (int a = 0; a < n; ++a) {
+        AgentStats& stats = result.agents[a];
+        const double mean = all.sum[a] / sets;
+        stats.hands = result.hands;
+        stats.chips = std::llround(all.sum[a]);
+        stats.bb_per_100 = mean * scale;
+        if (all.sets > 1) {
+            const double variance = std::max(0.0, (all.sum_squares[a] - sets * mean * mean) / (sets - 1.0));
+            stats.ci95 = 1.96 * std::sqrt(variance / sets) * scale;
+        }
+    }
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef POKER_ENGINE_GAME_TABLE_BATCH_HPP
+#define POKER_ENGINE_GAME_TABLE_BATCH_HPP
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "PokerEngine/game/holdem_table.hpp"
+#include "PokerEngine/game/agent.hpp"
+
+namespace PokerEngine::Game {
+
+/**
+ * @brief A fixed set of tables stepped together: the decision pending at every table is gathered into
+ * batches, one per group of agents, and the answers are applied back.
+ *
+ * Observations carry their table index, so a batch can be answered in any grouping. Tables whose hand
+ * is over have nothing pending and are skipped until startHand.
+ */
+class TableBatch {
+public:
+    TableBatch(TableConfig config, size_t tables) : tables_(tables, HoldemTable(config)) {}
+
+    size_t size() const noexcept { return tables_.size(); }
+    HoldemTable& operator[](size_t t) noexcept { return tables_[t]; }
+    const HoldemTable& operator[](size_t t) const noexcept { return tables_[t]; }
+
+    /**
+     * @brief Append the observation of every pending decision to groups[groupOf(table, seat)]
+     * @return Decisions gathered
+     */
+    template<typename GroupOf>
+    size_t gather(std::span<std::vector<Observation>> groups, GroupOf&& groupOf) const {
+        size_t count = 0;
+        for (size_t t = 0; t < tables_.size(); ++t) {
+            if (tables_[t].handOver()) continue;
+            groups[groupOf(t, tables_[t].toAct())].push_back(observe(tables_[t], static_cast<uint32_t>(t)));
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Append every pending decision to one batch
+     */
+    size_t gather(std::vector<Observation>& batch) const {
+        return gather(std::span(&batch, 1), [](size_t, int) { return 0; });
+    }
+
+    /**
+     * @brief Apply actions[i] at table observations[i].table, each table at most once per batch
+     * @throws std::invalid_argument if an action is not legal
+     */
+    void apply(std::span<const Observation> observations, std::span<const Action> actions) {
+        if (observations.size() != actions.size())
+            throw std::invalid_argument("One action per observation is needed");
+        for (size_t i = 0; i < observations.size(); ++i) tables_[observations[i].table].apply(actions[i]);
+    }
+
+private:
+    std::vector<HoldemTable> tables_;
+};
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef POKER_ENGINE_HISTORY_ALLIN_EV_HPP
+#define POKER_ENGINE_HISTORY_ALLIN_EV_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <exception>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/pot.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+#include "PokerEngine/history/hand_record.hpp"
+
+namespace PokerEngine::History {
+
+/**
+ * @brief Equity of an all-in hand at the moment the money went in, and the winnings it was worth.
+ * Arrays are indexed like HandRecord::players(); players who folded have 0.
+ */
+struct AllInEV {
+    size_t hand = 0;        // index into ParsedHands::hands
+    uint64_t id = 0;
+    Street street = Street::Preflop;
+    // Board cards out when the last action was taken
+    uint8_t board_size = 0;
+    // Expected fraction of the total pot collected
+    std::array<double, MAX_SEATS> equity{};
+    // Expected amount collected, with any rake taken from every outcome in proportion
+    std::array<double, MAX_SEATS> ev_won{};
+
+    /**
+     * @brief EV adjusted result of a player, expected collection less contribution
+     */
+    double evNet(const HandRecord& record, size_t player) const noexcept {
+        return ev_won[player] - record.seats[player].contributed;
+    }
+};
+
+/**
+ * @brief Actual and EV adjusted winnings of one player name over many hands, in units of the history
+ * (dollars for cash games, chips for tournaments) rather than HandRecord amounts
+ */
+struct AllInTotals {
+    size_t hands = 0;
+    double net = 0.0;
+    double ev_net = 0.0;
+};
+
+/**
+ * @brief Batch all-in EV over parsed hand histories.
+ *
+ * A hand qualifies when a player went all in, at least two players reached showdown and all their
+ * hole cards are known. The board as it stood at the last action is completed in every possible way
+ * from the unseen cards, and each main and side pot (from Core::Pot::sidePots) is split between its
+ * best eligible hands on every runout. Situations are memoised under suit isomorphism in a bounded
+ * LRU cache, so repeated all-ins such as AA vs KK preflop are only enumerated once while they stay
+ * cached, and batches are spread across threads. A cache capacity of 0 turns memoisation off.
+ */
+class AllInEVEngine {
+public:
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = size_t{1} << 16;
+
+    explicit AllInEVEngine(unsigned threads = std::thread::hardware_concurrency(),
+                           size_t cache_capacity = DEFAULT_CACHE_CAPACITY)
+        : threads_(std::max(1u, threads)), cache_capacity_(cache_capacity) {}
+
+    /**
+     * @return nullopt if the hand does not qualify
+     */
+    std::optional<AllInEV> evaluate(const HandRecord& hand, std::span<const ActionRecord> actions) const;
+
+    /**
+     * @return One result per qualifying hand, in hand order
+     */
+    std::vector<AllInEV> evaluate(const ParsedHands& parsed) const;
+
+    size_t cacheSize() const {
+        std::lock_guard lock(cache_mutex_);
+        return lru_.size();
+    }
+    size_t cacheCapacity() const noexcept { return cache_capacity_; }
+    size_t cacheHits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+
+private:
+    // board, then each live player's hole cards, then each pot's eligible players as a bitmask
+    static constexpr size_t KEY_SIZE = 1 + 2 * MAX_SEATS;
+    using Key = std::array<Core::CardMask, KEY_SIZE>;
+    // share of each pot won by each live player, pot major
+    using Shares = std::vector<double>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            size_t h = 0;
+            for (auto m : key) h ^= std::hash<Core::CardMask>{}(m) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    Shares enumerate(Core::CardMask board, std::span<const Core::CardMask> holes,
+                     std::span<const Core::CardMask> eligible) const;
+
+    std::optional<Shares> findShares(const Key& key) const;
+    void insertShares(const Key& key, const Shares& shares) const;
+
+    using Entry = std::pair<Key, Shares>;
+
+    unsigned threads_;
+    size_t cache_capacity_;
+    Evaluator::HandEvaluator eval_{};
+    mutable std::mutex cache_mutex_;
+    mutable std::list<Entry> lru_; // most recently used at the front
+    mutable std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> cache_;
+    mutable std::atomic<size_t> hits_{0};
+};
+
+inline AllInEVEngine::Shares AllInEVEngine::enumerate(Core::CardMask board, std::span<const Core::CardMask> holes,
+                                                      std::span<const Core::CardMask> eligible) const
+{
+    const size_t n = holes.size();
+    Core::CardMask known = board;
+    for (auto h : holes) known |= h;
+    const Core::CardMask unseen = ~known & ((Core::CardMask{1} << Core::NUM_CARDS) - 1);
+    const int missing = Simulator::detail::MAX_BOARD_SIZE_NLH - std::popcount(board);
+
+    Shares shares(eligible.size() * n, 0.0);
+    std::array<uint64_t, MAX_SEATS> scores{};
+    long long runouts = 0;
+    Simulator::detail::for_each_subset(unseen, missing, [&](Core::CardMask runout) {
+        const Core::CardMask full = board | runout;
+        for (size_t i = 0; i < n; ++i) scores[i] = eval_.score(full | holes[i]);
+        for (size_t p = 0; p < eligible.size(); ++p) {
+            uint64_t best = 0;
+            int winners = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (!(eligible[p] >> i & 1)) continue;
+                if (scores[i] > best) {
+                    best = scores[i];
+                    winners = 1;
+                } else if (scores[i] == best) {
+                    ++winners;
+                }
+            }
+            const double share = 1.0 / winners;
+            for (size_t i = 0; i < n; ++i) {
+                if (eligible[p] >> i & 1 && scores[i] == best) shares[p * n + i] += share;
+            }
+        }
+        ++runouts;
+    });
+
+    for (double& s : shares) s /= static_cast<double>(runouts);
+    return shares;
+}
+
+inline std::optional<AllInEVEngine::Shares> AllInEVEngine::findShares(const Key& key) const {
+    if (cache_capacity_ == 0) return std::nullopt;
+    std::lock_guard lock(cache_mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) return std::nullopt;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second->second;
+}
+
+inline void AllInEVEngine::insertShares(const Key& key, const Shares& shares) const {
+    if (cache_capacity_ == 0) return;
+    std::lock_guard lock(cache_mutex_);
+    // concurrent misses on the same situation may both enumerate, the first one is kept
+    if (cache_.contains(key)) return;
+    lru_.emplace_front(key, shares);
+    cache_.emplace(key, lru_.begin());
+    if (lru_.size() > cache_capacity_) {
+        cache_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+inline std::optional<AllInEV> AllInEVEngine::evaluate(const HandRecord& hand, std::span<const ActionRecord> actions) const {
+    if (actions.empty() || hand.board_size != Simulator::detail::MAX_BOARD_SIZE_NLH) return std::nullopt;
+
+    std::array<bool, MAX_SEATS> folded{};
+    bool all_in = false;
+    for (const auto& a : actions) {
+        if (a.type == ActionType::Fold) folded[a.player] = true;
+        all_in |= a.all_in;
+    }
+    if (!all_in) return std::nullopt;
+
+    // players still in, who must all have known cards
+    std::array<Core::Pot::PlayerId, MAX_SEATS> live_ids{};
+    std::array<Core::CardMask, MAX_SEATS> holes{};
+    size_t num_live = 0;
+    for (uint8_t i = 0; i < hand.num_players; ++i) {
+        if (folded[i] || hand.seats[i].contributed <= 0) continue;
+        if (std::popcount(hand.seats[i].hole) != 2) return std::nullopt;
+        holes[num_live] = hand.seats[i].hole;
+        live_ids[num_live++] = i;
+    }
+    if (num_live < 2) return std::nullopt;
+    const std::span<const Core::Pot::PlayerId> live(live_ids.data(), num_live);
+
+    AllInEV result{};
+    result.id = hand.id;
+    result.street = actions.back().street;
+    constexpr std::array<uint8_t, 4> board_at{0, 3, 4, 5};
+    result.board_size = board_at[static_cast<size_t>(result.street)];
+
+    Core::CardMask board = 0;
+    for (uint8_t i = 0; i < result.board_size; ++i) board |= Core::cardMask(hand.board_cards[i]);
+
+    const Core::Pot pot = hand.pot();
+    const auto pots = pot.sidePots(live);
+    if (pots.empty() || pots.size() > MAX_SEATS) return std::nullopt;
+    std::array<Core::CardMask, MAX_SEATS> eligible{};
+    for (size_t p = 0; p < pots.size(); ++p) {
+        for (auto id : pots[p].eligible) {
+            eligible[p] |= Core::CardMask{1} << static_cast<size_t>(std::ranges::find(live, id) - live.begin());
+        }
+    }
+
+    // the key is the situation up to suit relabelling, the player order is kept
+    std::array<Core::CardMask, 1 + MAX_SEATS> cards{};
+    cards[0] = board;
+    for (size_t i = 0; i < live.size(); ++i) cards[1 + i] = holes[i];
+    cards = Core::canonicalise(cards);
+    Key key{};
+    std::copy(cards.begin(), cards.end(), key.begin());
+    std::copy(eligible.begin(), eligible.end(), key.begin() + 1 + MAX_SEATS);
+
+    Shares shares;
+    if (auto hit = findShares(key)) {
+        shares = std::move(*hit);
+    } else {
+        shares = enumerate(cards[0], std::span(cards).subspan(1, live.size()), std::span(eligible).first(pots.size()));
+        insertShares(key, shares);
+    }
+
+    const double total = pot.getTotal();
+    const double after_rake = hand.total_pot > 0 && hand.rake > 0 ? 1.0 - static_cast<double>(hand.rake) / hand.total_pot : 1.0;
+    for (size_t p = 0; p < pots.size(); ++p) {
+        for (size_t i = 0; i < live.size(); ++i) {
+            const double won = pots[p].amount * shares[p * live.size() + i];
+            result.equity[live[i]] += won / total;
+            result.ev_won[live[i]] += won * after_rake;
+        }
+    }
+    return result;
+}
+
+inline std::vector<AllInEV> AllInEVEngine::evaluate(const ParsedHands& parsed) const {
+    const size_t n = parsed.hands.size();
+    std::vector<std::optional<AllInEV>> slots(n);
+    const unsigned workers = static_cast<unsigned>(std::min<size_t>(threads_, std::max<size_t>(n, 1)));
+    std::vector<std::exception_ptr> errors(workers);
+
+    // hands differ in cost by orders of magnitude (a cache hit vs a preflop enumeration), so workers
+    // take small blocks from a shared counter rather than fixed shares
+    constexpr size_t BLOCK = 64;
+    std::atomic<size_t> next{0};
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            pool.emplace_back([&, w] {
+                try {
+                    for (size_t start = next.fetch_add(BLOCK); start < n; start = next.fetch_add(BLOCK)) {
+                        for (size_t h = start; h < std::min(n, start + BLOCK); ++h) {
+                            const auto& hand = parsed.hands[h];
+                            slots[h] = evaluate(hand, parsed.actionsOf(hand));
+                            if (slots[h]) slots[h]->hand = h;
+                        }
+                    }
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    std::vector<AllInEV> results;
+    for (auto& s : slots) {
+        if (s) results.push_back(*s);
+    }
+    return results;
+}
+
+/**
+ * @brief Actual and EV adjusted net winnings per player name over the all-in hands. Each hand is
+ * divided by its amountScale(), so cash and tournament hands add up in their printed units.
+ */
+inline std::unordered_map<std::string_view, AllInTotals> allInTotals(const ParsedHands& parsed,
+                                                                     std::span<const AllInEV> results)
+{
+    std::unordered_map<std::string_view, AllInTotals> totals;
+    for (const auto& r : results) {
+        const HandRecord& hand = parsed.hands[r.hand];
+        const double scale = hand.amountScale();
+        for (uint8_t i = 0; i < hand.num_players; ++i) {
+            const SeatRecord& seat = hand.seats[i];
+            if (seat.contributed <= 0 && seat.won == 0) continue;
+            AllInTotals& t = totals[seat.name];
+            ++t.hands;
+            t.net += (seat.won - seat.contributed) / scale;
+            t.ev_net += r.evNet(hand, i) / scale;
+        }
+    }
+    return totals;
+}
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef POKER_ENGINE_HISTORY_HAND_RECORD_HPP
+#define POKER_ENGINE_HISTORY_HAND_RECORD_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "PokerEngine/core/card.hpp"
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/pot.hpp"
+
+namespace PokerEngine::History {
+
+constexpr int MAX_SEATS = 10;
+// Cash game amounts are integers in hundredths of the history's unit, so $0.25 is 25. Tournament chips are
+// whole, so 1500 chips is 1500 and stacks up to 2^31 - 1 chips fit.
+constexpr int AMOUNT_SCALE = 100;
+
+enum class Street : uint8_t { Preflop, Flop, Turn, River };
+
+enum class ActionType : uint8_t { Ante, SmallBlind, BigBlind, Fold, Check, Call, Bet, Raise };
+
+/**
+ * @brief One action, amount is what the action put into the pot (for a raise, the chips added, not the total)
+ */
+struct ActionRecord {
+    uint8_t player;     // index into HandRecord::players()
+    Street street;
+    ActionType type;
+    bool all_in;
+    int amount;
+};
+
+struct SeatRecord {
+    std::string_view name;
+    uint8_t seat;               // seat number printed in the history
+    int stack;                  // chips at the start of the hand
+    Core::CardMask hole = 0;    // 0 unless dealt to the hero or shown
+    int contributed = 0;        // net of any uncalled bet returned
+    int won = 0;
+};
+
+/**
+ * @brief Fixed size summary of a hand. Strings are views into the parsed text, which must outlive the
+ * record, and actions live in a shared array addressed by first_action and num_actions.
+ */
+struct HandRecord {
+    uint64_t id = 0;
+    std::string_view table;
+    // The whole hand as it appears in the text
+    std::string_view text;
+    int small_blind = 0;
+    int big_blind = 0;
+    uint8_t button = 0;         // seat number of the button
+    uint8_t num_players = 0;
+    uint8_t board_size = 0;
+    bool tournament = false;
+    std::array<SeatRecord, MAX_SEATS> seats{};
+    std::array<Core::Card, 5> board_cards{};
+    int total_pot = 0;
+    int rake = 0;
+    uint32_t first_action = 0;
+    uint32_t num_actions = 0;
+
+    std::span<const SeatRecord> players() const noexcept { return {seats.data(), num_players}; }
+
+    /**
+     * @brief Amounts per unit of the history, AMOUNT_SCALE for cash games and 1 for tournaments.
+     * Divide by it before adding amounts of different hands together.
+     */
+    int amountScale() const noexcept { return tournament ? 1 : AMOUNT_SCALE; }
+
+    Core::Board board() const { return Core::Board{std::vector<Core::Card>(board_cards.begin(), board_cards.begin() + board_size)}; }
+    Core::CardMask boardMask() const noexcept {
+        Core::CardMask mask = 0;
+        for (uint8_t i = 0; i < board_size; ++i) mask |= Core::cardMask(board_cards[i]);
+        return mask;
+    }
+
+    /**
+     * @brief Contributions of every player, keyed by index into players()
+     */
+    Core::Pot pot() const {
+        Core::Pot pot{};
+        for (uint8_t i = 0; i < num_players; ++i) {
+            if (seats[i].contributed > 0) pot.addContribution(i, seats[i].contributed);
+        }
+        return pot;
+    }
+};
+
+/**
+ * @brief Hands in text order, with the actions of all of them in one array
+ */
+struct ParsedHands {
+    std::vector<HandRecord> hands;
+    std::vector<ActionRecord> actions;
+    // Hands that could not be parsed and were left out
+    size_t skipped = 0;
+
+    std::span<const ActionRecord> actionsOf(const HandRecord& hand) const noexcept {
+        return {actions.data() + hand.first_action, hand.num_actions};
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,504 @@
+#ifndef POKER_ENGINE_HISTORY_HISTORY_PARSER_HPP
+#define POKER_ENGINE_HISTORY_HISTORY_PARSER_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#include "PokerEngine/core/card.hpp"
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/detail/card_ops.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+#include "PokerEngine/history/hand_record.hpp"
+
+namespace PokerEngine::History {
+
+struct ParseStats {
+    size_t hands = 0;
+    size_t skipped = 0;
+};
+
+namespace detail {
+    // every hand starts with a line beginning with this
+    constexpr std::string_view HAND_START = "PokerStars ";
+
+    struct ParseError : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    inline std::string_view take_line(std::string_view text, size_t& pos) noexcept {
+        const size_t end = text.find('\n', pos);
+        std::string_view line = text.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+        pos = end == std::string_view::npos ? text.size() : end + 1;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    }
+
+    inline bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    /**
+     * @brief First amount at or after pos, skipping any currency symbol, in units of 1/scale: "$1.5" gives 150
+     * with scale AMOUNT_SCALE. Digits past the scale are dropped. pos is left after it.
+     */
+    inline int parse_amount(std::string_view s, size_t& pos, int scale) {
+        while (pos < s.size() && !is_digit(s[pos])) ++pos;
+        if (pos == s.size()) throw ParseError("Missing amount");
+
+        long long whole = 0;
+        for (; pos < s.size() && (is_digit(s[pos]) || s[pos] == ','); ++pos) {
+            if (s[pos] != ',') whole = whole * 10 + (s[pos] - '0');
+            if (whole > 0x7fffffff) throw ParseError("Amount out of range");
+        }
+        int fraction = 0;
+        if (pos + 1 < s.size() && s[pos] == '.' && is_digit(s[pos + 1])) {
+            ++pos;
+            int digits = 0;
+            for (; pos < s.size() && is_digit(s[pos]); ++pos) {
+                if (digits++ < 2) fraction = fraction * 10 + (s[pos] - '0');
+            }
+            if (digits == 1) fraction *= 10;
+        }
+        const long long amount = whole * scale + fraction * scale / 100;
+        if (amount > 0x7fffffff) throw ParseError("Amount out of range");
+        return static_cast<int>(amount);
+    }
+
+    inline int parse_amount(std::string_view s, int scale) {
+        size_t pos = 0;
+        return parse_amount(s, pos, scale);
+    }
+
+    inline Core::Card parse_card(std::string_view s, size_t pos) {
+        if (pos + 1 >= s.size()) throw ParseError("Truncated card");
+        try {
+            return Core::Card{Core::detail::char_to_rank(s[pos]), Core::detail::char_to_suit(s[pos + 1])};
+        } catch (const std::invalid_argument&) {
+            throw ParseError("Invalid card");
+        }
+    }
+
+    /**
+     * @brief Cards of the last [...] group on the line, e.g. the river card of "[Ah 7d 2c 9s] [Kd]"
+     */
+    inline int parse_last_cards(std::string_view line, std::array<Core::Card, 5>& cards) {
+        const size_t open = line.rfind('[');
+        const size_t close = line.find(']', open);
+        if (open == std::string_view::npos || close == std::string_view::npos) throw ParseError("Missing cards");
+        int n = 0;
+        for (size_t p = open + 1; p + 1 < close && n < 5; p += 3) cards[n++] = parse_card(line, p);
+        return n;
+    }
+
+    inline Core::CardMask parse_hole(std::string_view line, size_t from) {
+        const size_t open = line.find('[', from);
+        if (open == std::string_view::npos) throw ParseError("Missing hole cards");
+        return Core::cardMask(parse_card(line, open + 1)) | Core::cardMask(parse_card(line, open + 4));
+    }
+
+    inline uint64_t parse_id(std::string_view line) {
+        size_t pos = line.find('#');
+        if (pos == std::string_view::npos) throw ParseError("Missing hand number");
+        uint64_t id = 0;
+        for (++pos; pos < line.size() && is_digit(line[pos]); ++pos) id = id * 10 + static_cast<uint64_t>(line[pos] - '0');
+        return id;
+    }
+
+    /**
+     * @brief Start of the first hand at or after pos, text.size() if there is none
+     */
+    inline size_t next_hand(std::string_view text, size_t pos) noexcept {
+        if (pos == 0) {
+            if (text.starts_with(HAND_START)) return 0;
+            // a UTF-8 byte order mark often precedes the first hand
+            if (text.starts_with("\xEF\xBB\xBF") && text.substr(3).starts_with(HAND_START)) return 3;
+        }
+        while (true) {
+            const size_t found = text.find(HAND_START, pos);
+            if (found == std::string_view::npos) return text.size();
+            if (found == 0 || text[found - 1] == '\n') return found;
+            pos = found + 1;
+        }
+    }
+}
+
+/**
+ * @brief Parser for PokerStars style hold'em text histories. Seats, blinds, antes, actions, hole cards
+ * (dealt or shown), board, uncalled bets, winnings, pot and rake are kept; everything else is skipped.
+ * The parser keeps no state between hands, so one per thread can be reused without allocating.
+ */
+class HandParser {
+public:
+    /**
+     * @brief Parse one hand, appending its actions. On failure the actions are rolled back.
+     * @return false if the hand is malformed or of an unsupported kind (e.g. run it twice)
+     */
+    bool parse(std::string_view text, HandRecord& hand, std::vector<ActionRecord>& actions) const;
+
+private:
+    void parseHand(std::string_view text, HandRecord& hand, std::vector<ActionRecord>& actions) const;
+};
+
+inline bool HandParser::parse(std::string_view text, HandRecord& hand, std::vector<ActionRecord>& actions) const {
+    const size_t first = actions.size();
+    try {
+        parseHand(text, hand, actions);
+        return true;
+    } catch (const detail::ParseError&) {
+        actions.resize(first);
+        return false;
+    }
+}
+
+inline void HandParser::parseHand(std::string_view text, HandRecord& hand, std::vector<ActionRecord>& actions) const {
+    using detail::ParseError;
+    hand = HandRecord{};
+    hand.text = text;
+    hand.first_action = static_cast<uint32_t>(actions.size());
+
+    size_t pos = 0;
+    const std::string_view header = detail::take_line(text, pos);
+    if (!header.starts_with(detail::HAND_START)) throw ParseError("Not a hand header");
+    if (header.find("Hold'em") == std::string_view::npos) throw ParseError("Not a hold'em hand");
+    hand.id = detail::parse_id(header);
+    hand.tournament = header.find("Tournament #") != std::string_view::npos;
+    const int scale = hand.amountScale();
+
+    // stakes are the first parenthesised "small/big", e.g. "($0.50/$1.00 USD)" or "Level I (10/20)"
+    for (size_t open = header.find('('); open != std::string_view::npos; open = header.find('(', open + 1)) {
+        const size_t close = header.find(')', open);
+        const size_t slash = header.find('/', open);
+        if (close == std::string_view::npos || slash == std::string_view::npos || slash > close) continue;
+        hand.small_blind = detail::parse_amount(header.substr(open, slash - open), scale);
+        hand.big_blind = detail::parse_amount(header.substr(slash, close - slash), scale);
+        break;
+    }
+    if (hand.big_blind == 0) throw ParseError("Missing stakes");
+
+    const std::string_view table_line = detail::take_line(text, pos);
+    if (!table_line.starts_with("Table '")) throw ParseError("Missing table line");
+    const size_t table_end = table_line.rfind('\'');
+    if (table_end <= 7) throw ParseError("Missing table name");
+    hand.table = table_line.substr(7, table_end - 7);
+    if (const size_t button = table_line.find("Seat #", table_end); button != std::string_view::npos) {
+        size_t p = button;
+        hand.button = static_cast<uint8_t>(detail::parse_amount(table_line, p, 1));
+    }
+
+    std::array<int, MAX_SEATS> street_committed{};
+    Street street = Street::Preflop;
+    bool summary = false;
+
+    auto player_of = [&](std::string_view name) -> int {
+        for (int i = 0; i < hand.num_players; ++i) {
+            if (hand.seats[i].name == name) return i;
+        }
+        return -1;
+    };
+
+    while (pos < text.size()) {
+        const std::string_view line = detail::take_line(text, pos);
+        if (line.empty()) continue;
+
+        if (summary) {
+            if (line.starts_with("Total pot ")) {
+                size_t p = 10;
+                hand.total_pot = detail::parse_amount(line, p, scale);
+                if (const size_t rake = line.find("Rake ", p); rake != std::string_view::npos) {
+                    p = rake;
+                    hand.rake = detail::parse_amount(line, p, scale);
+                }
+            }
+            continue;
+        }
+
+        if (line.starts_with("*** ")) {
+            if (line.starts_with("*** FLOP ***")) {
+                street = Street::Flop;
+                if (detail::parse_last_cards(line, hand.board_cards) != 3) throw ParseError("Flop is not three cards");
+                hand.board_size = 3;
+            } else if (line.starts_with("*** TURN ***") || line.starts_with("*** RIVER ***")) {
+                street = line[4] == 'T' ? Street::Turn : Street::River;
+                std::array<Core::Card, 5> card{};
+                if (detail::parse_last_cards(line, card) != 1 || hand.board_size >= 5) throw ParseError("Bad board card");
+                hand.board_cards[hand.board_size++] = card[0];
+            } else if (line.starts_with("*** SUMMARY ***")) {
+                summary = true;
+            } else if (line.starts_with("*** FIRST") || line.starts_with("*** SECOND")) {
+                throw ParseError("Run it twice hands are not supported");
+            } else {
+                continue; // HOLE CARDS, SHOW DOWN
+            }
+            street_committed.fill(0);
+            continue;
+        }
+
+        if (line.starts_with("Seat ") && hand.first_action == actions.size() && street == Street::Preflop) {
+            // "Seat 3: name ($100 in chips)", optionally followed by " is sitting out" or a bounty
+            const size_t colon = line.find(": ");
+            const size_t open = line.rfind(" (");
+            if (colon == std::string_view::npos || open == std::string_view::npos || open <= colon) continue;
+            if (hand.num_players == MAX_SEATS) throw ParseError("Too many seats");
+            SeatRecord& seat = hand.seats[hand.num_players++];
+            seat = SeatRecord{};
+            size_t p = 5;
+            seat.seat = static_cast<uint8_t>(detail::parse_amount(line.substr(0, colon), p, 1));
+            seat.name = line.substr(colon + 2, open - colon - 2);
+            p = open;
+            seat.stack = detail::parse_amount(line, p, scale);
+            continue;
+        }
+
+        if (line.starts_with("Dealt to ")) {
+            const size_t open = line.rfind(" [");
+            if (open == std::string_view::npos) throw ParseError("Missing dealt cards");
+            const int i = player_of(line.substr(9, open - 9));
+            if (i >= 0) hand.seats[i].hole = detail::parse_hole(line, open);
+            continue;
+        }
+
+        if (line.starts_with("Uncalled bet (")) {
+            constexpr std::string_view returned = ") returned to ";
+            const size_t end = line.find(returned);
+            if (end == std::string_view::npos) throw ParseError("Bad uncalled bet");
+            const int i = player_of(line.substr(end + returned.size()));
+            if (i < 0) throw ParseError("Uncalled bet to unknown player");
+            const int amount = detail::parse_amount(line.substr(0, end), scale);
+            hand.seats[i].contributed -= amount;
+            street_committed[i] -= amount;
+            continue;
+        }
+
+        // everything else of interest is "name: action" or "name collected ...", the longest name
+        // wins so that "bob" does not claim the lines of "bob smith"
+        int player = -1;
+        std::string_view rest;
+        for (int i = 0; i < hand.num_players; ++i) {
+            const std::string_view name = hand.seats[i].name;
+            if (line.size() > name.size() + 1 && line.starts_with(name) &&
+                (line[name.size()] == ':' || line[name.size()] == ' ') &&
+                (player < 0 || name.size() > hand.seats[player].name.size()))
+            {
+                player = i;
+                rest = line.substr(name.size());
+            }
+        }
+        if (player < 0) continue;
+
+        SeatRecord& seat = hand.seats[player];
+        if (rest.starts_with(" collected ")) {
+            size_t p = 11;
+            seat.won += detail::parse_amount(rest, p, scale);
+            continue;
+        }
+        if (!rest.starts_with(": ")) continue;
+        rest.remove_prefix(2);
+
+        ActionRecord action{static_cast<uint8_t>(player), street, ActionType::Fold, false, 0};
+        action.all_in = rest.ends_with("and is all-in");
+        if (rest.starts_with("folds")) {
+            action.type = ActionType::Fold;
+        } else if (rest.starts_with("checks")) {
+            action.type = ActionType::Check;
+        } else if (rest.starts_with("calls ")) {
+            action.type = ActionType::Call;
+            action.amount = detail::parse_amount(rest, scale);
+        } else if (rest.starts_with("bets ")) {
+            action.type = ActionType::Bet;
+            action.amount = detail::parse_amount(rest, scale);
+        } else if (rest.starts_with("raises ")) {
+            action.type = ActionType::Raise;
+            const size_t to = rest.find(" to ");
+            if (to == std::string_view::npos) throw ParseError("Raise without total");
+            size_t p = to;
+            action.amount = detail::parse_amount(rest, p, scale) - street_committed[player];
+        } else if (rest.starts_with("posts the ante ")) {
+            action.type = ActionType::Ante;
+            action.amount = detail::parse_amount(rest, scale);
+            // antes are dead money, they do not count towards calling the blinds
+            street_committed[player] -= action.amount;
+        } else if (rest.starts_with("posts small blind ")) {
+            action.type = ActionType::SmallBlind;
+            action.amount = detail::parse_amount(rest, scale);
+        } else if (rest.starts_with("posts big blind ")) {
+            action.type = ActionType::BigBlind;
+            action.amount = detail::parse_amount(rest, scale);
+        } else if (rest.starts_with("posts small & big blinds ")) {
+            action.type = ActionType::BigBlind;
+            action.amount = detail::parse_amount(rest, scale);
+            // the small blind part is dead
+            street_committed[player] -= action.amount - hand.big_blind;
+        } else if (rest.starts_with("shows [")) {
+            seat.hole = detail::parse_hole(rest, 0);
+            continue;
+        } else {
+            continue; // mucks, doesn't show, sits out, chat...
+        }
+
+        if (action.amount < 0) throw ParseError("Negative action amount");
+        street_committed[player] += action.amount;
+        seat.contributed += action.amount;
+        actions.push_back(action);
+    }
+
+    if (!summary) throw ParseError("Truncated hand");
+    if (hand.num_players == 0) throw ParseError("Hand without players");
+    hand.num_actions = static_cast<uint32_t>(actions.size() - hand.first_action);
+}
+
+/**
+ * @brief Calls fn(hand, actions) for every hand in text, in order. One record and one action buffer
+ * are reused for the whole text, so nothing is allocated per hand once the buffer has grown.
+ */
+template<typename Fn>
+ParseStats forEachHand(std::string_view text, Fn&& fn) {
+    ParseStats stats{};
+    const HandParser parser{};
+    HandRecord hand{};
+    std::vector<ActionRecord> actions;
+    actions.reserve(64);
+
+    size_t start = detail::next_hand(text, 0);
+    while (start < text.size()) {
+        const size_t end = detail::next_hand(text, start + 1);
+        actions.clear();
+        if (parser.parse(text.substr(start, end - start), hand, actions)) {
+            ++stats.hands;
+            fn(static_cast<const HandRecord&>(hand), std::span<const ActionRecord>(actions));
+        } else {
+            ++stats.skipped;
+        }
+        start = end;
+    }
+    return stats;
+}
+
+/**
+ * @brief Split text into at most parts pieces of about equal size, each a whole number of hands
+ */
+inline std::vector<std::string_view> splitHands(std::string_view text, size_t parts) {
+    std::vector<std::string_view> pieces;
+    parts = std::max<size_t>(1, parts);
+    size_t start = detail::next_hand(text, 0);
+    for (size_t k = 1; k <= parts && start < text.size(); ++k) {
+        const size_t target = k == parts ? text.size() : std::max(start + 1, text.size() / parts * k);
+        const size_t end = target >= text.size() ? text.size() : detail::next_hand(text, target);
+        pieces.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return pieces;
+}
+
+/**
+ * @brief As forEachHand with the text split across threads at hand boundaries.
+ * fn(worker, hand, actions) is called concurrently from different workers, in text order within a worker.
+ */
+template<typename Fn>
+ParseStats forEachHandParallel(std::string_view text, Fn&& fn, unsigned threads = std::thread::hardware_concurrency()) {
+    const std::vector<std::string_view> pieces = splitHands(text, std::max(1u, threads));
+    std::vector<ParseStats> stats(pieces.size());
+    std::vector<std::exception_ptr> errors(pieces.size());
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(pieces.size());
+        for (size_t w = 0; w < pieces.size(); ++w) {
+            workers.emplace_back([&, w] {
+                try {
+                    stats[w] = forEachHand(pieces[w], [&](const HandRecord& hand, std::span<const ActionRecord> actions) {
+                        fn(static_cast<unsigned>(w), hand, actions);
+                    });
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    ParseStats total{};
+    for (const auto& s : stats) {
+        total.hands += s.hands;
+        total.skipped += s.skipped;
+    }
+    return total;
+}
+
+/**
+ * @brief Every hand of text as records, parsed in parallel and returned in text order
+ */
+inline ParsedHands parseHands(std::string_view text, unsigned threads = std::thread::hardware_concurrency()) {
+    const std::vector<std::string_view> pieces = splitHands(text, std::max(1u, threads));
+    std::vector<ParsedHands> partial(pieces.size());
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(pieces.size());
+        for (size_t w = 0; w < pieces.size(); ++w) {
+            workers.emplace_back([&, w] {
+                const HandParser parser{};
+                ParsedHands& out = partial[w];
+                // roughly one hand per kilobyte of text
+                out.hands.reserve(pieces[w].size() / 1024 + 1);
+                size_t start = detail::next_hand(pieces[w], 0);
+                while (start < pieces[w].size()) {
+                    const size_t end = detail::next_hand(pieces[w], start + 1);
+                    HandRecord& hand = out.hands.emplace_back();
+                    if (!parser.parse(pieces[w].substr(start, end - start), hand, out.actions)) {
+                        out.hands.pop_back();
+                        ++out.skipped;
+                    }
+                    start = end;
+                }
+            });
+        }
+    }
+
+    ParsedHands result = partial.empty() ? ParsedHands{} : std::move(partial[0]);
+    for (size_t w = 1; w < partial.size(); ++w) {
+        const auto offset = static_cast<uint32_t>(result.actions.size());
+        for (auto& hand : partial[w].hands) {
+            hand.first_action += offset;
+            result.hands.push_back(hand);
+        }
+        result.actions.insert(result.actions.end(), partial[w].actions.begin(), partial[w].actions.end());
+        result.skipped += partial[w].skipped;
+    }
+    return result;
+}
+
+/**
+ * @brief A history file memory mapped for its lifetime. Records parsed from it view into the mapping
+ * and must not outlive this object.
+ */
+class HandHistoryFile {
+public:
+    explicit HandHistoryFile(const std::string& path) : file_(path) {}
+
+    std::string_view text() const noexcept {
+        return {reinterpret_cast<const char*>(file_.data()), file_.size()};
+    }
+
+    template<typename Fn>
+    ParseStats forEachHand(Fn&& fn) const { return History::forEachHand(text(), std::forward<Fn>(fn)); }
+
+    template<typename Fn>
+    ParseStats forEachHandParallel(Fn&& fn, unsigned threads = std::thread::hardware_concurrency()) const {
+        return History::forEachHandParallel(text(), std::forward<Fn>(fn), threads);
+    }
+
+    ParsedHands parse(unsigned threads = std::thread::hardware_concurrency()) const {
+        return parseHands(text(), threads);
+    }
+
+private:
+    Core::detail::MappedFile file_;
+};
+
+}
+
+#endif
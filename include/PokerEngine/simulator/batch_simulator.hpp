@@ -0,0 +1,133 @@
+#ifndef POKER_ENGINE_SIMULATOR_BATCH_SIMULATOR_HPP
+#define POKER_ENGINE_SIMULATOR_BATCH_SIMULATOR_HPP
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <random>
+#include <stdexcept>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/deck.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/detail/combo_sampler.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Monte Carlo equity for many hero ranges (or hands) against the same villain ranges and board.
+ * Each trial deals the villains and the runout once and scores them once, then every hero query
+ * samples its own combo against that deal. A hero combo colliding with the deal rejects the trial for
+ * that query only, so each query is an unbiased estimate over its own accepted trials.
+ */
+class BatchPokerSimulator {
+public:
+    BatchPokerSimulator(std::vector<Core::Range> hero_ranges, Core::Board board, int num_opponents, Core::Deck deck)
+        : hero_ranges_(std::move(hero_ranges)), community_cards_(std::move(board)),
+          num_opponents_(num_opponents), deck_(std::move(deck)) {}
+
+    /**
+     * @return One result per hero range, in the order given. trials holds the accepted trials of each query.
+     */
+    std::vector<SimResult> simulate(const std::vector<Core::Range>& opponent_ranges,
+                                    int iterations,
+                                    unsigned seed = std::random_device{}()) const;
+
+private:
+    std::vector<Core::Range> hero_ranges_;
+    Core::Board community_cards_;
+    int num_opponents_;
+    Core::Deck deck_;
+    Evaluator::HandEvaluator eval_{};
+};
+
+namespace {
+    constexpr int MAX_BATCH_OPPONENTS = 9;
+}
+
+inline std::vector<SimResult> BatchPokerSimulator::simulate(const std::vector<Core::Range>& opponent_ranges,
+                                                            int iterations, unsigned seed) const
+{
+    if (opponent_ranges.size() != static_cast<size_t>(num_opponents_))
+        throw std::invalid_argument("Opponent ranges size does not match num_opponents");
+    if (num_opponents_ > MAX_BATCH_OPPONENTS)
+        throw std::invalid_argument("Too many opponents");
+
+    const Core::CardMask board = Core::cardsMask(community_cards_.get());
+    const int missing = detail::MAX_BOARD_SIZE_NLH - static_cast<int>(community_cards_.size());
+
+    const Core::CardMask deck_mask = detail::deck_mask(deck_) & ~board;
+    std::vector<Core::CardMask> deck_cards;
+    for (Core::CardMask m = deck_mask; m; m &= m - 1) deck_cards.push_back(m & (~m + 1));
+
+    std::vector<detail::ComboSampler> villains;
+    for (const auto& r : opponent_ranges) {
+        villains.emplace_back(r, board);
+        if (villains.back().empty()) throw std::runtime_error("No available combo for opponent");
+    }
+
+    std::vector<detail::ComboSampler> heroes;
+    for (const auto& r : hero_ranges_) heroes.emplace_back(r, board);
+
+    std::vector<SimResult> results(hero_ranges_.size());
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick_card(0, deck_cards.empty() ? 0 : deck_cards.size() - 1);
+
+    for (int it = 0; it < iterations; ++it) {
+        // deal villains, each avoiding the cards already dealt
+        Core::CardMask dealt = board;
+        std::array<Core::CardMask, MAX_BATCH_OPPONENTS> villain_hands{};
+        for (size_t v = 0; v < villains.size(); ++v) {
+            const size_t idx = villains[v].sampleExcluding(rng, dealt);
+            if (idx == detail::ComboSampler::npos)
+                throw std::runtime_error("No available combo for opponent");
+            villain_hands[v] = villains[v].mask(idx);
+            dealt |= villain_hands[v];
+        }
+
+        // complete the board from the cards left
+        if (std::popcount(deck_mask & ~dealt) < missing)
+            throw std::runtime_error("Not enough cards left in deck to complete the board");
+        Core::CardMask runout = 0;
+        for (int i = 0; i < missing; ++i) {
+            Core::CardMask card;
+            do {
+                card = deck_cards[pick_card(rng)];
+            } while (card & (dealt | runout));
+            runout |= card;
+        }
+        const Core::CardMask full_board = board | runout;
+        dealt |= runout;
+
+        uint64_t best_villain = 0;
+        for (size_t v = 0; v < villains.size(); ++v) {
+            best_villain = std::max(best_villain, eval_.score(full_board | villain_hands[v]));
+        }
+
+        for (size_t q = 0; q < heroes.size(); ++q) {
+            if (heroes[q].empty()) continue;
+            const Core::CardMask hero = heroes[q].mask(heroes[q].sample(rng));
+            if (hero & dealt) continue;
+
+            const uint64_t hero_score = eval_.score(full_board | hero);
+            auto& r = results[q];
+            if (hero_score > best_villain) r.win += 1.0;
+            else if (hero_score == best_villain) r.tie += 1.0;
+            else r.loss += 1.0;
+            ++r.trials;
+        }
+    }
+
+    for (auto& r : results) {
+        if (r.trials > 0) r.normalise();
+    }
+    return results;
+}
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef POKER_ENGINE_SIMULATOR_DETAIL_COMBO_SAMPLER_HPP
+#define POKER_ENGINE_SIMULATOR_DETAIL_COMBO_SAMPLER_HPP
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+
+namespace PokerEngine::Simulator::detail {
+
+/**
+ * @brief Flattened view of a range for the hot loop: combo masks, combo ids and prefix sums of the
+ * weights, so a weighted sample is a binary search rather than a pass over the range.
+ */
+class ComboSampler {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ComboSampler() = default;
+
+    /**
+     * @param dead Cards already known, combos using any of them are dropped
+     */
+    explicit ComboSampler(const Core::Range& range, Core::CardMask dead = 0) {
+        masks_.reserve(range.size());
+        ids_.reserve(range.size());
+        cumulative_.reserve(range.size());
+
+        double total = 0.0;
+        for (const auto& combo : range.combos()) {
+            const Core::CardMask mask = Core::comboMask(combo);
+            if (mask & dead || combo.weight <= 0.0) continue;
+            total += combo.weight;
+            masks_.push_back(mask);
+            ids_.push_back(Core::comboIndex(combo));
+            cumulative_.push_back(total);
+        }
+    }
+
+    bool empty() const noexcept { return masks_.empty(); }
+    size_t size() const noexcept { return masks_.size(); }
+    double totalWeight() const noexcept { return cumulative_.empty() ? 0.0 : cumulative_.back(); }
+
+    /**
+     * @brief Index of a weighted random combo, the sampler must not be empty
+     */
+    template<typename URBG = std::mt19937>
+    size_t sample(URBG& rng) const noexcept {
+        std::uniform_real_distribution<double> dist(0.0, totalWeight());
+        auto it = std::upper_bound(cumulative_.begin(), cumulative_.end(), dist(rng));
+        return std::min(static_cast<size_t>(it - cumulative_.begin()), cumulative_.size() - 1);
+    }
+
+    /**
+     * @brief Weighted sample among the combos not touching dead, i.e. a sample from the range with
+     * those combos removed. Rejection first, falling back to a scan when most combos are blocked.
+     * @return npos if every combo is blocked
+     */
+    template<typename URBG = std::mt19937>
+    size_t sampleExcluding(URBG& rng, Core::CardMask dead) const noexcept {
+        if (masks_.empty()) return npos;
+        for (int attempt = 0; attempt < MAX_REJECTION_ATTEMPTS; ++attempt) {
+            const size_t i = sample(rng);
+            if (!(masks_[i] & dead)) return i;
+        }
+
+        double open_weight = 0.0;
+        for (size_t i = 0; i < masks_.size(); ++i) {
+            if (!(masks_[i] & dead)) open_weight += weight(i);
+        }
+        if (open_weight <= 0.0) return npos;
+
+        std::uniform_real_distribution<double> dist(0.0, open_weight);
+        double pick = dist(rng);
+        size_t last_open = npos;
+        for (size_t i = 0; i < masks_.size(); ++i) {
+            if (masks_[i] & dead) continue;
+            last_open = i;
+            pick -= weight(i);
+            if (pick <= 0.0) return i;
+        }
+        return last_open;
+    }
+
+    double weight(size_t i) const noexcept { return cumulative_[i] - (i == 0 ? 0.0 : cumulative_[i - 1]); }
+    Core::CardMask mask(size_t i) const noexcept { return masks_[i]; }
+    int id(size_t i) const noexcept { return ids_[i]; }
+
+private:
+    static constexpr int MAX_REJECTION_ATTEMPTS = 64;
+
+    std::vector<Core::CardMask> masks_;
+    std::vector<int> ids_;
+    std::vector<double> cumulative_;
+};
+
+}
+
+#endif
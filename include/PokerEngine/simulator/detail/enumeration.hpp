@@ -0,0 +1,59 @@
+#ifndef POKER_ENGINE_SIMULATOR_DETAIL_ENUMERATION_HPP
+#define POKER_ENGINE_SIMULATOR_DETAIL_ENUMERATION_HPP
+
+#include <array>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/deck.hpp"
+
+namespace PokerEngine::Simulator::detail {
+
+constexpr int MAX_BOARD_SIZE_NLH = 5;
+
+inline Core::CardMask deck_mask(const Core::Deck& deck) noexcept {
+    Core::CardMask mask = 0;
+    for (const auto& c : deck.view()) mask |= Core::cardMask(c);
+    return mask;
+}
+
+template<typename Fn>
+void for_each_subset_impl(const std::array<Core::CardMask, Core::NUM_CARDS>& cards, int n,
+                          int start, int remaining, Core::CardMask acc, Fn& fn)
+{
+    if (remaining == 0) {
+        fn(acc);
+        return;
+    }
+    for (int i = start; i <= n - remaining; ++i) {
+        for_each_subset_impl(cards, n, i + 1, remaining - 1, acc | cards[i], fn);
+    }
+}
+
+/**
+ * @brief Calls fn(mask) once for every k card subset of available, e.g. every runout of the board
+ */
+template<typename Fn>
+void for_each_subset(Core::CardMask available, int k, Fn&& fn) {
+    std::array<Core::CardMask, Core::NUM_CARDS> cards{};
+    int n = 0;
+    while (available) {
+        cards[n++] = available & (~available + 1);
+        available &= available - 1;
+    }
+    if (k < 0 || k > n) return;
+    for_each_subset_impl(cards, n, 0, k, Core::CardMask{0}, fn);
+}
+
+/**
+ * @brief Number of k card subsets of an n card set
+ */
+constexpr inline long long choose(int n, int k) noexcept {
+    if (k < 0 || k > n) return 0;
+    long long result = 1;
+    for (int i = 1; i <= k; ++i) result = result * (n - k + i) / i;
+    return result;
+}
+
+}
+
+#endif
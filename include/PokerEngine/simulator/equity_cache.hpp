@@ -0,0 +1,285 @@
+#ifndef POKER_ENGINE_SIMULATOR_EQUITY_CACHE_HPP
+#define POKER_ENGINE_SIMULATOR_EQUITY_CACHE_HPP
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/deck.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Canonical description of an equity query. Suit isomorphic queries produce equal keys.
+ */
+struct EquityKey {
+    std::vector<uint64_t> words;
+    uint64_t hash = 0;
+    // Index into Core::SUIT_PERMUTATIONS taking the query to its canonical labelling, not part of the identity
+    uint8_t permutation = 0;
+};
+
+inline bool operator==(const EquityKey& lhs, const EquityKey& rhs) noexcept {
+    return lhs.hash == rhs.hash && lhs.words == rhs.words;
+}
+
+namespace detail {
+    inline int permute_card(int card, const Core::SuitPermutation& perm) noexcept {
+        return perm[card / 13] * 13 + card % 13;
+    }
+
+    inline int permute_combo(int combo_id, const Core::SuitPermutation& perm) noexcept {
+        const auto [low, high] = Core::comboCardsFromIndex(combo_id);
+        const int a = permute_card(low, perm);
+        const int b = permute_card(high, perm);
+        return a < b ? Core::comboIndex(a, b) : Core::comboIndex(b, a);
+    }
+
+    inline void append_range(std::vector<uint64_t>& words, const Core::Range& range,
+                             const Core::SuitPermutation& perm, std::vector<uint64_t>& scratch)
+    {
+        const auto& combos = range.combos();
+        scratch.clear();
+        for (size_t i = 0; i < combos.size(); ++i) {
+            const int id = permute_combo(Core::comboIndex(combos[i]), perm);
+            scratch.push_back(static_cast<uint64_t>(id) << 32 | i); // sort by id, remember the source combo
+        }
+        std::sort(scratch.begin(), scratch.end());
+
+        words.push_back(combos.size());
+        for (auto entry : scratch) {
+            words.push_back(entry >> 32);
+            words.push_back(std::bit_cast<uint64_t>(combos[entry & 0xFFFFFFFFu].weight));
+        }
+    }
+
+    inline uint64_t hash_words(const std::vector<uint64_t>& words) noexcept {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (auto w : words) {
+            h ^= w + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Move per combo tallies to the labelling given by perm
+     */
+    inline void relabel_combos(SimResult& result, const Core::SuitPermutation& perm) {
+        if (result.combos.empty()) return;
+        std::vector<ComboTally> relabelled(result.combos.size());
+        for (size_t id = 0; id < result.combos.size(); ++id) {
+            relabelled[permute_combo(static_cast<int>(id), perm)] = result.combos[id];
+        }
+        result.combos = std::move(relabelled);
+    }
+
+    inline Core::SuitPermutation inverse(const Core::SuitPermutation& perm) noexcept {
+        Core::SuitPermutation inv{};
+        for (uint8_t s = 0; s < 4; ++s) inv[perm[s]] = s;
+        return inv;
+    }
+}
+
+/**
+ * @brief Tag telling apart strategies that answer the same query differently: strategy.cacheTag() if
+ * the strategy has one, otherwise its type. Only stable within one process.
+ */
+template<typename Strategy>
+uint64_t strategyCacheTag(const Strategy& strategy) {
+    if constexpr (requires { { strategy.cacheTag() } -> std::convertible_to<uint64_t>; })
+        return strategy.cacheTag();
+    else
+        return typeid(Strategy).hash_code();
+}
+
+/**
+ * @brief Key for hero range vs opponent ranges on a board, for a given accuracy target (iterations) and result mode.
+ * Every suit relabelling of the query is serialised and the smallest serialisation is kept.
+ * @param strategy_tag Identifies what answers the query, e.g. strategyCacheTag with a flag for a preflop table
+ */
+inline EquityKey makeEquityKey(const Core::Range& hero, const Core::Board& board, const Core::Deck& deck,
+                               const std::vector<Core::Range>& opponent_ranges, int iterations,
+                               ResultMode mode = ResultMode::Aggregate, uint64_t strategy_tag = 0)
+{
+    const Core::CardMask board_mask = Core::cardsMask(board.get());
+    const Core::CardMask deck_mask = detail::deck_mask(deck);
+
+    EquityKey best{};
+    std::vector<uint64_t> candidate, scratch;
+    for (size_t p = 0; p < Core::SUIT_PERMUTATIONS.size(); ++p) {
+        const auto& perm = Core::SUIT_PERMUTATIONS[p];
+        // the board leads the serialisation, so a larger permuted board can never win
+        const uint64_t permuted_board = Core::permuteSuits(board_mask, perm);
+        if (!best.words.empty() && permuted_board > best.words[0]) continue;
+
+        candidate.clear();
+        candidate.push_back(permuted_board);
+        candidate.push_back(Core::permuteSuits(deck_mask, perm));
+        candidate.push_back(static_cast<uint64_t>(iterations));
+        candidate.push_back(static_cast<uint64_t>(mode));
+        candidate.push_back(strategy_tag);
+        detail::append_range(candidate, hero, perm, scratch);
+        candidate.push_back(opponent_ranges.size());
+        for (const auto& range : opponent_ranges) detail::append_range(candidate, range, perm, scratch);
+
+        if (best.words.empty() || candidate < best.words) {
+            best.words = candidate;
+            best.permutation = static_cast<uint8_t>(p);
+        }
+    }
+
+    best.hash = detail::hash_words(best.words);
+    return best;
+}
+
+struct EquityCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ * @brief Bounded, thread safe LRU cache of equity results.
+ * Entries are spread over independently locked shards by key hash so concurrent callers rarely contend.
+ */
+class EquityCache {
+public:
+    explicit EquityCache(size_t capacity, size_t num_shards = 16);
+
+    /**
+     * @brief Lookups and inserts use the canonical labelling, per combo tallies included.
+     * getOrCompute converts to and from the caller's labelling.
+     */
+    std::optional<SimResult> find(const EquityKey& key);
+    void insert(const EquityKey& key, SimResult result);
+
+    /**
+     * @brief Cached result for key, or compute() stored and returned on a miss.
+     * compute runs outside any lock, concurrent misses on the same key may both compute.
+     */
+    template<typename Compute>
+    SimResult getOrCompute(const EquityKey& key, Compute&& compute) {
+        const auto& perm = Core::SUIT_PERMUTATIONS[key.permutation];
+        if (auto hit = find(key)) {
+            detail::relabel_combos(*hit, detail::inverse(perm));
+            return std::move(*hit);
+        }
+        SimResult result = compute();
+        SimResult canonical = result;
+        detail::relabel_combos(canonical, perm);
+        insert(key, std::move(canonical));
+        return result;
+    }
+
+    EquityCacheStats stats() const noexcept {
+        return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed),
+                evictions_.load(std::memory_order_relaxed)};
+    }
+
+    size_t size() const;
+    size_t capacity() const noexcept { return shard_capacity_ * shards_.size(); }
+    void clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const EquityKey& key) const noexcept { return static_cast<size_t>(key.hash); }
+    };
+
+    struct Shard {
+        using Entry = std::pair<EquityKey, SimResult>;
+        mutable std::mutex mutex;
+        std::list<Entry> lru; // most recently used at the front
+        std::unordered_map<EquityKey, std::list<Entry>::iterator, KeyHash> index;
+    };
+
+    Shard& shardFor(const EquityKey& key) noexcept {
+        // the low bits pick the hash bucket inside the shard, use the high ones here
+        return *shards_[(key.hash >> 48) % shards_.size()];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t shard_capacity_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+inline EquityCache::EquityCache(size_t capacity, size_t num_shards) {
+    num_shards = std::max<size_t>(1, std::min(num_shards, std::max<size_t>(1, capacity)));
+    shard_capacity_ = std::max<size_t>(1, (capacity + num_shards - 1) / num_shards);
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+inline std::optional<SimResult> EquityCache::find(const EquityKey& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second->second;
+}
+
+inline void EquityCache::insert(const EquityKey& key, SimResult result) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        it->second->second = std::move(result);
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    shard.lru.emplace_front(key, std::move(result));
+    shard.index.emplace(key, shard.lru.begin());
+
+    if (shard.lru.size() > shard_capacity_) {
+        shard.index.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline size_t EquityCache::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard lock(shard->mutex);
+        total += shard->lru.size();
+    }
+    return total;
+}
+
+inline void EquityCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef POKER_ENGINE_SIMULATOR_EXACT_EQUITY_STRATEGY_HPP
+#define POKER_ENGINE_SIMULATOR_EXACT_EQUITY_STRATEGY_HPP
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/deck.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/equity_cache.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Exact heads up range-vs-range equity.
+ * Every non-conflicting (hero combo, villain combo) pair is enumerated over all runouts and the
+ * pair equities are combined with the combo weights. Pair equities are memoised under suit
+ * isomorphism in a bounded EquityCache, so e.g. AsKs vs QhQd and AhKh vs QsQc are only enumerated
+ * once while they stay cached. A memo capacity of 0 turns memoisation off.
+ * Iterations and seed are ignored, the result is exact.
+ */
+class ExactNLHStrategy {
+public:
+    static constexpr size_t DEFAULT_MEMO_CAPACITY = size_t{1} << 18;
+
+    ExactNLHStrategy() : ExactNLHStrategy(ResultMode::Aggregate) {}
+    explicit ExactNLHStrategy(ResultMode mode, size_t memo_capacity = DEFAULT_MEMO_CAPACITY)
+        : mode_(mode), memo_(memo_capacity > 0 ? std::make_unique<EquityCache>(memo_capacity) : nullptr) {}
+
+    ResultMode mode() const noexcept { return mode_; }
+
+    SimResult run(
+        const Core::Range& my_range,
+        const Core::Board& community,
+        int num_opponents,
+        Core::Deck deck,
+        const std::vector<Core::Range>& opponent_ranges,
+        int iterations = 0,
+        unsigned seed = std::random_device{}()
+    ) const;
+
+    /**
+     * @brief Exact equity of one hand against another, runouts drawn from deck excluding known cards
+     */
+    SimResult pairEquity(Core::CardMask board, Core::CardMask hero, Core::CardMask villain, Core::CardMask deck) const;
+
+    size_t memoSize() const { return memo_ ? memo_->size() : 0; }
+
+private:
+    SimResult enumeratePair(Core::CardMask board, Core::CardMask hero, Core::CardMask villain, Core::CardMask deck) const;
+
+    Evaluator::HandEvaluator eval_{};
+    ResultMode mode_ = ResultMode::Aggregate;
+    // behind a pointer so the strategy stays movable, the cache does its own locking
+    std::unique_ptr<EquityCache> memo_;
+};
+
+inline SimResult ExactNLHStrategy::enumeratePair(Core::CardMask board, Core::CardMask hero,
+                                                 Core::CardMask villain, Core::CardMask deck) const
+{
+    SimResult result{};
+    const int missing = detail::MAX_BOARD_SIZE_NLH - std::popcount(board);
+    const Core::CardMask available = deck & ~(board | hero | villain);
+
+    detail::for_each_subset(available, missing, [&](Core::CardMask runout) {
+        const Core::CardMask full_board = board | runout;
+        const auto hero_score = eval_.score(full_board | hero);
+        const auto villain_score = eval_.score(full_board | villain);
+        if (hero_score > villain_score) result.win += 1.0;
+        else if (hero_score == villain_score) result.tie += 1.0;
+        else result.loss += 1.0;
+    });
+
+    if (result.win + result.tie + result.loss == 0.0)
+        throw std::runtime_error("Not enough cards left in deck to complete the board");
+
+    result.normalise();
+    return result;
+}
+
+inline SimResult ExactNLHStrategy::pairEquity(Core::CardMask board, Core::CardMask hero,
+                                              Core::CardMask villain, Core::CardMask deck) const
+{
+    // a complete board is a single comparison, cheaper than the memo lookup
+    if (!memo_ || std::popcount(board) == detail::MAX_BOARD_SIZE_NLH) return enumeratePair(board, hero, villain, deck);
+
+    const auto canonical = Core::canonicalise(std::array<Core::CardMask, 4>{board, hero, villain, deck});
+    EquityKey key{};
+    key.words.assign(canonical.begin(), canonical.end());
+    key.hash = detail::hash_words(key.words);
+    return memo_->getOrCompute(key, [&] { return enumeratePair(canonical[0], canonical[1], canonical[2], canonical[3]); });
+}
+
+inline SimResult ExactNLHStrategy::run(
+    const Core::Range& my_range,
+    const Core::Board& community,
+    int num_opponents,
+    Core::Deck deck,
+    const std::vector<Core::Range>& opponent_ranges,
+    int,
+    unsigned
+) const
+{
+    if (num_opponents != 1 || opponent_ranges.size() != 1)
+        throw std::invalid_argument("Exact enumeration only supports a single opponent");
+
+    const Core::CardMask board = Core::cardsMask(community.get());
+    const Core::CardMask deck_cards = detail::deck_mask(deck) | board;
+
+    SimResult result{};
+    if (mode_ == ResultMode::PerCombo) result.combos.resize(Core::NUM_COMBOS);
+    double total_weight = 0.0;
+
+    for (const auto& hero : my_range.combos()) {
+        const Core::CardMask hero_mask = Core::comboMask(hero);
+        if (hero_mask & board || hero.weight <= 0.0) continue;
+        ComboTally* tally = result.combos.empty() ? nullptr : &result.combos[Core::comboIndex(hero)];
+
+        for (const auto& villain : opponent_ranges[0].combos()) {
+            const Core::CardMask villain_mask = Core::comboMask(villain);
+            if (villain_mask & (board | hero_mask) || villain.weight <= 0.0) continue;
+
+            const double weight = hero.weight * villain.weight;
+            const SimResult pair = pairEquity(board, hero_mask, villain_mask, deck_cards);
+            result.win += weight * pair.win;
+            result.tie += weight * pair.tie;
+            result.loss += weight * pair.loss;
+            total_weight += weight;
+            ++result.trials;
+            if (tally) *tally += ComboTally{weight * pair.win, weight * pair.tie, weight * pair.loss};
+        }
+    }
+
+    if (total_weight == 0.0)
+        throw std::runtime_error("No non-conflicting combos between ranges");
+
+    result.normalise();
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef POKER_ENGINE_SIMULATOR_HAND_STRENGTH_HPP
+#define POKER_ENGINE_SIMULATOR_HAND_STRENGTH_HPP
+
+#include <vector>
+#include <bit>
+#include <stdexcept>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Distribution of a hand's river equity over all runouts of the board
+ */
+struct HandStrength {
+    // Expected hand strength, the mean river equity over runouts
+    double ehs = 0.0;
+    // Mean squared river equity, rewards hands whose equity is volatile (draws)
+    double ehs2 = 0.0;
+    // Fraction of runouts whose river equity falls in each of equal width bins over [0, 1]
+    std::vector<double> histogram;
+    // Runouts with at least one live villain combo
+    size_t runouts = 0;
+};
+
+/**
+ * @brief Enumerates every turn and river card and computes the hand's equity against a villain range
+ * on each complete board. Villain combos are scored once per runout, the hero hand once.
+ */
+class HandStrengthEngine {
+public:
+    explicit HandStrengthEngine(size_t bins = 50);
+
+    size_t bins() const noexcept { return bins_; }
+
+    /**
+     * @param dead Cards removed from the deck in addition to hero and board
+     */
+    HandStrength compute(Core::CardMask hero, Core::CardMask board, const Core::Range& villain,
+                         Core::CardMask dead = 0) const;
+
+    /**
+     * @brief Against a uniformly random villain hand
+     */
+    HandStrength compute(Core::CardMask hero, Core::CardMask board, Core::CardMask dead = 0) const;
+
+    HandStrength compute(const Core::Combo& hero, const Core::Board& board, const Core::Range& villain) const {
+        return compute(Core::comboMask(hero), Core::cardsMask(board.get()), villain);
+    }
+
+private:
+    struct VillainCombo {
+        Core::CardMask mask;
+        double weight;
+    };
+
+    HandStrength enumerate(Core::CardMask hero, Core::CardMask board, Core::CardMask dead,
+                           const std::vector<VillainCombo>& villain) const;
+
+    Evaluator::HandEvaluator eval_{};
+    size_t bins_;
+    std::vector<VillainCombo> uniform_;
+};
+
+inline HandStrengthEngine::HandStrengthEngine(size_t bins) : bins_(std::max<size_t>(bins, 1)) {
+    uniform_.reserve(Core::NUM_COMBOS);
+    for (int id = 0; id < Core::NUM_COMBOS; ++id) {
+        const auto [low, high] = Core::comboCardsFromIndex(id);
+        uniform_.push_back({(Core::CardMask{1} << low) | (Core::CardMask{1} << high), 1.0});
+    }
+}
+
+inline HandStrength HandStrengthEngine::compute(Core::CardMask hero, Core::CardMask board,
+                                                const Core::Range& villain, Core::CardMask dead) const
+{
+    std::vector<VillainCombo> combos;
+    combos.reserve(villain.size());
+    for (const auto& combo : villain.combos()) {
+        if (combo.weight > 0.0) combos.push_back({Core::comboMask(combo), combo.weight});
+    }
+    return enumerate(hero, board, dead, combos);
+}
+
+inline HandStrength HandStrengthEngine::compute(Core::CardMask hero, Core::CardMask board, Core::CardMask dead) const {
+    return enumerate(hero, board, dead, uniform_);
+}
+
+inline HandStrength HandStrengthEngine::enumerate(Core::CardMask hero, Core::CardMask board, Core::CardMask dead,
+                                                  const std::vector<VillainCombo>& villain) const
+{
+    if (std::popcount(hero) != 2 || hero & board)
+        throw std::invalid_argument("Hero hand must be two cards not on the board");
+    if (std::popcount(board) < 3 || std::popcount(board) > detail::MAX_BOARD_SIZE_NLH)
+        throw std::invalid_argument("Hand strength needs a flop, turn or river board");
+
+    // combos blocked by known cards are dropped up front, the rest only check the runout
+    const Core::CardMask known = hero | board | dead;
+    std::vector<VillainCombo> live;
+    live.reserve(villain.size());
+    for (const auto& v : villain) {
+        if (!(v.mask & known)) live.push_back(v);
+    }
+
+    HandStrength result{};
+    result.histogram.assign(bins_, 0.0);
+    const int missing = detail::MAX_BOARD_SIZE_NLH - std::popcount(board);
+    const Core::CardMask available = Core::CardMask{(1ULL << Core::NUM_CARDS) - 1} & ~known;
+
+    detail::for_each_subset(available, missing, [&](Core::CardMask runout) {
+        const Core::CardMask full_board = board | runout;
+        const auto hero_score = eval_.score(full_board | hero);
+
+        double won = 0.0, total = 0.0;
+        for (const auto& v : live) {
+            if (v.mask & runout) continue;
+            const auto villain_score = eval_.score(full_board | v.mask);
+            if (hero_score > villain_score) won += v.weight;
+            else if (hero_score == villain_score) won += v.weight / 2.0;
+            total += v.weight;
+        }
+        if (total == 0.0) return;
+
+        const double equity = won / total;
+        result.ehs += equity;
+        result.ehs2 += equity * equity;
+        result.histogram[std::min(static_cast<size_t>(equity * bins_), bins_ - 1)] += 1.0;
+        ++result.runouts;
+    });
+
+    if (result.runouts == 0)
+        throw std::runtime_error("No villain combo is live on any runout");
+
+    const double n = static_cast<double>(result.runouts);
+    result.ehs /= n;
+    result.ehs2 /= n;
+    for (auto& h : result.histogram) h /= n;
+    return result;
+}
+
+}
+
+#endif
@@ -3,22 +3,34 @@
 
 #include <vector>
 #include <random>
+#include <bit>
+#include <stdexcept>
+#include <algorithm>
 
 #include "PokerEngine/core/card.hpp"
-#include "PokerEngine/core/hand.hpp"
+#include "PokerEngine/core/card_mask.hpp"
 #include "PokerEngine/core/range.hpp"
 #include "PokerEngine/core/board.hpp"
 #include "PokerEngine/core/deck.hpp"
-#include "PokerEngine/core/game_state.hpp"
-#include "PokerEngine/core/player_state.hpp"
 #include "PokerEngine/evaluator/hand_evaluator.hpp"
 #include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/detail/combo_sampler.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
 
 namespace PokerEngine::Simulator {
 
+/**
+ * @brief Monte Carlo equity of a hero range against one or more opponent ranges.
+ * Everything the loop needs is set up before the first trial: ranges are flattened into samplers,
+ * the deck into card masks and the dealt hands into scratch buffers, so the steady state loop
+ * does not allocate.
+ */
 class MonteCarloNLHStrategy {
 public:
     MonteCarloNLHStrategy() = default;
+    explicit MonteCarloNLHStrategy(ResultMode mode) : mode_(mode) {}
+
+    ResultMode mode() const noexcept { return mode_; }
 
     SimResult run(
         const Core::Range& my_range,
@@ -32,61 +44,10 @@ public:
 
 private:
     Evaluator::HandEvaluator eval_{};
+    ResultMode mode_ = ResultMode::Aggregate;
 };
 
-namespace {
-    constexpr int MAX_BOARD_SIZE_NLH = 5;
-
-    std::vector<Core::Hand> sampleCardsFromRange(int num_players, std::vector<Core::Range> ranges,
-                                                    Core::Deck& deck, std::mt19937& rng) 
-    {
-        std::vector<Core::Hand> opp_hands;
-        opp_hands.reserve(num_players);
-        for(const auto& range : ranges) {
-            auto combo_opt = range.sample(rng);
-            if(!combo_opt.has_value())
-                throw std::runtime_error("No available combo for opponent");
-
-            auto combo = *combo_opt;
-            Core::Hand hand{{combo.c1, combo.c2}};
-            opp_hands.push_back(std::move(hand));
-
-            deck.remove(combo.c1);
-            deck.remove(combo.c2);
-        }
-
-        return opp_hands;
-    }
-
-    Core::Hand sampleHandFromRange(Core::Range range,
-                                Core::Deck& deck, std::mt19937& rng) {
-        auto combo_opt = range.sample(rng);
-        if(!combo_opt.has_value())
-            throw std::runtime_error("No available combo for opponent");
-
-        auto combo = *combo_opt;
-        deck.remove({combo.c1, combo.c2});
-        return Core::Hand{{combo.c1, combo.c2}};
-    }
-    
-    Core::Board completeBoard(const std::vector<Core::Card>& curr_board, int total_cards_on_board,
-                                            Core::Deck& deck) 
-    {
-        Core::Board sim_board{curr_board};
-        auto remaining = total_cards_on_board - curr_board.size();
-        auto drawn = deck.draw(remaining);
-        sim_board.add(std::move(drawn));
-        return sim_board;
-    }
-
-    std::vector<Core::Card> combineCards(const std::vector<Core::Card>& lhs, const std::vector <Core::Card>& rhs) {
-        std::vector<Core::Card> comb = lhs;
-        comb.insert(comb.end(), rhs.begin(), rhs.end());
-        return comb;
-    }
-}
-
-    SimResult MonteCarloNLHStrategy::run (
+    inline SimResult MonteCarloNLHStrategy::run (
         const Core::Range& my_range,
         const Core::Board& community,
         int num_opponents,
@@ -100,78 +61,76 @@ namespace {
             throw std::invalid_argument("Opponent ranges size does not match num_opponents");
 
         SimResult result{};
+        if (mode_ == ResultMode::PerCombo) result.combos.resize(Core::NUM_COMBOS);
         std::mt19937 rng(seed);
-        deck.remove(community.get());
-
-        std::vector<Core::PlayerState> players;
-        Core::PlayerState hero {.id = 0, .stack{Core::Stack{100}}, .holeCards{}, .hasFolded = false, .isAllIn = false, .range{my_range}};
-        players.push_back(std::move(hero));
-        for(int i = 0; i < num_opponents; ++i) {
-            Core::PlayerState p {.id = i + 1, .stack{Core::Stack{100}}, .holeCards{}, .hasFolded = false, .isAllIn = false, .range{opponent_ranges[i]}};
-            players.push_back(std::move(p));
-        }
-
-        Core::GameState base_state {.players{std::move(players)}, .board{community}, .pot{}, .deck = deck};
-
-        for (int i = 0; i < iterations; ++i) {
-            Core::GameState sim_state = base_state; //copy state
-            sim_state.deck.shuffle();
 
-            auto& hero = sim_state.players[0];
-            hero.holeCards = sampleHandFromRange(hero.range,sim_state.deck,rng);
-            for (size_t i = 1; i < sim_state.players.size(); ++i) {
-                sim_state.players[i].range.removeBlocked(hero.holeCards.get());
-            }
+        const Core::CardMask board = Core::cardsMask(community.get());
+        const int missing = detail::MAX_BOARD_SIZE_NLH - static_cast<int>(community.size());
+        const Core::CardMask deck_mask = detail::deck_mask(deck) & ~board;
 
-            for (int i = 0; i < num_opponents; ++i) {
-                int pid = i + 1;
-                auto& r = sim_state.players[pid].range;
+        std::vector<Core::CardMask> deck_cards;
+        deck_cards.reserve(Core::NUM_CARDS);
+        for (Core::CardMask m = deck_mask; m; m &= m - 1) deck_cards.push_back(m & (~m + 1));
+        std::uniform_int_distribution<size_t> pick_card(0, deck_cards.empty() ? 0 : deck_cards.size() - 1);
 
-                auto combo_opt = r.sample(rng);
-                if (!combo_opt) throw std::runtime_error("No available combo for opponent");
-                auto combo = *combo_opt;
-                Core::Hand hand{{combo.c1, combo.c2}};
-                sim_state.players[pid].holeCards = std::move(hand);
+        const detail::ComboSampler hero_sampler{my_range, board};
+        std::vector<detail::ComboSampler> villain_samplers;
+        villain_samplers.reserve(opponent_ranges.size());
+        for (const auto& r : opponent_ranges) villain_samplers.emplace_back(r, board);
+        std::vector<Core::CardMask> villain_hands(opponent_ranges.size());
 
-                sim_state.deck.remove(combo.c1);
-                sim_state.deck.remove(combo.c2);
+        if (hero_sampler.empty())
+            throw std::runtime_error("No available combo for hero");
 
-                // Remove these blockers from future players 
-                for (int j = i + 1; j < num_opponents; ++j) {
-                    int pid = j + 1;
-                    sim_state.players[pid].range.removeBlocked({combo.c1,combo.c2});
-                }
+        for (int i = 0; i < iterations; ++i) {
+            const size_t hero_idx = hero_sampler.sample(rng);
+            const Core::CardMask hero = hero_sampler.mask(hero_idx);
+            Core::CardMask dealt = board | hero;
+
+            // villains are dealt in seat order, each avoiding the cards already dealt
+            for (size_t v = 0; v < villain_samplers.size(); ++v) {
+                const size_t idx = villain_samplers[v].sampleExcluding(rng, dealt);
+                if (idx == detail::ComboSampler::npos)
+                    throw std::runtime_error("No available combo for opponent");
+                villain_hands[v] = villain_samplers[v].mask(idx);
+                dealt |= villain_hands[v];
             }
 
-            sim_state.board = completeBoard(sim_state.board.get(), MAX_BOARD_SIZE_NLH, sim_state.deck);
-
-            std::vector<Evaluator::HandRank> ranks;
-            for(auto& p : sim_state.players) {
-                auto hand = p.holeCards;
-                hand.add(sim_state.board.get());
-                ranks.push_back(eval_.evaluate(hand.get()));
+            if (std::popcount(deck_mask & ~dealt) < missing)
+                throw std::out_of_range("Cannot draw more cards than are in the deck");
+            Core::CardMask full_board = board;
+            for (int c = 0; c < missing; ++c) {
+                Core::CardMask card;
+                do {
+                    card = deck_cards[pick_card(rng)];
+                } while (card & (dealt | full_board));
+                full_board |= card;
             }
-            
-            auto hero_rank = ranks[0];
-
-            // Determine best score & update results
-            auto best_score = hero_rank.score;
-            for (auto it = ranks.begin() + 1; it != ranks.end(); ++it) {
-                auto r = *it;
-                if (r.score > best_score) best_score = r.score;
+
+            const auto hero_score = eval_.score(full_board | hero);
+            uint64_t best_villain = 0;
+            for (auto v : villain_hands) {
+                best_villain = std::max(best_villain, eval_.score(full_board | v));
             }
 
-            if (hero_rank.score == best_score &&
-                std::count_if(ranks.begin() + 1, ranks.end(),
-                            [&](auto& r){ return r.score == best_score; }) == 0) {
-                result.win += 1.0;
-            } else if (hero_rank.score == best_score) {
-                result.tie += 1.0;
+            ComboTally outcome{};
+            if (hero_score > best_villain) {
+                outcome.win = 1.0;
+            } else if (hero_score == best_villain) {
+                outcome.tie = 1.0;
             } else {
-                result.loss += 1.0;
+                outcome.loss = 1.0;
+            }
+
+            result.win += outcome.win;
+            result.tie += outcome.tie;
+            result.loss += outcome.loss;
+            if (!result.combos.empty()) {
+                result.combos[hero_sampler.id(hero_idx)] += outcome;
             }
         }
 
+        result.trials = static_cast<size_t>(iterations);
         result.normalise();
         return result;
     }
@@ -0,0 +1,87 @@
+#ifndef POKER_ENGINE_SIMULATOR_PARALLEL_STRATEGY_HPP
+#define POKER_ENGINE_SIMULATOR_PARALLEL_STRATEGY_HPP
+
+#include <vector>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <exception>
+
+#include "PokerEngine/simulator/poker_simulator.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Splits the iterations of a sampling strategy across threads and merges the partial results,
+ * including any per-combo tallies. Each thread runs with its own seed derived from the given one.
+ */
+template<PokerSimStrategy Strategy>
+class ParallelStrategy {
+public:
+    explicit ParallelStrategy(Strategy strategy = {}, unsigned num_threads = std::thread::hardware_concurrency())
+        : strategy_(std::move(strategy)), num_threads_(std::max(1u, num_threads)) {}
+
+    SimResult run(
+        const Core::Range& my_range,
+        const Core::Board& community,
+        int num_opponents,
+        Core::Deck deck,
+        const std::vector<Core::Range>& opponent_ranges,
+        int iterations,
+        unsigned seed = std::random_device{}()
+    ) const;
+
+    unsigned threads() const noexcept { return num_threads_; }
+    ResultMode mode() const noexcept requires requires(const Strategy& s) { s.mode(); } { return strategy_.mode(); }
+
+private:
+    Strategy strategy_;
+    unsigned num_threads_;
+};
+
+template<PokerSimStrategy Strategy>
+SimResult ParallelStrategy<Strategy>::run(
+    const Core::Range& my_range,
+    const Core::Board& community,
+    int num_opponents,
+    Core::Deck deck,
+    const std::vector<Core::Range>& opponent_ranges,
+    int iterations,
+    unsigned seed
+) const
+{
+    const int workers = static_cast<int>(std::min<long long>(num_threads_, std::max(iterations, 1)));
+    std::vector<SimResult> partial(workers);
+    std::vector<std::exception_ptr> errors(workers);
+
+    std::seed_seq seq{seed};
+    std::vector<unsigned> seeds(workers);
+    seq.generate(seeds.begin(), seeds.end());
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(workers);
+        for (int w = 0; w < workers; ++w) {
+            const int share = iterations / workers + (w < iterations % workers ? 1 : 0);
+            threads.emplace_back([&, w, share] {
+                try {
+                    partial[w] = strategy_.run(my_range, community, num_opponents, deck, opponent_ranges, share, seeds[w]);
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+    }
+
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    SimResult result = std::move(partial[0]);
+    for (int w = 1; w < workers; ++w) result.merge(partial[w]);
+    return result;
+}
+
+}
+
+#endif
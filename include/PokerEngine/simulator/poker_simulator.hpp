@@ -2,6 +2,7 @@
 #define POKER_ENGINE_SIMULATOR_POKER_SIMULATOR_HPP
 
 #include <vector>
+#include <memory>
 #include <iostream>
 
 #include "PokerEngine/core/deck.hpp"
@@ -10,6 +11,8 @@
 #include "PokerEngine/core/board.hpp"
 #include "PokerEngine/evaluator/hand_evaluator.hpp"
 #include "PokerEngine/simulator/monte_carlo_strategy.hpp"
+#include "PokerEngine/simulator/preflop_table.hpp"
+#include "PokerEngine/simulator/equity_cache.hpp"
 
 namespace PokerEngine::Simulator {
 
@@ -33,20 +36,53 @@ public:
         : my_range_(std::move(my_range)), community_cards_(std::move(board)),
           num_opponents_(num_opponents), deck_(std::move(deck)) {}
 
+    /**
+     * @brief Heads up queries on an empty board with a full deck are answered exactly from the table
+     * instead of running the strategy
+     */
+    void usePreflopTable(std::shared_ptr<const PreflopEquityTable> table) { preflop_table_ = std::move(table); }
+
     template<typename SimStrategy>
     SimResult simulate(const SimStrategy& strategy,
                             const std::vector<Core::Range>& opponent_ranges,
                             int iterations,
                             unsigned seed = std::random_device{}()) const
     {
+        if (preflop_table_ && community_cards_.size() == 0 && num_opponents_ == 1 &&
+            opponent_ranges.size() == 1 && deck_.size() == Core::NUM_CARDS)
+        {
+            ResultMode mode = ResultMode::Aggregate;
+            if constexpr (requires { strategy.mode(); }) mode = strategy.mode();
+            return preflop_table_->rangeEquity(my_range_, opponent_ranges[0], mode);
+        }
         return strategy.run(my_range_, community_cards_, num_opponents_, deck_, opponent_ranges, iterations, seed);
     }
 
+    /**
+     * @brief As simulate, but answered from cache when a suit isomorphic query with the same
+     * iteration count, strategy and preflop table setting has already been run. On a hit the seed is ignored.
+     */
+    template<typename SimStrategy>
+    SimResult simulate(EquityCache& cache,
+                       const SimStrategy& strategy,
+                       const std::vector<Core::Range>& opponent_ranges,
+                       int iterations,
+                       unsigned seed = std::random_device{}()) const
+    {
+        ResultMode mode = ResultMode::Aggregate;
+        if constexpr (requires { strategy.mode(); }) mode = strategy.mode();
+        // the low bit says whether a preflop table may have answered instead of the strategy
+        const uint64_t tag = strategyCacheTag(strategy) << 1 | (preflop_table_ ? 1 : 0);
+        const EquityKey key = makeEquityKey(my_range_, community_cards_, deck_, opponent_ranges, iterations, mode, tag);
+        return cache.getOrCompute(key, [&] { return simulate(strategy, opponent_ranges, iterations, seed); });
+    }
+
 private:
     Core::Range my_range_;
     Core::Board community_cards_;
     int num_opponents_;
     Core::Deck deck_;
+    std::shared_ptr<const PreflopEquityTable> preflop_table_;
 };
 }
 
@@ -0,0 +1,273 @@
+#ifndef POKER_ENGINE_SIMULATOR_PREFLOP_TABLE_HPP
+#define POKER_ENGINE_SIMULATOR_PREFLOP_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/range_notation.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+namespace PokerEngine::Simulator {
+
+constexpr int NUM_HAND_CLASSES = 169;
+
+/**
+ * @brief Index of the starting hand class in a 13x13 grid of rank indices (0 = deuce):
+ * pairs on the diagonal, suited hands at (high, low) and offsuit hands at (low, high)
+ */
+constexpr inline int handClassIndex(int card_a, int card_b) noexcept {
+    const int ra = card_a % 13, rb = card_b % 13;
+    const int high = std::max(ra, rb), low = std::min(ra, rb);
+    const bool suited = card_a / 13 == card_b / 13;
+    return suited ? high * 13 + low : low * 13 + high;
+}
+
+/**
+ * @brief Class of a single (non plus) token, tokens without a suited/offsuit marker map to offsuit
+ */
+constexpr inline int handClassIndex(const Core::RangeToken& token) noexcept {
+    const int high = std::max(static_cast<int>(token.rank1), static_cast<int>(token.rank2)) - 2;
+    const int low = std::min(static_cast<int>(token.rank1), static_cast<int>(token.rank2)) - 2;
+    return token.type == Core::RangeToken::Type::Suited ? high * 13 + low : low * 13 + high;
+}
+
+/**
+ * @brief Exact heads up preflop all-in equities for every pair of combos and every pair of starting
+ * hand classes, read from a memory mapped file written by generatePreflopTable.
+ *
+ * File layout (native endian): PreflopTableHeader, then class win and tie matrices
+ * (NUM_HAND_CLASSES^2 floats each), then combo win and tie matrices (NUM_COMBOS^2 floats each),
+ * all row major with hero as the row. Conflicting combo pairs hold zero.
+ */
+class PreflopEquityTable {
+public:
+    struct PreflopTableHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t num_classes;
+        uint32_t num_combos;
+    };
+
+    static constexpr std::array<char, 4> MAGIC{'P', 'E', 'P', 'F'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t CLASS_CELLS = NUM_HAND_CLASSES * NUM_HAND_CLASSES;
+    static constexpr size_t COMBO_CELLS = static_cast<size_t>(Core::NUM_COMBOS) * Core::NUM_COMBOS;
+    static constexpr size_t FILE_SIZE = sizeof(PreflopTableHeader) + 2 * (CLASS_CELLS + COMBO_CELLS) * sizeof(float);
+
+    explicit PreflopEquityTable(const std::string& path);
+
+    SimResult comboEquity(int hero_combo, int villain_combo) const noexcept {
+        const size_t cell = static_cast<size_t>(hero_combo) * Core::NUM_COMBOS + villain_combo;
+        return makeResult(combo_win_[cell], combo_tie_[cell]);
+    }
+
+    SimResult classEquity(int hero_class, int villain_class) const noexcept {
+        const size_t cell = static_cast<size_t>(hero_class) * NUM_HAND_CLASSES + villain_class;
+        return makeResult(class_win_[cell], class_tie_[cell]);
+    }
+
+    /**
+     * @brief Weighted exact equity of two ranges, the same figure ExactNLHStrategy gives on an empty board
+     */
+    SimResult rangeEquity(const Core::Range& hero, const Core::Range& villain,
+                          ResultMode mode = ResultMode::Aggregate) const;
+
+    /**
+     * @brief Write a table file from full combo matrices, class matrices are derived from them
+     */
+    static void write(const std::string& path, std::span<const float> combo_win, std::span<const float> combo_tie);
+
+private:
+    static SimResult makeResult(float win, float tie) noexcept {
+        SimResult r{};
+        r.win = win;
+        r.tie = tie;
+        r.loss = 1.0 - r.win - r.tie;
+        r.trials = 1;
+        return r;
+    }
+
+    Core::detail::MappedFile file_;
+    const float* class_win_ = nullptr;
+    const float* class_tie_ = nullptr;
+    const float* combo_win_ = nullptr;
+    const float* combo_tie_ = nullptr;
+};
+
+inline PreflopEquityTable::PreflopEquityTable(const std::string& path) : file_(path) {
+    if (file_.size() != FILE_SIZE)
+        throw std::runtime_error("Preflop table has unexpected size: " + path);
+
+    PreflopTableHeader header{};
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC.data(), MAGIC.size()) != 0 || header.version != VERSION ||
+        header.num_classes != NUM_HAND_CLASSES || header.num_combos != static_cast<uint32_t>(Core::NUM_COMBOS))
+        throw std::runtime_error("Not a compatible preflop table: " + path);
+
+    const float* cells = reinterpret_cast<const float*>(file_.data() + sizeof(PreflopTableHeader));
+    class_win_ = cells;
+    class_tie_ = class_win_ + CLASS_CELLS;
+    combo_win_ = class_tie_ + CLASS_CELLS;
+    combo_tie_ = combo_win_ + COMBO_CELLS;
+}
+
+inline SimResult PreflopEquityTable::rangeEquity(const Core::Range& hero, const Core::Range& villain, ResultMode mode) const {
+    SimResult result{};
+    if (mode == ResultMode::PerCombo) result.combos.resize(Core::NUM_COMBOS);
+    double total_weight = 0.0;
+
+    for (const auto& h : hero.combos()) {
+        if (h.weight <= 0.0) continue;
+        const Core::CardMask hero_mask = Core::comboMask(h);
+        const int hero_id = Core::comboIndex(h);
+        const size_t row = static_cast<size_t>(hero_id) * Core::NUM_COMBOS;
+
+        for (const auto& v : villain.combos()) {
+            if (Core::comboMask(v) & hero_mask || v.weight <= 0.0) continue;
+            const double weight = h.weight * v.weight;
+            const size_t cell = row + Core::comboIndex(v);
+            const double win = combo_win_[cell], tie = combo_tie_[cell];
+            result.win += weight * win;
+            result.tie += weight * tie;
+            result.loss += weight * (1.0 - win - tie);
+            total_weight += weight;
+            ++result.trials;
+            if (!result.combos.empty())
+                result.combos[hero_id] += ComboTally{weight * win, weight * tie, weight * (1.0 - win - tie)};
+        }
+    }
+
+    if (total_weight == 0.0)
+        throw std::runtime_error("No non-conflicting combos between ranges");
+
+    result.normalise();
+    return result;
+}
+
+inline void PreflopEquityTable::write(const std::string& path, std::span<const float> combo_win, std::span<const float> combo_tie) {
+    if (combo_win.size() != COMBO_CELLS || combo_tie.size() != COMBO_CELLS)
+        throw std::invalid_argument("Combo matrices must be NUM_COMBOS x NUM_COMBOS");
+
+    std::vector<double> class_win(CLASS_CELLS, 0.0), class_tie(CLASS_CELLS, 0.0), class_pairs(CLASS_CELLS, 0.0);
+    for (int h = 0; h < Core::NUM_COMBOS; ++h) {
+        const auto [h1, h2] = Core::comboCardsFromIndex(h);
+        const Core::CardMask hero_mask = (Core::CardMask{1} << h1) | (Core::CardMask{1} << h2);
+        const size_t hero_class = handClassIndex(h1, h2);
+
+        for (int v = 0; v < Core::NUM_COMBOS; ++v) {
+            const auto [v1, v2] = Core::comboCardsFromIndex(v);
+            if (hero_mask & ((Core::CardMask{1} << v1) | (Core::CardMask{1} << v2))) continue;
+            const size_t cls = hero_class * NUM_HAND_CLASSES + handClassIndex(v1, v2);
+            const size_t cell = static_cast<size_t>(h) * Core::NUM_COMBOS + v;
+            class_win[cls] += combo_win[cell];
+            class_tie[cls] += combo_tie[cell];
+            class_pairs[cls] += 1.0;
+        }
+    }
+
+    std::vector<float> class_cells(2 * CLASS_CELLS, 0.0f);
+    for (size_t c = 0; c < CLASS_CELLS; ++c) {
+        if (class_pairs[c] == 0.0) continue;
+        class_cells[c] = static_cast<float>(class_win[c] / class_pairs[c]);
+        class_cells[CLASS_CELLS + c] = static_cast<float>(class_tie[c] / class_pairs[c]);
+    }
+
+    PreflopTableHeader header{};
+    std::memcpy(header.magic, MAGIC.data(), MAGIC.size());
+    header.version = VERSION;
+    header.num_classes = NUM_HAND_CLASSES;
+    header.num_combos = Core::NUM_COMBOS;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot open file for writing: " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(class_cells.data()), class_cells.size() * sizeof(float));
+    out.write(reinterpret_cast<const char*>(combo_win.data()), combo_win.size() * sizeof(float));
+    out.write(reinterpret_cast<const char*>(combo_tie.data()), combo_tie.size() * sizeof(float));
+    if (!out) throw std::runtime_error("Failed writing preflop table: " + path);
+}
+
+/**
+ * @brief Compute every heads up preflop combo-vs-combo equity by exact enumeration and write the table.
+ * Only one combo pair per suit isomorphism class is enumerated, the work is spread over num_threads.
+ * This is an offline job, expect hours of CPU time.
+ * @param progress Optional callback (classes done, classes total), called from worker threads
+ */
+inline void generatePreflopTable(const std::string& path,
+                                 unsigned num_threads = std::thread::hardware_concurrency(),
+                                 std::function<void(size_t, size_t)> progress = {})
+{
+    using Core::CardMask;
+    using PairKey = std::array<CardMask, 2>;
+    struct PairKeyHash {
+        size_t operator()(const PairKey& k) const noexcept {
+            return std::hash<CardMask>{}(k[0] * 0x9e3779b97f4a7c15ULL ^ k[1]);
+        }
+    };
+
+    auto combo_mask = [](int id) {
+        const auto [a, b] = Core::comboCardsFromIndex(id);
+        return (CardMask{1} << a) | (CardMask{1} << b);
+    };
+
+    // map every combo pair onto its suit isomorphism class
+    std::unordered_map<PairKey, int32_t, PairKeyHash> class_of;
+    std::vector<PairKey> classes;
+    std::vector<int32_t> cell_class(PreflopEquityTable::COMBO_CELLS, -1);
+    for (int h = 0; h < Core::NUM_COMBOS; ++h) {
+        for (int v = 0; v < Core::NUM_COMBOS; ++v) {
+            if (combo_mask(h) & combo_mask(v)) continue;
+            const PairKey key = Core::canonicalise(PairKey{combo_mask(h), combo_mask(v)});
+            auto [it, inserted] = class_of.try_emplace(key, static_cast<int32_t>(classes.size()));
+            if (inserted) classes.push_back(key);
+            cell_class[static_cast<size_t>(h) * Core::NUM_COMBOS + v] = it->second;
+        }
+    }
+
+    std::vector<float> class_win(classes.size()), class_tie(classes.size());
+    std::atomic<size_t> next{0}, done{0};
+    const CardMask full_deck = (CardMask{1} << Core::NUM_CARDS) - 1;
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned t = 0; t < std::max(1u, num_threads); ++t) {
+            workers.emplace_back([&] {
+                // Each class is computed once, so a memo would only fill without ever hitting
+                ExactNLHStrategy strategy{ResultMode::Aggregate, 0};
+                for (size_t c = next++; c < classes.size(); c = next++) {
+                    const SimResult r = strategy.pairEquity(0, classes[c][0], classes[c][1], full_deck);
+                    class_win[c] = static_cast<float>(r.win);
+                    class_tie[c] = static_cast<float>(r.tie);
+                    const size_t finished = ++done;
+                    if (progress) progress(finished, classes.size());
+                }
+            });
+        }
+    }
+
+    std::vector<float> combo_win(PreflopEquityTable::COMBO_CELLS, 0.0f), combo_tie(PreflopEquityTable::COMBO_CELLS, 0.0f);
+    for (size_t cell = 0; cell < cell_class.size(); ++cell) {
+        if (cell_class[cell] < 0) continue;
+        combo_win[cell] = class_win[cell_class[cell]];
+        combo_tie[cell] = class_tie[cell_class[cell]];
+    }
+
+    PreflopEquityTable::write(path, combo_win, combo_tie);
+}
+
+}
+
+#endif
@@ -0,0 +1,461 @@
+#ifndef POKER_ENGINE_SIMULATOR_QUERY_LINES_HPP
+#define POKER_ENGINE_SIMULATOR_QUERY_LINES_HPP
+
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief One equity query of a JSON lines batch, e.g.
+ * {"id": 7, "hero": "AsAd", "villain_range": "KK+,AKs", "board": "2h3cTs", "iterations": 50000}
+ */
+struct EquityQuery {
+    // Raw JSON of the id field, echoed back as is, empty if the query has none
+    std::string id;
+    // A single hand, or else a range
+    std::string hero;
+    std::string hero_range;
+    std::string villain;
+    std::string villain_range;
+    std::string board;
+    int iterations = 10000;
+    // Target standard error of hero's equity, overrides iterations when positive
+    double accuracy = 0.0;
+
+    /**
+     * @brief Iterations to run, enough for the accuracy at the worst case variance of 1/4 if one is set.
+     * At least 1 and at most 1e9.
+     */
+    int trials() const {
+        if (!(accuracy > 0.0) || !std::isfinite(accuracy)) return std::max(iterations, 1);
+        return static_cast<int>(std::clamp(std::ceil(0.25 / (accuracy * accuracy)), 1.0, 1e9));
+    }
+};
+
+namespace detail {
+
+    /**
+     * @brief Reader of one flat JSON object: string, number, boolean and null values only
+     */
+    class JsonObjectReader {
+    public:
+        explicit JsonObjectReader(std::string_view text) : text_(text) {}
+
+        template<typename OnField>
+        void read(OnField&& onField) {
+            skipSpace();
+            expect('{');
+            skipSpace();
+            if (peek() == '}') {
+                ++pos_;
+            } else {
+                while (true) {
+                    skipSpace();
+                    const std::string key = string();
+                    skipSpace();
+                    expect(':');
+                    skipSpace();
+                    const size_t start = pos_;
+                    skipValue();
+                    onField(key, text_.substr(start, pos_ - start));
+                    skipSpace();
+                    if (peek() == ',') {
+                        ++pos_;
+                        continue;
+                    }
+                    expect('}');
+                    break;
+                }
+            }
+            skipSpace();
+            if (pos_ != text_.size()) fail("Trailing characters after the object");
+        }
+
+        /**
+         * @brief Unescaped contents of a raw JSON string value
+         */
+        static std::string unquote(std::string_view raw) {
+            JsonObjectReader reader(raw);
+            std::string s = reader.string();
+            if (reader.pos_ != raw.size()) fail("Expected a string");
+            return s;
+        }
+
+    private:
+        [[noreturn]] static void fail(const char* what) { throw std::invalid_argument(what); }
+
+        char peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+        void expect(char c) {
+            if (peek() != c) fail("Malformed JSON object");
+            ++pos_;
+        }
+
+        void skipSpace() {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\r' || text_[pos_] == '\n')) ++pos_;
+        }
+
+        void skipValue() {
+            const char c = peek();
+            if (c == '"') {
+                string();
+            } else if (c == '{' || c == '[') {
+                fail("Nested values are not supported");
+            } else {
+                const size_t start = pos_;
+                while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ' ' && text_[pos_] != '\t') ++pos_;
+                if (pos_ == start) fail("Missing value");
+            }
+        }
+
+        std::string string() {
+            expect('"');
+            std::string s;
+            while (true) {
+                if (pos_ >= text_.size()) fail("Unterminated string");
+                const char c = text_[pos_++];
+                if (c == '"') return s;
+                if (c != '\\') {
+                    s += c;
+                    continue;
+                }
+                if (pos_ >= text_.size()) fail("Unterminated string");
+                switch (const char e = text_[pos_++]) {
+                case 'n': s += '\n'; break;
+                case 't': s += '\t'; break;
+                case 'r': s += '\r'; break;
+                case 'b': s += '\b'; break;
+                case 'f': s += '\f'; break;
+                case 'u': {
+                    unsigned code = 0;
+                    if (pos_ + 4 > text_.size() ||
+                        std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, code, 16).ptr != text_.data() + pos_ + 4)
+                        fail("Bad unicode escape");
+                    pos_ += 4;
+                    // card and range notation is ASCII, anything wider is kept as UTF-8 for error messages
+                    if (code < 0x80) {
+                        s += static_cast<char>(code);
+                    } else if (code < 0x800) {
+                        s += static_cast<char>(0xC0 | code >> 6);
+                        s += static_cast<char>(0x80 | (code & 0x3F));
+                    } else {
+                        s += static_cast<char>(0xE0 | code >> 12);
+                        s += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+                        s += static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default: s += e; break;
+                }
+            }
+        }
+
+        std::string_view text_;
+        size_t pos_ = 0;
+    };
+
+    /**
+     * @brief Whether raw follows the JSON number grammar: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+     */
+    inline bool isJsonNumber(std::string_view raw) {
+        size_t i = 0;
+        auto digits = [&] {
+            const size_t start = i;
+            while (i < raw.size() && raw[i] >= '0' && raw[i] <= '9') ++i;
+            return i - start;
+        };
+        if (i < raw.size() && raw[i] == '-') ++i;
+        if (i < raw.size() && raw[i] == '0') {
+            ++i;
+        } else if (digits() == 0) {
+            return false;
+        }
+        if (i < raw.size() && raw[i] == '.') {
+            ++i;
+            if (digits() == 0) return false;
+        }
+        if (i < raw.size() && (raw[i] == 'e' || raw[i] == 'E')) {
+            ++i;
+            if (i < raw.size() && (raw[i] == '+' || raw[i] == '-')) ++i;
+            if (digits() == 0) return false;
+        }
+        return i == raw.size();
+    }
+
+    template<typename T>
+    T parseNumber(std::string_view raw, const char* field) {
+        T value{};
+        const auto [end, ec] = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+        if (ec != std::errc{} || end != raw.data() + raw.size())
+            throw std::invalid_argument(std::string("Field ") + field + " must be a number");
+        return value;
+    }
+
+    inline void appendJsonString(std::string& out, std::string_view s) {
+        out += '"';
+        for (const char c : s) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            case '\r': out += "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr char HEX[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out += HEX[c >> 4];
+                    out += HEX[c & 0xF];
+                } else {
+                    out += c;
+                }
+            }
+        }
+        out += '"';
+    }
+
+    inline void appendJsonNumber(std::string& out, double value) {
+        char buffer[32];
+        const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6).ptr;
+        out.append(buffer, end);
+    }
+
+    inline void appendId(std::string& out, std::string_view id) {
+        if (id.empty()) return;
+        out += "\"id\":";
+        out += id;
+        out += ',';
+    }
+}
+
+/**
+ * @brief Parse one query line. Unknown fields are ignored, string fields may be null.
+ * @throws std::invalid_argument if the line is not a flat JSON object or a field has the wrong type
+ */
+inline EquityQuery parseEquityQuery(std::string_view line) {
+    EquityQuery query{};
+    detail::JsonObjectReader(line).read([&](const std::string& key, std::string_view raw) {
+        auto text = [&](std::string& field) {
+            if (raw == "null") return;
+            if (raw.empty() || raw.front() != '"') throw std::invalid_argument("Field " + key + " must be a string");
+            field = detail::JsonObjectReader::unquote(raw);
+        };
+        if (key == "id") {
+            // echoed back verbatim, so it has to be a JSON value on its own
+            if (raw.starts_with('"')) detail::JsonObjectReader::unquote(raw);
+            else if (raw != "true" && raw != "false" && raw != "null" && !detail::isJsonNumber(raw))
+                throw std::invalid_argument("Field id must be a string, number, boolean or null");
+            query.id = raw;
+        }
+        else if (key == "hero") text(query.hero);
+        else if (key == "hero_range") text(query.hero_range);
+        else if (key == "villain") text(query.villain);
+        else if (key == "villain_range") text(query.villain_range);
+        else if (key == "board") text(query.board);
+        else if (key == "iterations") query.iterations = detail::parseNumber<int>(raw, "iterations");
+        else if (key == "accuracy") query.accuracy = detail::parseNumber<double>(raw, "accuracy");
+    });
+    // from_chars reads nan and inf, which JSON does not have
+    if (!std::isfinite(query.accuracy)) throw std::invalid_argument("Accuracy must be a finite number");
+    if (query.iterations <= 0 && query.accuracy <= 0.0) throw std::invalid_argument("Iterations must be positive");
+    return query;
+}
+
+/**
+ * @return {"id":...,"win":...,"tie":...,"loss":...,"equity":...,"iterations":...} with the id left out if
+ * the query had none
+ */
+inline std::string formatEquityResult(const EquityQuery& query, const SimResult& result, int iterations) {
+    std::string out = "{";
+    detail::appendId(out, query.id);
+    out += "\"win\":";
+    detail::appendJsonNumber(out, result.win);
+    out += ",\"tie\":";
+    detail::appendJsonNumber(out, result.tie);
+    out += ",\"loss\":";
+    detail::appendJsonNumber(out, result.loss);
+    out += ",\"equity\":";
+    detail::appendJsonNumber(out, result.win + result.tie / 2.0);
+    out += ",\"iterations\":";
+    out += std::to_string(iterations);
+    out += '}';
+    return out;
+}
+
+/**
+ * @return {"id":...,"error":"..."}
+ */
+inline std::string formatEquityError(std::string_view id, std::string_view message) {
+    std::string out = "{";
+    detail::appendId(out, id);
+    out += "\"error\":";
+    detail::appendJsonString(out, message);
+    out += '}';
+    return out;
+}
+
+/**
+ * @brief Parsed ranges by their text, for a batch worker answering many queries over the same ranges.
+ * Holds at most capacity ranges and drops them all when full, which suits batches that reuse a few
+ * ranges heavily. Ranges are handed out shared, so one in use stays valid after the cache drops it.
+ */
+class RangeCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit RangeCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+    /**
+     * @param parse Core::Range(), called on a miss
+     */
+    template<typename Parse>
+    std::shared_ptr<const Core::Range> get(const std::string& key, Parse&& parse) {
+        if (auto it = ranges_.find(key); it != ranges_.end()) return it->second;
+        auto range = std::make_shared<const Core::Range>(parse());
+        if (ranges_.size() >= capacity_) ranges_.clear();
+        if (capacity_ > 0) ranges_.emplace(key, range);
+        return range;
+    }
+
+    size_t size() const noexcept { return ranges_.size(); }
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    size_t capacity_;
+    std::unordered_map<std::string, std::shared_ptr<const Core::Range>> ranges_;
+};
+
+/**
+ * @brief Answer every non blank line of in on a pool of threads, writing the answers to out in input
+ * order, one per line.
+ *
+ * At most max_in_flight lines are read ahead of the last one written, so memory stays bounded however
+ * long the input and however slow a single line is. Output is flushed whenever the next answer is not
+ * ready yet, so a consumer sees results as they come.
+ *
+ * @param answer std::string(std::string_view line), called concurrently
+ * @return Lines answered
+ * @throws Whatever answer throws, after the lines before it have been written
+ */
+template<typename Answer>
+size_t answerLinesInOrder(std::istream& in, std::ostream& out, Answer&& answer,
+                          unsigned threads = std::thread::hardware_concurrency(), size_t max_in_flight = 1024)
+{
+    const size_t capacity = std::max<size_t>(1, max_in_flight);
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::pair<uint64_t, std::string>> queue;
+    std::vector<std::optional<std::string>> done(capacity);
+    uint64_t read = 0;
+    uint64_t written = 0;
+    bool eof = false;
+    std::exception_ptr error;
+    // sequence number of the earliest failed line, the lines before it are still answered and written
+    uint64_t failed = std::numeric_limits<uint64_t>::max();
+
+    auto work = [&] {
+        std::unique_lock lock(mutex);
+        while (true) {
+            changed.wait(lock, [&] { return !queue.empty() || eof || error; });
+            // lines are queued in order, so once the front is past the failed line all of them are
+            if (queue.empty() || queue.front().first >= failed) return;
+            auto [seq, line] = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+
+            std::string result;
+            std::exception_ptr failure;
+            try {
+                result = answer(std::string_view(line));
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            lock.lock();
+            if (failure) {
+                if (seq < failed) {
+                    error = failure;
+                    failed = seq;
+                }
+            } else {
+                done[seq % capacity] = std::move(result);
+            }
+            changed.notify_all();
+        }
+    };
+
+    auto write = [&] {
+        std::unique_lock lock(mutex);
+        while (true) {
+            changed.wait(lock, [&] {
+                return written >= failed || done[written % capacity] || (eof && written == read);
+            });
+            // answers before the failed line are still written, waiting for them if needed
+            if (written >= failed || !done[written % capacity]) return;
+            std::string line = std::move(*done[written % capacity]);
+            done[written % capacity].reset();
+            ++written;
+            const bool more_ready = done[written % capacity].has_value();
+            changed.notify_all();
+
+            lock.unlock();
+            out << line << '\n';
+            if (!more_ready) out.flush();
+            lock.lock();
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        const unsigned workers = std::max(1u, threads);
+        pool.reserve(workers + 1);
+        pool.emplace_back(write);
+        for (unsigned w = 0; w < workers; ++w) pool.emplace_back(work);
+
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.find_first_not_of(" \t") == std::string::npos) continue;
+
+            std::unique_lock lock(mutex);
+            changed.wait(lock, [&] { return error || read - written < capacity; });
+            if (error) break;
+            queue.emplace_back(read++, std::move(line));
+            changed.notify_all();
+        }
+        {
+            std::lock_guard lock(mutex);
+            eof = true;
+        }
+        changed.notify_all();
+    }
+
+    out.flush();
+    if (error) std::rethrow_exception(error);
+    return static_cast<size_t>(written);
+}
+
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef POKER_ENGINE_SIMULATOR_RIVER_SWEEP_HPP
+#define POKER_ENGINE_SIMULATOR_RIVER_SWEEP_HPP
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Showdown of one set of hands against another on a complete board, without comparing pairs.
+ *
+ * Both sides are scored and sorted once on construction. showdown() then walks the two sorted lists
+ * together, keeping a running total of the opposing weight below the current score and the same
+ * total per card. Opposing hands sharing a card with the hand being evaluated are removed from those
+ * totals by inclusion-exclusion: subtract the totals of its two cards, add back the identical combo,
+ * which was subtracted twice. Each call is O(n + m) for n own and m opposing hands.
+ */
+class RiverSweep {
+public:
+    /**
+     * @param opponent_hands Two card masks, each combo at most once
+     * @throws std::invalid_argument if the board is not complete or an opponent combo repeats
+     */
+    RiverSweep(std::span<const Core::CardMask> hands, std::span<const Core::CardMask> opponent_hands,
+               Core::CardMask board);
+
+    /**
+     * @brief Opposing weight each hand beats, ties with and could face (sharing no card with it or the board).
+     * Outputs are indexed like the hands given on construction, hands touching the board get zeros.
+     * @param opponent_weights Indexed like the opponent hands given on construction
+     */
+    void showdown(std::span<const double> opponent_weights,
+                  std::span<double> beats, std::span<double> ties, std::span<double> live) const;
+
+    size_t size() const noexcept { return num_hands_; }
+    size_t opponentSize() const noexcept { return num_opponent_hands_; }
+
+private:
+    struct Entry {
+        uint64_t score;
+        uint8_t low;
+        uint8_t high;
+        uint32_t index; // position in the constructor's span
+    };
+
+    static std::vector<Entry> scoreAndSort(std::span<const Core::CardMask> hands, Core::CardMask board);
+
+    std::vector<Entry> hands_;
+    std::vector<Entry> opponents_;
+    std::vector<int32_t> same_combo_; // per own hand, opponent index of the identical combo or -1
+    size_t num_hands_;
+    size_t num_opponent_hands_;
+};
+
+inline std::vector<RiverSweep::Entry> RiverSweep::scoreAndSort(std::span<const Core::CardMask> hands, Core::CardMask board) {
+    const Evaluator::HandEvaluator eval{};
+    std::vector<Entry> entries;
+    entries.reserve(hands.size());
+    for (size_t i = 0; i < hands.size(); ++i) {
+        const Core::CardMask hand = hands[i];
+        if (hand & board) continue;
+        entries.push_back({eval.score(board | hand), static_cast<uint8_t>(std::countr_zero(hand)),
+                           static_cast<uint8_t>(63 - std::countl_zero(hand)), static_cast<uint32_t>(i)});
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.score < b.score; });
+    return entries;
+}
+
+inline RiverSweep::RiverSweep(std::span<const Core::CardMask> hands, std::span<const Core::CardMask> opponent_hands,
+                              Core::CardMask board)
+    : num_hands_(hands.size()), num_opponent_hands_(opponent_hands.size())
+{
+    if (std::popcount(board) != detail::MAX_BOARD_SIZE_NLH)
+        throw std::invalid_argument("River sweep needs a complete board");
+
+    hands_ = scoreAndSort(hands, board);
+    opponents_ = scoreAndSort(opponent_hands, board);
+
+    std::array<int32_t, Core::NUM_COMBOS> opponent_of_combo{};
+    opponent_of_combo.fill(-1);
+    for (const auto& o : opponents_) {
+        // the identical combo correction adds back a single opposing weight
+        int32_t& slot = opponent_of_combo[Core::comboIndex(o.low, o.high)];
+        if (slot >= 0) throw std::invalid_argument("Opponent hands repeat a combo");
+        slot = static_cast<int32_t>(o.index);
+    }
+    same_combo_.assign(hands.size(), -1);
+    for (const auto& h : hands_) same_combo_[h.index] = opponent_of_combo[Core::comboIndex(h.low, h.high)];
+}
+
+inline void RiverSweep::showdown(std::span<const double> opponent_weights,
+                                 std::span<double> beats, std::span<double> ties, std::span<double> live) const
+{
+    if (opponent_weights.size() != num_opponent_hands_ || beats.size() != num_hands_ ||
+        ties.size() != num_hands_ || live.size() != num_hands_)
+        throw std::invalid_argument("Showdown spans do not match the hands");
+
+    std::fill(beats.begin(), beats.end(), 0.0);
+    std::fill(ties.begin(), ties.end(), 0.0);
+    std::fill(live.begin(), live.end(), 0.0);
+
+    double total = 0.0;
+    std::array<double, Core::NUM_CARDS> card_total{};
+    for (const auto& o : opponents_) {
+        const double w = opponent_weights[o.index];
+        total += w;
+        card_total[o.low] += w;
+        card_total[o.high] += w;
+    }
+
+    double below = 0.0, equal = 0.0;
+    std::array<double, Core::NUM_CARDS> card_below{}, card_equal{};
+    size_t next_opponent = 0;
+
+    for (size_t i = 0; i < hands_.size();) {
+        const uint64_t score = hands_[i].score;
+
+        // opponents below this score join the running totals for good
+        while (next_opponent < opponents_.size() && opponents_[next_opponent].score < score) {
+            const auto& o = opponents_[next_opponent++];
+            const double w = opponent_weights[o.index];
+            below += w;
+            card_below[o.low] += w;
+            card_below[o.high] += w;
+        }
+
+        // opponents on exactly this score only count as ties for this group
+        size_t equal_end = next_opponent;
+        while (equal_end < opponents_.size() && opponents_[equal_end].score == score) {
+            const auto& o = opponents_[equal_end++];
+            const double w = opponent_weights[o.index];
+            equal += w;
+            card_equal[o.low] += w;
+            card_equal[o.high] += w;
+        }
+
+        for (; i < hands_.size() && hands_[i].score == score; ++i) {
+            const auto& h = hands_[i];
+            const int32_t same = same_combo_[h.index];
+            const double same_weight = same >= 0 ? opponent_weights[same] : 0.0;
+            // the identical combo scores the same, so it is never below and always in the equal group
+            beats[h.index] = below - card_below[h.low] - card_below[h.high];
+            ties[h.index] = equal - card_equal[h.low] - card_equal[h.high] + same_weight;
+            live[h.index] = total - card_total[h.low] - card_total[h.high] + same_weight;
+        }
+
+        for (size_t k = next_opponent; k < equal_end; ++k) {
+            card_equal[opponents_[k].low] = 0.0;
+            card_equal[opponents_[k].high] = 0.0;
+        }
+        equal = 0.0;
+    }
+}
+
+/**
+ * @brief Per combo river equity, aligned with Range::combos(). Combos touching the board, or with no
+ * live opposing combo, have equity 0 and live_weight 0.
+ */
+struct RiverEquity {
+    std::vector<double> equity;
+    // Opposing weight behind each equity, i.e. the weight of the opposing combos it can face
+    std::vector<double> live_weight;
+};
+
+struct RiverEquities {
+    RiverEquity hero;
+    RiverEquity villain;
+};
+
+namespace detail {
+    /**
+     * @brief Hands of range not touching the board with positive weight, each combo once, weights
+     * appended to weights in the same order
+     */
+    inline std::vector<Core::CardMask> live_hands(const Core::Range& range, Core::CardMask board,
+                                                  std::vector<double>& weights)
+    {
+        // a combo added twice by overlapping tokens is one hand with the weights summed
+        std::array<int32_t, Core::NUM_COMBOS> index_of{};
+        index_of.fill(-1);
+        std::vector<Core::CardMask> hands;
+        const size_t base = weights.size();
+        for (const auto& combo : range.combos()) {
+            const Core::CardMask mask = Core::comboMask(combo);
+            if (mask & board || combo.weight <= 0.0) continue;
+            int32_t& index = index_of[Core::comboIndex(combo)];
+            if (index >= 0) {
+                weights[base + index] += combo.weight;
+                continue;
+            }
+            index = static_cast<int32_t>(hands.size());
+            hands.push_back(mask);
+            weights.push_back(combo.weight);
+        }
+        return hands;
+    }
+
+    inline RiverEquity sweep_side(const std::vector<Core::CardMask>& hands, const std::vector<Core::CardMask>& opponents,
+                                  const std::vector<double>& opponent_weights, Core::CardMask board)
+    {
+        const RiverSweep sweep{hands, opponents, board};
+        RiverEquity result{};
+        std::vector<double> beats(hands.size()), ties(hands.size());
+        result.live_weight.resize(hands.size());
+        sweep.showdown(opponent_weights, beats, ties, result.live_weight);
+
+        result.equity.resize(hands.size());
+        for (size_t i = 0; i < hands.size(); ++i) {
+            // live weight is a difference of sums, treat rounding residue as no opposition
+            if (result.live_weight[i] <= 1e-12) {
+                result.live_weight[i] = 0.0;
+                continue;
+            }
+            result.equity[i] = (beats[i] + ties[i] / 2.0) / result.live_weight[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Result per distinct combo back to one entry per combo of the range, slots[i] being the
+     * distinct combo of combos()[i]
+     */
+    inline RiverEquity expand_side(const RiverEquity& merged, const std::vector<uint32_t>& slots) {
+        RiverEquity result{};
+        result.equity.reserve(slots.size());
+        result.live_weight.reserve(slots.size());
+        for (const uint32_t slot : slots) {
+            result.equity.push_back(merged.equity[slot]);
+            result.live_weight.push_back(merged.live_weight[slot]);
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Exact equity of every hero combo against the villain range and of every villain combo against
+ * the hero range on a complete board, in O(n log n) via RiverSweep
+ */
+inline RiverEquities riverEquities(const Core::Range& hero, const Core::Range& villain, const Core::Board& board) {
+    const Core::CardMask board_mask = Core::cardsMask(board.get());
+
+    // overlapping tokens can add a combo twice, the sweep sees it once with the weights summed
+    auto flatten = [](const Core::Range& range, std::vector<Core::CardMask>& masks, std::vector<double>& weights,
+                      std::vector<uint32_t>& slots) {
+        std::array<int32_t, Core::NUM_COMBOS> slot_of{};
+        slot_of.fill(-1);
+        for (const auto& combo : range.combos()) {
+            int32_t& slot = slot_of[Core::comboIndex(combo)];
+            if (slot < 0) {
+                slot = static_cast<int32_t>(masks.size());
+                masks.push_back(Core::comboMask(combo));
+                weights.push_back(0.0);
+            }
+            weights[slot] += std::max(combo.weight, 0.0);
+            slots.push_back(static_cast<uint32_t>(slot));
+        }
+    };
+    std::vector<Core::CardMask> hero_masks, villain_masks;
+    std::vector<double> hero_weights, villain_weights;
+    std::vector<uint32_t> hero_slots, villain_slots;
+    flatten(hero, hero_masks, hero_weights, hero_slots);
+    flatten(villain, villain_masks, villain_weights, villain_slots);
+
+    return {detail::expand_side(detail::sweep_side(hero_masks, villain_masks, villain_weights, board_mask), hero_slots),
+            detail::expand_side(detail::sweep_side(villain_masks, hero_masks, hero_weights, board_mask), villain_slots)};
+}
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef POKER_ENGINE_SIMULATOR_RUNOUT_EXPLORER_HPP
+#define POKER_ENGINE_SIMULATOR_RUNOUT_EXPLORER_HPP
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <random>
+#include <stdexcept>
+
+#include "PokerEngine/core/card.hpp"
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/deck.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/simulator/sim_result.hpp"
+#include "PokerEngine/simulator/detail/combo_sampler.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+#include "PokerEngine/simulator/river_sweep.hpp"
+
+namespace PokerEngine::Simulator {
+
+/**
+ * @brief Hero's equity if card is the next one dealt
+ */
+struct NextCardResult {
+    Core::Card card;
+    SimResult result;
+};
+
+/**
+ * @brief Equity after every possible next card (turn from a flop, river from a turn), in one pass.
+ * Each complete board is dealt and scored once and counts towards every next card it contains:
+ * flop + {x, y} is both the runout "turn x, river y" and "turn y, river x".
+ */
+class RunoutExplorer {
+public:
+    RunoutExplorer(Core::Range my_range, Core::Board board, int num_opponents, Core::Deck deck)
+        : my_range_(std::move(my_range)), community_cards_(std::move(board)),
+          num_opponents_(num_opponents), deck_(std::move(deck)) {}
+
+    /**
+     * @brief Monte Carlo estimate against any number of opponents.
+     * @return One entry per card left in the deck, in card index order. trials holds the trials that dealt it.
+     */
+    std::vector<NextCardResult> simulate(const std::vector<Core::Range>& opponent_ranges,
+                                         int iterations,
+                                         unsigned seed = std::random_device{}()) const;
+
+    /**
+     * @brief Exact heads up equity, every hero and villain combo pair over every runout.
+     * trials counts the complete boards behind each entry, a next card blocked by every hero or
+     * every villain combo has trials 0.
+     */
+    std::vector<NextCardResult> enumerate(const Core::Range& opponent_range) const;
+
+private:
+    void checkBoard() const {
+        if (community_cards_.size() != 3 && community_cards_.size() != 4)
+            throw std::invalid_argument("Runouts are explored from a flop or a turn");
+    }
+
+    std::vector<NextCardResult> makeTable(Core::CardMask next_cards) const {
+        std::vector<NextCardResult> table;
+        for (Core::CardMask m = next_cards; m; m &= m - 1) {
+            table.push_back({Core::cardFromIndex(std::countr_zero(m)), SimResult{}});
+        }
+        return table;
+    }
+
+    Core::Range my_range_;
+    Core::Board community_cards_;
+    int num_opponents_;
+    Core::Deck deck_;
+    Evaluator::HandEvaluator eval_{};
+};
+
+namespace detail {
+    /**
+     * @brief Position of each card in a table of next cards, -1 for cards not in it
+     */
+    inline std::array<int, Core::NUM_CARDS> next_card_slots(Core::CardMask next_cards) noexcept {
+        std::array<int, Core::NUM_CARDS> slots{};
+        slots.fill(-1);
+        int slot = 0;
+        for (Core::CardMask m = next_cards; m; m &= m - 1) slots[std::countr_zero(m)] = slot++;
+        return slots;
+    }
+
+    inline void finish_table(std::vector<NextCardResult>& table) {
+        for (auto& entry : table) {
+            if (entry.result.win + entry.result.tie + entry.result.loss > 0.0) entry.result.normalise();
+        }
+    }
+}
+
+inline std::vector<NextCardResult> RunoutExplorer::simulate(const std::vector<Core::Range>& opponent_ranges,
+                                                            int iterations, unsigned seed) const
+{
+    checkBoard();
+    if (opponent_ranges.size() != static_cast<size_t>(num_opponents_))
+        throw std::invalid_argument("Opponent ranges size does not match num_opponents");
+
+    const Core::CardMask board = Core::cardsMask(community_cards_.get());
+    const int missing = detail::MAX_BOARD_SIZE_NLH - static_cast<int>(community_cards_.size());
+    const Core::CardMask deck_mask = detail::deck_mask(deck_) & ~board;
+
+    std::vector<NextCardResult> table = makeTable(deck_mask);
+    const auto slots = detail::next_card_slots(deck_mask);
+
+    std::vector<Core::CardMask> deck_cards;
+    deck_cards.reserve(Core::NUM_CARDS);
+    for (Core::CardMask m = deck_mask; m; m &= m - 1) deck_cards.push_back(m & (~m + 1));
+    std::uniform_int_distribution<size_t> pick_card(0, deck_cards.empty() ? 0 : deck_cards.size() - 1);
+
+    const detail::ComboSampler hero_sampler{my_range_, board};
+    std::vector<detail::ComboSampler> villain_samplers;
+    villain_samplers.reserve(opponent_ranges.size());
+    for (const auto& r : opponent_ranges) villain_samplers.emplace_back(r, board);
+    std::vector<Core::CardMask> villain_hands(opponent_ranges.size());
+
+    if (hero_sampler.empty())
+        throw std::runtime_error("No available combo for hero");
+
+    std::mt19937 rng(seed);
+    for (int i = 0; i < iterations; ++i) {
+        const Core::CardMask hero = hero_sampler.mask(hero_sampler.sample(rng));
+        Core::CardMask dealt = board | hero;
+
+        for (size_t v = 0; v < villain_samplers.size(); ++v) {
+            const size_t idx = villain_samplers[v].sampleExcluding(rng, dealt);
+            if (idx == detail::ComboSampler::npos)
+                throw std::runtime_error("No available combo for opponent");
+            villain_hands[v] = villain_samplers[v].mask(idx);
+            dealt |= villain_hands[v];
+        }
+
+        if (std::popcount(deck_mask & ~dealt) < missing)
+            throw std::runtime_error("Not enough cards left in deck to complete the board");
+        Core::CardMask runout = 0;
+        for (int c = 0; c < missing; ++c) {
+            Core::CardMask card;
+            do {
+                card = deck_cards[pick_card(rng)];
+            } while (card & (dealt | runout));
+            runout |= card;
+        }
+
+        const Core::CardMask full_board = board | runout;
+        const auto hero_score = eval_.score(full_board | hero);
+        uint64_t best_villain = 0;
+        for (auto v : villain_hands) best_villain = std::max(best_villain, eval_.score(full_board | v));
+
+        // the same deal is a sample for every card of the runout taken as the next card
+        for (Core::CardMask m = runout; m; m &= m - 1) {
+            SimResult& r = table[slots[std::countr_zero(m)]].result;
+            if (hero_score > best_villain) r.win += 1.0;
+            else if (hero_score == best_villain) r.tie += 1.0;
+            else r.loss += 1.0;
+            ++r.trials;
+        }
+    }
+
+    detail::finish_table(table);
+    return table;
+}
+
+inline std::vector<NextCardResult> RunoutExplorer::enumerate(const Core::Range& opponent_range) const {
+    checkBoard();
+    if (num_opponents_ != 1)
+        throw std::invalid_argument("Exact enumeration only supports a single opponent");
+
+    const Core::CardMask board = Core::cardsMask(community_cards_.get());
+    const int missing = detail::MAX_BOARD_SIZE_NLH - static_cast<int>(community_cards_.size());
+    const Core::CardMask deck_mask = detail::deck_mask(deck_) & ~board;
+
+    std::vector<NextCardResult> table = makeTable(deck_mask);
+    const auto slots = detail::next_card_slots(deck_mask);
+
+    std::vector<double> hero_weights, villain_weights;
+    const auto hero_masks = detail::live_hands(my_range_, board, hero_weights);
+    const auto villain_masks = detail::live_hands(opponent_range, board, villain_weights);
+    std::vector<double> beats(hero_masks.size()), ties(hero_masks.size()), live(hero_masks.size());
+
+    detail::for_each_subset(deck_mask, missing, [&](Core::CardMask runout) {
+        // one sorted sweep per complete board instead of comparing every pair
+        const RiverSweep sweep{hero_masks, villain_masks, board | runout};
+        sweep.showdown(villain_weights, beats, ties, live);
+
+        double win = 0.0, tie = 0.0, loss = 0.0;
+        for (size_t h = 0; h < hero_masks.size(); ++h) {
+            win += hero_weights[h] * beats[h];
+            tie += hero_weights[h] * ties[h];
+            loss += hero_weights[h] * (live[h] - beats[h] - ties[h]);
+        }
+        if (win + tie + loss <= 0.0) return;
+
+        for (Core::CardMask m = runout; m; m &= m - 1) {
+            SimResult& r = table[slots[std::countr_zero(m)]].result;
+            r.win += win;
+            r.tie += tie;
+            r.loss += loss;
+            ++r.trials;
+        }
+    });
+
+    detail::finish_table(table);
+    return table;
+}
+
+}
+
+#endif
@@ -1,12 +1,46 @@
 #ifndef POKER_ENGINE_SIMULATOR_SIM_RESULT_HPP
 #define POKER_ENGINE_SIMULATOR_SIM_RESULT_HPP
 
+#include <vector>
+#include <cstddef>
+
 namespace PokerEngine::Simulator {
 
+/**
+ * @brief Aggregate only, or additionally break the result down per hero combo
+ */
+enum class ResultMode { Aggregate, PerCombo };
+
+/**
+ * @brief Weighted win/tie/loss counters for a single hero combo
+ */
+struct ComboTally {
+    double win = 0.0;
+    double tie = 0.0;
+    double loss = 0.0;
+
+    double total() const noexcept { return win + tie + loss; }
+    double equity() const noexcept {
+        const double t = total();
+        return t > 0.0 ? (win + tie / 2.0) / t : 0.0;
+    }
+
+    ComboTally& operator+=(const ComboTally& other) noexcept {
+        win += other.win;
+        tie += other.tie;
+        loss += other.loss;
+        return *this;
+    }
+};
+
 struct SimResult {
     double win = 0.0;
     double tie = 0.0;
     double loss = 0.0;
+    // Trials behind the (normalised) figures above, used to weight merges
+    std::size_t trials = 0;
+    // Indexed by Core::comboIndex, only filled in ResultMode::PerCombo
+    std::vector<ComboTally> combos;
 
     void normalise() {
         const double total = win + tie + loss;
@@ -14,8 +48,26 @@ struct SimResult {
         tie /= total;
         loss /= total;
     }
+
+    /**
+     * @brief Combine with an independent result over the same situation, e.g. from another thread
+     */
+    void merge(const SimResult& other) {
+        const double total = static_cast<double>(trials + other.trials);
+        if (total > 0.0) {
+            win = (win * trials + other.win * other.trials) / total;
+            tie = (tie * trials + other.tie * other.trials) / total;
+            loss = (loss * trials + other.loss * other.trials) / total;
+        }
+        trials += other.trials;
+
+        if (combos.size() < other.combos.size()) combos.resize(other.combos.size());
+        for (std::size_t i = 0; i < other.combos.size(); ++i) {
+            combos[i] += other.combos[i];
+        }
+    }
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
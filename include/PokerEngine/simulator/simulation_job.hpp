@@ -0,0 +1,156 @@
+#ifndef POKER_ENGINE_SIMULATOR_SIMULATION_JOB_HPP
+#define POKER_ENGINE_SIMULATOR_SIMULATION_JOB_HPP
+
+#include <vector>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <stop_token>
+
+#include "PokerEngine/simulator/poker_simulator.hpp"
+
+namespace PokerEngine::Simulator {
+
+// Iterations of the first chunk of a job with a deadline, before its speed is known
+inline constexpr int PROBE_ITERATIONS = 256;
+
+struct JobOptions {
+    // Upper bound on iterations, the job finishes once reached. 0 runs until stopped or the deadline.
+    long long max_iterations = 0;
+    // Iterations per chunk, snapshots are published and stop requests checked between chunks
+    int chunk_iterations = 10000;
+    // Wall clock budget, the job returns its best estimate so far once it is reached. The first chunk
+    // is a short probe to measure the speed, later chunks are sized to the time left.
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    // Called on the worker thread with the merged result after every chunk
+    std::function<void(const SimResult&)> on_progress;
+    // Caller owned cancellation, honoured alongside SimulationJob::cancel
+    std::stop_token stop_token;
+};
+
+class SimulationJob;
+
+/**
+ * @brief Run sim.simulate in chunks on a background thread, see JobOptions for progress,
+ * cancellation and deadline behaviour. With a deadline the job starts with a probe chunk of at most
+ * PROBE_ITERATIONS and sizes later chunks from the measured speed, so it overruns the deadline by
+ * about the time of one chunk at most.
+ */
+template<PokerSimStrategy Strategy>
+SimulationJob simulateAsync(PokerSimulator sim, Strategy strategy,
+                            std::vector<Core::Range> opponent_ranges,
+                            JobOptions options = {}, unsigned seed = std::random_device{}());
+
+/**
+ * @brief Handle to a simulation running on its own thread.
+ * Cancelling, hitting the deadline or destroying the handle stops the job between chunks;
+ * the future then holds the estimate merged so far rather than an error.
+ */
+class SimulationJob {
+public:
+    SimulationJob(SimulationJob&&) noexcept = default;
+    SimulationJob& operator=(SimulationJob&&) noexcept = default;
+
+    /**
+     * @brief Blocks until the job finishes and returns the final result, may only be called once
+     */
+    SimResult get() { return future_.get(); }
+    bool ready() const {
+        return !future_.valid() || future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    void cancel() noexcept { thread_.request_stop(); }
+
+    /**
+     * @brief Latest merged result, trials is 0 until the first chunk completes
+     */
+    SimResult snapshot() const {
+        std::lock_guard lock(state_->mutex);
+        return state_->latest;
+    }
+
+    template<PokerSimStrategy Strategy>
+    friend SimulationJob simulateAsync(PokerSimulator sim, Strategy strategy,
+                                       std::vector<Core::Range> opponent_ranges,
+                                       JobOptions options, unsigned seed);
+
+private:
+    struct State {
+        mutable std::mutex mutex;
+        SimResult latest;
+    };
+
+    SimulationJob() : state_(std::make_shared<State>()) {}
+
+    std::shared_ptr<State> state_;
+    std::future<SimResult> future_;
+    std::jthread thread_; // declared last so it is joined before the rest is torn down
+};
+
+template<PokerSimStrategy Strategy>
+SimulationJob simulateAsync(PokerSimulator sim, Strategy strategy,
+                            std::vector<Core::Range> opponent_ranges,
+                            JobOptions options, unsigned seed)
+{
+    SimulationJob job{};
+    std::promise<SimResult> promise;
+    job.future_ = promise.get_future();
+
+    job.thread_ = std::jthread(
+        [sim = std::move(sim), strategy = std::move(strategy), opponent_ranges = std::move(opponent_ranges),
+         options = std::move(options), state = job.state_, promise = std::move(promise), seed]
+        (std::stop_token own_stop) mutable {
+            using Clock = std::chrono::steady_clock;
+            try {
+                SimResult total{};
+                std::mt19937 seeds(seed);
+                double iterations_per_second = 0.0;
+
+                auto should_stop = [&] {
+                    return own_stop.stop_requested() || options.stop_token.stop_requested() ||
+                           (options.deadline && Clock::now() >= *options.deadline) ||
+                           (options.max_iterations > 0 && static_cast<long long>(total.trials) >= options.max_iterations);
+                };
+
+                while (!should_stop()) {
+                    long long chunk = std::max(options.chunk_iterations, 1);
+                    if (options.max_iterations > 0)
+                        chunk = std::min<long long>(chunk, options.max_iterations - static_cast<long long>(total.trials));
+                    if (options.deadline && iterations_per_second > 0.0) {
+                        const double remaining = std::chrono::duration<double>(*options.deadline - Clock::now()).count();
+                        chunk = std::clamp<long long>(static_cast<long long>(remaining * iterations_per_second), 1, chunk);
+                    } else if (options.deadline) {
+                        chunk = std::min<long long>(chunk, PROBE_ITERATIONS);
+                    }
+
+                    const auto start = Clock::now();
+                    SimResult part = sim.simulate(strategy, opponent_ranges, static_cast<int>(chunk), seeds());
+                    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                    if (elapsed > 0.0) iterations_per_second = chunk / elapsed;
+
+                    part.trials = static_cast<size_t>(chunk); // strategies need not fill trials themselves
+                    total.merge(part);
+                    {
+                        std::lock_guard lock(state->mutex);
+                        state->latest = total;
+                    }
+                    if (options.on_progress) options.on_progress(total);
+                }
+
+                promise.set_value(std::move(total));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+
+    return job;
+}
+
+}
+
+#endif
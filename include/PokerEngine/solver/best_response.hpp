@@ -0,0 +1,388 @@
+#ifndef POKER_ENGINE_SOLVER_BEST_RESPONSE_HPP
+#define POKER_ENGINE_SOLVER_BEST_RESPONSE_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/simulator/river_sweep.hpp"
+#include "PokerEngine/simulator/detail/enumeration.hpp"
+#include "PokerEngine/solver/game_tree.hpp"
+#include "PokerEngine/solver/river_solver.hpp"
+#include "PokerEngine/solver/mccfr.hpp"
+
+namespace PokerEngine::Solver {
+
+/**
+ * @brief Strategy of the player acting at an action node for each of their hands on the current board:
+ * fills strategy with (num_children x hands.size()) probabilities, row major by action. Called
+ * concurrently, must be thread safe.
+ */
+using StrategyProfile = std::function<void(size_t node, Core::CardMask board,
+                                           std::span<const Core::CardMask> hands, std::span<double> strategy)>;
+
+struct BestResponseResult {
+    // Each player's best response value against the other's strategy, in chips per hand pair
+    std::array<double, 2> values{};
+    // Mean gain of the two best responses over the value of the pot, in chips
+    double exploitability = 0.0;
+};
+
+/**
+ * @brief Best responses and exploitability of any strategy profile over a GameTree.
+ *
+ * Traverses the public tree once per player with one reach probability per opposing combo, the way
+ * RiverSolver does. Chance nodes deal every card, removing the opposing combos it blocks, and
+ * showdowns use a RiverSweep per complete board, built once per board and shared. An all-in
+ * showdown before the river enumerates the remaining runouts. Subtrees run in parallel from the root
+ * down until every thread is busy: a node with fewer subtrees than threads gives each subtree its own
+ * thread and hands the spare threads down, so a chance node below a narrow action node still deals
+ * its cards in parallel.
+ */
+class BestResponse {
+public:
+    /**
+     * @param board Cards dealt when the tree starts, tree.boardSize() of them
+     * @param tree Must outlive the engine
+     */
+    BestResponse(const GameTree& tree, const Core::Range& range0, const Core::Range& range1, const Core::Board& board,
+                 unsigned threads = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Value of player's best response to the opponent's part of profile, in chips per hand pair
+     */
+    double value(int player, const StrategyProfile& profile) const;
+
+    /**
+     * @brief Per hand value of player's best response, summed over live opposing combos weighted by
+     * the opponent's range, aligned with hands(player)
+     */
+    std::vector<double> handValues(int player, const StrategyProfile& profile) const;
+
+    BestResponseResult compute(const StrategyProfile& profile) const;
+
+    /**
+     * @brief Hands of a player not blocked by the starting board, the order profiles are called with
+     */
+    const std::vector<Core::CardMask>& hands(int player) const noexcept { return hands_[player]; }
+
+private:
+    using Values = std::vector<double>;
+    using Sweeps = std::array<Simulator::RiverSweep, 2>;
+
+    // threads is how many threads the call may keep busy, including its own
+    void walk(size_t index, int player, const Values& opponent_reach, Core::CardMask board,
+              const StrategyProfile& profile, Values& values, unsigned threads) const;
+    void chance(const TreeNode& node, int player, const Values& opponent_reach, Core::CardMask board,
+                const StrategyProfile& profile, Values& values, unsigned threads) const;
+
+    /**
+     * @brief Calls fn(item, worker, threads) for every item in [0, count) on min(threads, count) workers,
+     * splitting threads over the items when there are fewer items than threads
+     */
+    template<typename Fn>
+    static void split(size_t count, unsigned threads, Fn&& fn);
+    void showdown(size_t index, int player, const Values& opponent_reach, Core::CardMask board, Values& values) const;
+    void liveWeight(int player, const Values& opponent_reach, Core::CardMask board, Values& live) const;
+    std::shared_ptr<const Sweeps> sweeps(Core::CardMask board) const;
+
+    const GameTree& tree_;
+    Core::CardMask board_;
+    unsigned threads_;
+    std::array<std::vector<double>, 2> weights_;
+    std::array<std::vector<Core::CardMask>, 2> hands_;
+    std::array<std::vector<std::array<uint8_t, 2>>, 2> cards_;
+    std::array<std::vector<int32_t>, 2> same_combo_;
+    // per node, payoff of each player for a showdown lost, tied and won (fold nodes ignore the result)
+    std::vector<std::array<std::array<double, 3>, 2>> payoffs_;
+
+    mutable std::mutex sweep_mutex_;
+    mutable std::unordered_map<Core::CardMask, std::shared_ptr<const Sweeps>> sweep_cache_;
+};
+
+inline BestResponse::BestResponse(const GameTree& tree, const Core::Range& range0, const Core::Range& range1,
+                                  const Core::Board& board, unsigned threads)
+    : tree_(tree), board_(Core::cardsMask(board.get())), threads_(std::max(1u, threads)),
+      hands_{Simulator::detail::live_hands(range0, Core::cardsMask(board.get()), weights_[0]),
+             Simulator::detail::live_hands(range1, Core::cardsMask(board.get()), weights_[1])}
+{
+    if (static_cast<int>(board.size()) != tree.boardSize())
+        throw std::invalid_argument("Board does not match the street the tree starts on");
+    if (hands_[0].empty() || hands_[1].empty())
+        throw std::invalid_argument("Both ranges need a combo not blocked by the board");
+
+    for (int p = 0; p < 2; ++p) {
+        std::array<int32_t, Core::NUM_COMBOS> index_of{};
+        index_of.fill(-1);
+        for (size_t i = 0; i < hands_[1 - p].size(); ++i) {
+            const Core::CardMask m = hands_[1 - p][i];
+            index_of[Core::comboIndex(std::countr_zero(m), 63 - std::countl_zero(m))] = static_cast<int32_t>(i);
+        }
+        for (const Core::CardMask m : hands_[p]) {
+            const int low = std::countr_zero(m), high = 63 - std::countl_zero(m);
+            cards_[p].push_back({static_cast<uint8_t>(low), static_cast<uint8_t>(high)});
+            same_combo_[p].push_back(index_of[Core::comboIndex(low, high)]);
+        }
+    }
+
+    payoffs_.resize(tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& node = tree.node(i);
+        if (node.type != TreeNode::Type::Fold && node.type != TreeNode::Type::Showdown) continue;
+        for (int p = 0; p < 2; ++p) {
+            for (int r = -1; r <= 1; ++r) payoffs_[i][p][r + 1] = tree.payoff(node, p, r);
+        }
+    }
+}
+
+inline std::shared_ptr<const BestResponse::Sweeps> BestResponse::sweeps(Core::CardMask board) const {
+    {
+        std::lock_guard lock(sweep_mutex_);
+        if (auto it = sweep_cache_.find(board); it != sweep_cache_.end()) return it->second;
+    }
+    // built outside the lock, a board raced by two threads is just built twice
+    auto built = std::make_shared<const Sweeps>(Sweeps{Simulator::RiverSweep{hands_[0], hands_[1], board},
+                                                       Simulator::RiverSweep{hands_[1], hands_[0], board}});
+    std::lock_guard lock(sweep_mutex_);
+    return sweep_cache_.emplace(board, std::move(built)).first->second;
+}
+
+inline void BestResponse::liveWeight(int player, const Values& opponent_reach, Core::CardMask board, Values& live) const {
+    double total = 0.0;
+    std::array<double, Core::NUM_CARDS> card_total{};
+    const auto& opp_cards = cards_[1 - player];
+    for (size_t o = 0; o < opponent_reach.size(); ++o) {
+        total += opponent_reach[o];
+        card_total[opp_cards[o][0]] += opponent_reach[o];
+        card_total[opp_cards[o][1]] += opponent_reach[o];
+    }
+
+    const auto& cards = cards_[player];
+    const auto& same = same_combo_[player];
+    live.resize(cards.size());
+    for (size_t h = 0; h < cards.size(); ++h) {
+        if (hands_[player][h] & board) {
+            live[h] = 0.0;
+            continue;
+        }
+        // inclusion-exclusion, the identical combo was removed once per card
+        live[h] = total - card_total[cards[h][0]] - card_total[cards[h][1]] + (same[h] >= 0 ? opponent_reach[same[h]] : 0.0);
+    }
+}
+
+inline void BestResponse::showdown(size_t index, int player, const Values& opponent_reach, Core::CardMask board,
+                                   Values& values) const
+{
+    const size_t n = hands_[player].size();
+    const double win = payoffs_[index][player][2], tie = payoffs_[index][player][1], loss = payoffs_[index][player][0];
+    values.assign(n, 0.0);
+    Values beats(n), ties(n), live(n);
+
+    auto add_board = [&](Core::CardMask full_board, double probability) {
+        (*sweeps(full_board))[player].showdown(opponent_reach, beats, ties, live);
+        for (size_t h = 0; h < n; ++h) {
+            values[h] += probability * (win * beats[h] + tie * ties[h] + loss * (live[h] - beats[h] - ties[h]));
+        }
+    };
+
+    const int missing = Simulator::detail::MAX_BOARD_SIZE_NLH - std::popcount(board);
+    if (missing == 0) {
+        add_board(board, 1.0);
+        return;
+    }
+    // all in before the river: every runout is equally likely once both hands are known
+    const int unseen = Core::NUM_CARDS - std::popcount(board) - 4;
+    const double probability = 1.0 / static_cast<double>(Simulator::detail::choose(unseen, missing));
+    const Core::CardMask deck = ((Core::CardMask{1} << Core::NUM_CARDS) - 1) & ~board;
+    Simulator::detail::for_each_subset(deck, missing, [&](Core::CardMask runout) { add_board(board | runout, probability); });
+}
+
+template<typename Fn>
+void BestResponse::split(size_t count, unsigned threads, Fn&& fn) {
+    if (count == 1) {
+        fn(size_t{0}, size_t{0}, threads);
+        return;
+    }
+    auto child_threads = [&](size_t item) -> unsigned {
+        if (count >= threads) return 1;
+        return static_cast<unsigned>(threads / count + (item < threads % count ? 1 : 0));
+    };
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) fn(i, size_t{0}, 1u);
+        return;
+    }
+    const size_t workers = std::min<size_t>(threads, count);
+    std::vector<std::exception_ptr> errors(workers);
+    {
+        std::vector<std::jthread> pool;
+        for (size_t t = 0; t < workers; ++t) {
+            pool.emplace_back([&, t] {
+                try {
+                    for (size_t i = t; i < count; i += workers) fn(i, t, child_threads(i));
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (const auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+inline void BestResponse::chance(const TreeNode& node, int player, const Values& opponent_reach, Core::CardMask board,
+                                 const StrategyProfile& profile, Values& values, unsigned threads) const
+{
+    const size_t n = hands_[player].size();
+    std::vector<Core::CardMask> cards;
+    for (Core::CardMask m = ((Core::CardMask{1} << Core::NUM_CARDS) - 1) & ~board; m; m &= m - 1) cards.push_back(m & (~m + 1));
+    // each card is one of the cards left once both hands are known
+    const double probability = 1.0 / static_cast<double>(Core::NUM_CARDS - std::popcount(board) - 4);
+
+    // one partial sum and set of buffers per worker
+    const size_t workers = std::max<size_t>(1, std::min<size_t>(threads, cards.size()));
+    std::vector<Values> partial(workers, Values(n, 0.0)), reach(workers), child_values(workers);
+    split(cards.size(), threads, [&](size_t c, size_t t, unsigned child_threads) {
+        reach[t] = opponent_reach;
+        for (size_t o = 0; o < reach[t].size(); ++o) {
+            if (hands_[1 - player][o] & cards[c]) reach[t][o] = 0.0;
+        }
+        walk(node.first_child, player, reach[t], board | cards[c], profile, child_values[t], child_threads);
+        for (size_t h = 0; h < n; ++h) {
+            if (!(hands_[player][h] & cards[c])) partial[t][h] += probability * child_values[t][h];
+        }
+    });
+    values.assign(n, 0.0);
+    for (const auto& p : partial) {
+        for (size_t h = 0; h < n; ++h) values[h] += p[h];
+    }
+}
+
+inline void BestResponse::walk(size_t index, int player, const Values& opponent_reach, Core::CardMask board,
+                               const StrategyProfile& profile, Values& values, unsigned threads) const
+{
+    const TreeNode& node = tree_.node(index);
+    switch (node.type) {
+        case TreeNode::Type::Fold: {
+            liveWeight(player, opponent_reach, board, values);
+            const double payoff = payoffs_[index][player][0];
+            for (auto& v : values) v *= payoff;
+            return;
+        }
+        case TreeNode::Type::Showdown:
+            showdown(index, player, opponent_reach, board, values);
+            return;
+        case TreeNode::Type::Chance:
+            chance(node, player, opponent_reach, board, profile, values, threads);
+            return;
+        case TreeNode::Type::Action:
+            break;
+    }
+
+    const size_t actions = node.num_children;
+    const int opp = 1 - player;
+    const size_t n = hands_[player].size();
+    std::vector<Values> child_values(actions);
+    std::vector<Values> reach(actions);
+
+    if (node.player == player) {
+        for (auto& r : reach) r = opponent_reach;
+    } else {
+        const size_t m = hands_[opp].size();
+        Values strategy(actions * m);
+        profile(index, board, hands_[opp], strategy);
+        for (size_t a = 0; a < actions; ++a) {
+            reach[a].resize(m);
+            for (size_t o = 0; o < m; ++o) reach[a][o] = opponent_reach[o] * strategy[a * m + o];
+        }
+    }
+
+    split(actions, threads, [&](size_t a, size_t, unsigned child_threads) {
+        walk(node.first_child + a, player, reach[a], board, profile, child_values[a], child_threads);
+    });
+
+    if (node.player == player) {
+        values.assign(n, -std::numeric_limits<double>::infinity());
+        for (const auto& cv : child_values) {
+            for (size_t h = 0; h < n; ++h) values[h] = std::max(values[h], cv[h]);
+        }
+        return;
+    }
+    values.assign(n, 0.0);
+    for (const auto& cv : child_values) {
+        for (size_t h = 0; h < n; ++h) values[h] += cv[h];
+    }
+}
+
+inline std::vector<double> BestResponse::handValues(int player, const StrategyProfile& profile) const {
+    if (player != 0 && player != 1) throw std::invalid_argument("Player is 0 or 1");
+    Values values;
+    walk(0, player, weights_[1 - player], board_, profile, values, threads_);
+    return values;
+}
+
+inline double BestResponse::value(int player, const StrategyProfile& profile) const {
+    const Values values = handValues(player, profile);
+    Values live;
+    liveWeight(player, weights_[1 - player], board_, live);
+
+    // values are summed over opposing combos, normalise by the weight of all live pairs
+    double value = 0.0, pairs = 0.0;
+    for (size_t h = 0; h < values.size(); ++h) {
+        value += weights_[player][h] * values[h];
+        pairs += weights_[player][h] * live[h];
+    }
+    return pairs > 0.0 ? value / pairs : 0.0;
+}
+
+inline BestResponseResult BestResponse::compute(const StrategyProfile& profile) const {
+    BestResponseResult result{};
+    for (int p = 0; p < 2; ++p) result.values[p] = value(p, profile);
+    result.exploitability = (result.values[0] + result.values[1] - tree_.pot()) / 2.0;
+    return result;
+}
+
+/**
+ * @brief Profile playing a RiverSolver's average strategy. Use with a BestResponse over solver.tree()
+ * built from the solver's ranges and board, so hands line up.
+ */
+inline StrategyProfile averageStrategyProfile(const RiverSolver& solver) {
+    return [&solver](size_t node, Core::CardMask, std::span<const Core::CardMask> hands, std::span<double> strategy) {
+        const auto average = solver.averageStrategy(node);
+        if (average.size() != strategy.size() || hands.size() != solver.hands(solver.nodes()[node].player).size())
+            throw std::invalid_argument("Profile hands do not match the solver's");
+        std::copy(average.begin(), average.end(), strategy.begin());
+    };
+}
+
+/**
+ * @brief Profile playing an MCCFRSolver's average strategy, looking up each hand's bucket
+ */
+inline StrategyProfile averageStrategyProfile(const MCCFRSolver& solver) {
+    return [&solver](size_t node, Core::CardMask board, std::span<const Core::CardMask> hands, std::span<double> strategy) {
+        const size_t n = hands.size();
+        for (size_t h = 0; h < n; ++h) {
+            if (hands[h] & board) continue; // never reached, its reach is already 0
+            const auto average = solver.averageStrategy(node, solver.bucket(node, hands[h], board));
+            for (size_t a = 0; a < average.size(); ++a) strategy[a * n + h] = average[a];
+        }
+    };
+}
+
+}
+
+#endif
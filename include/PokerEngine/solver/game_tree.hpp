@@ -0,0 +1,402 @@
+#ifndef POKER_ENGINE_SOLVER_GAME_TREE_HPP
+#define POKER_ENGINE_SOLVER_GAME_TREE_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/pot.hpp"
+#include "PokerEngine/core/stack.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+
+namespace PokerEngine::Solver {
+
+/**
+ * @brief Action on the edge into a node. amount is the actor's total commitment afterwards.
+ */
+struct BetAction {
+    enum class Kind : uint8_t { None, Fold, Check, Call, Bet, Raise };
+    Kind kind = Kind::None;
+    int32_t amount = 0;
+};
+
+/**
+ * @brief Bet and raise menu of one street
+ */
+struct BetSizing {
+    // Bet sizes as fractions of the pot
+    std::vector<double> bet_sizes{0.5, 1.0};
+    // Raise sizes as fractions of the pot after calling
+    std::vector<double> raise_sizes{1.0};
+    // Raises allowed after the first bet
+    int max_raises = 2;
+    // Offer an all-in in addition to the sized bets and raises
+    bool all_in = true;
+};
+
+struct GameTreeConfig {
+    // Board cards when the tree starts: 3 flop, 4 turn, 5 river
+    int board_size = 5;
+    // Chips in the pot when the tree starts
+    int pot = 100;
+    // Chips behind for player 0 (first to act each street) and player 1
+    std::array<int, 2> stacks{100, 100};
+    // Sizing per street, indexed by board size - 3
+    std::array<BetSizing, 3> streets{};
+};
+
+/**
+ * @brief Fixed size node, trivially copyable so a tree is a flat array that can be written and mapped as is
+ */
+struct TreeNode {
+    // Chance nodes deal the next street's card and have a single child
+    enum class Type : uint8_t { Action, Chance, Fold, Showdown };
+    Type type = Type::Action;
+    // Player to act at action nodes, the folder at fold nodes
+    uint8_t player = 0;
+    uint8_t board_size = 0;
+    uint8_t raises = 0;
+    uint16_t num_children = 0;
+    uint32_t first_child = 0;
+    uint32_t parent = 0;
+    // Chips put in by each player since the tree started
+    std::array<int32_t, 2> commit{};
+    BetAction action{};
+    // Action nodes only: index of the node's first action among all actions of the tree, so per action
+    // storage (regrets, strategy) for action a is at (action_offset + a) * slots_per_action
+    uint64_t action_offset = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<TreeNode>);
+
+struct TreeSize {
+    size_t nodes = 0;
+    size_t action_nodes = 0;
+    size_t actions = 0;
+
+    size_t treeBytes() const noexcept { return nodes * sizeof(TreeNode); }
+    /**
+     * @brief Bytes for one array of per action values, e.g. regrets, with slots_per_action hands or buckets
+     */
+    size_t storageBytes(size_t slots_per_action, size_t value_bytes = sizeof(float)) const noexcept {
+        return actions * slots_per_action * value_bytes;
+    }
+};
+
+/**
+ * @brief Heads up betting tree over one or more streets, stored as one flat array of TreeNode with
+ * index links: children of a node are contiguous, starting at first_child.
+ *
+ * The tree is public: cards are not branched on, a Chance node only marks the start of the next
+ * street. Bet amounts follow Stack semantics (a bet larger than the chips behind is an all-in) and
+ * are capped at what the opponent can call, terminal payoffs follow Pot semantics.
+ */
+class GameTree {
+public:
+    struct GameTreeHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t node_count;
+        int32_t pot;
+        std::array<int32_t, 2> stacks;
+        uint32_t board_size;
+    };
+
+    static constexpr std::array<char, 4> MAGIC{'P', 'E', 'G', 'T'};
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Node and action counts of the tree config describes, without building it
+     */
+    static TreeSize estimate(const GameTreeConfig& config);
+
+    /**
+     * @brief Build the tree into a single allocation sized by estimate()
+     */
+    explicit GameTree(const GameTreeConfig& config);
+
+    /**
+     * @brief Memory map a tree written by save(), nodes are used in place
+     */
+    static GameTree load(const std::string& path);
+
+    // nodes may point into the owned array or the mapping, so a tree moves but does not copy
+    GameTree(GameTree&&) noexcept = default;
+    GameTree& operator=(GameTree&&) noexcept = default;
+    GameTree(const GameTree&) = delete;
+    GameTree& operator=(const GameTree&) = delete;
+
+    void save(const std::string& path) const;
+
+    std::span<const TreeNode> nodes() const noexcept { return nodes_; }
+    const TreeNode& node(size_t index) const noexcept { return nodes_[index]; }
+    const TreeNode& root() const noexcept { return nodes_.front(); }
+    std::span<const TreeNode> children(size_t index) const noexcept {
+        return nodes_.subspan(nodes_[index].first_child, nodes_[index].num_children);
+    }
+
+    size_t size() const noexcept { return nodes_.size(); }
+    size_t numActions() const noexcept { return num_actions_; }
+    int pot() const noexcept { return pot_; }
+    const std::array<int, 2>& stacks() const noexcept { return stacks_; }
+    int boardSize() const noexcept { return board_size_; }
+
+    /**
+     * @brief Chips player wins at a terminal node net of their own commitment, the initial pot included.
+     * @param result Showdown result for player: 1 win, 0 tie, -1 loss. Ignored at fold nodes.
+     */
+    double payoff(const TreeNode& terminal, int player, int result = 0) const;
+
+private:
+    GameTree() = default;
+
+    struct Builder;
+
+    std::vector<TreeNode> owned_;
+    Core::detail::MappedFile file_;
+    std::span<const TreeNode> nodes_;
+    size_t num_actions_ = 0;
+    int pot_ = 0;
+    std::array<int, 2> stacks_{};
+    int board_size_ = 0;
+};
+
+/**
+ * @brief Legal actions of a node, shared by the counting and the building pass
+ */
+struct GameTree::Builder {
+    const GameTreeConfig& config;
+
+    std::vector<TreeNode> children(const TreeNode& node) const {
+        std::vector<TreeNode> result;
+        if (node.type == TreeNode::Type::Chance) {
+            TreeNode first{};
+            first.type = TreeNode::Type::Action;
+            first.player = 0;
+            first.board_size = node.board_size;
+            first.commit = node.commit;
+            result.push_back(first);
+            return result;
+        }
+        if (node.type != TreeNode::Type::Action) return result;
+
+        const int p = node.player, opp = 1 - p;
+        const BetSizing& sizing = config.streets[node.board_size - 3];
+        const int to_call = node.commit[opp] - node.commit[p];
+        const int pot_now = config.pot + node.commit[0] + node.commit[1];
+        // the most either player can have in, a bet beyond it could never be called
+        const int cap = std::min(config.stacks[0], config.stacks[1]);
+
+        auto make = [&](TreeNode::Type type, int player, BetAction::Kind kind, int amount, int raises) {
+            TreeNode c{};
+            c.type = type;
+            c.player = static_cast<uint8_t>(player);
+            c.board_size = node.board_size;
+            c.raises = static_cast<uint8_t>(raises);
+            c.commit = node.commit;
+            c.commit[p] = amount;
+            c.action = {kind, amount};
+            return c;
+        };
+
+        // end of a betting round: showdown on the river or once someone is all in, else the next street
+        auto close = [&](BetAction::Kind kind, int amount) {
+            TreeNode c = make(TreeNode::Type::Showdown, 0, kind, amount, 0);
+            if (node.board_size < 5 && amount < cap) {
+                c.type = TreeNode::Type::Chance;
+                c.board_size = static_cast<uint8_t>(node.board_size + 1);
+            }
+            result.push_back(c);
+        };
+
+        auto sized = [&](const std::vector<double>& sizes, BetAction::Kind kind, double base, int min_to, int raises) {
+            std::vector<int> amounts;
+            for (double f : sizes) {
+                // Stack semantics: asking for more than is behind puts the player all in
+                Core::Stack behind{cap - node.commit[p]};
+                const int wager = node.commit[opp] - node.commit[p] + static_cast<int>(std::lround(f * base));
+                amounts.push_back(node.commit[p] + behind.removeChips(std::max(wager, 0)));
+            }
+            if (sizing.all_in) amounts.push_back(cap);
+            std::sort(amounts.begin(), amounts.end());
+            amounts.erase(std::unique(amounts.begin(), amounts.end()), amounts.end());
+            for (int to : amounts) {
+                if (to <= node.commit[opp] || (to < min_to && to != cap)) continue;
+                result.push_back(make(TreeNode::Type::Action, opp, kind, to, raises));
+            }
+        };
+
+        if (to_call == 0) {
+            if (p == 0) result.push_back(make(TreeNode::Type::Action, 1, BetAction::Kind::Check, node.commit[p], node.raises));
+            else close(BetAction::Kind::Check, node.commit[p]);
+            if (node.commit[p] < cap) sized(sizing.bet_sizes, BetAction::Kind::Bet, pot_now, node.commit[opp] + 1, 0);
+        } else {
+            result.push_back(make(TreeNode::Type::Fold, p, BetAction::Kind::Fold, node.commit[p], node.raises));
+            close(BetAction::Kind::Call, node.commit[opp]);
+            if (node.raises < sizing.max_raises && node.commit[opp] < cap)
+                sized(sizing.raise_sizes, BetAction::Kind::Raise, pot_now + to_call, node.commit[opp] + to_call, node.raises + 1);
+        }
+        return result;
+    }
+
+    TreeNode root() const {
+        TreeNode r{};
+        r.type = TreeNode::Type::Action;
+        r.board_size = static_cast<uint8_t>(config.board_size);
+        return r;
+    }
+
+    void count(const TreeNode& node, TreeSize& size) const {
+        ++size.nodes;
+        const auto kids = children(node);
+        if (node.type == TreeNode::Type::Action) {
+            ++size.action_nodes;
+            size.actions += kids.size();
+        }
+        for (const auto& c : kids) count(c, size);
+    }
+
+    void build(std::vector<TreeNode>& nodes, size_t index) const {
+        const auto kids = children(nodes[index]);
+        nodes[index].first_child = static_cast<uint32_t>(nodes.size());
+        nodes[index].num_children = static_cast<uint16_t>(kids.size());
+        // children first so they are contiguous, then each subtree
+        for (auto c : kids) {
+            c.parent = static_cast<uint32_t>(index);
+            nodes.push_back(c);
+        }
+        const size_t first = nodes[index].first_child;
+        for (size_t c = 0; c < kids.size(); ++c) build(nodes, first + c);
+    }
+};
+
+namespace detail {
+    inline void validate_config(const GameTreeConfig& config) {
+        if (config.board_size < 3 || config.board_size > 5)
+            throw std::invalid_argument("Game trees start on the flop, turn or river");
+        if (config.pot <= 0 || config.stacks[0] < 0 || config.stacks[1] < 0)
+            throw std::invalid_argument("Pot must be positive and stacks non-negative");
+    }
+}
+
+inline TreeSize GameTree::estimate(const GameTreeConfig& config) {
+    detail::validate_config(config);
+    const Builder builder{config};
+    TreeSize size{};
+    builder.count(builder.root(), size);
+    return size;
+}
+
+inline GameTree::GameTree(const GameTreeConfig& config)
+    : pot_(config.pot), stacks_(config.stacks), board_size_(config.board_size)
+{
+    const TreeSize size = estimate(config);
+    const Builder builder{config};
+
+    owned_.reserve(size.nodes); // the only allocation, nodes never move while building
+    owned_.push_back(builder.root());
+    builder.build(owned_, 0);
+    for (auto& node : owned_) {
+        if (node.type != TreeNode::Type::Action) continue;
+        node.action_offset = num_actions_;
+        num_actions_ += node.num_children;
+    }
+    nodes_ = owned_;
+}
+
+inline GameTree GameTree::load(const std::string& path) {
+    GameTree tree{};
+    tree.file_ = Core::detail::MappedFile(path);
+
+    GameTreeHeader header{};
+    if (tree.file_.size() < sizeof(header))
+        throw std::runtime_error("Game tree file is truncated: " + path);
+    std::memcpy(&header, tree.file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC.data(), MAGIC.size()) != 0 || header.version != VERSION)
+        throw std::runtime_error("Not a compatible game tree: " + path);
+    if (tree.file_.size() != sizeof(header) + header.node_count * sizeof(TreeNode) || header.node_count == 0)
+        throw std::runtime_error("Game tree file has unexpected size: " + path);
+
+    tree.nodes_ = {reinterpret_cast<const TreeNode*>(tree.file_.data() + sizeof(header)), static_cast<size_t>(header.node_count)};
+    tree.pot_ = header.pot;
+    tree.stacks_ = {header.stacks[0], header.stacks[1]};
+    tree.board_size_ = static_cast<int>(header.board_size);
+    for (const auto& node : tree.nodes_) {
+        if (node.type == TreeNode::Type::Action) tree.num_actions_ += node.num_children;
+    }
+    return tree;
+}
+
+inline void GameTree::save(const std::string& path) const {
+    GameTreeHeader header{};
+    std::memcpy(header.magic, MAGIC.data(), MAGIC.size());
+    header.version = VERSION;
+    header.node_count = nodes_.size();
+    header.pot = pot_;
+    header.stacks = {stacks_[0], stacks_[1]};
+    header.board_size = static_cast<uint32_t>(board_size_);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot open file for writing: " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(nodes_.data()), static_cast<std::streamsize>(nodes_.size_bytes()));
+    if (!out) throw std::runtime_error("Failed writing game tree: " + path);
+}
+
+inline double GameTree::payoff(const TreeNode& terminal, int player, int result) const {
+    const int opp = 1 - player;
+    Core::Pot pot{};
+    pot.addContribution(0, terminal.commit[0]);
+    pot.addContribution(1, terminal.commit[1]);
+
+    if (terminal.type == TreeNode::Type::Fold) result = terminal.player == player ? -1 : 1;
+    else if (terminal.type != TreeNode::Type::Showdown)
+        throw std::invalid_argument("Payoffs are only defined at terminal nodes");
+
+    if (result == 0) {
+        // the matched part and the initial pot are split, anything unmatched goes back
+        return pot_ / 2.0;
+    }
+    const int winner = result > 0 ? player : opp;
+    const int won = pot.getWinningsForPlayer(winner);
+    if (winner == player) return pot_ + won - terminal.commit[player];
+    return pot.getContribution(player) - terminal.commit[player]; // only the unmatched part comes back
+}
+
+/**
+ * @brief Per action values of a tree in one flat array, slots_per_action values (hands or buckets) per
+ * action laid out [action][slot], so a node's values are one contiguous block
+ */
+template<typename T>
+class ActionTable {
+public:
+    ActionTable(const GameTree& tree, size_t slots_per_action, T initial = T{})
+        : slots_(slots_per_action), values_(tree.numActions() * slots_per_action, initial) {}
+
+    std::span<T> at(const TreeNode& node) noexcept {
+        return {values_.data() + node.action_offset * slots_, node.num_children * slots_};
+    }
+    std::span<const T> at(const TreeNode& node) const noexcept {
+        return {values_.data() + node.action_offset * slots_, node.num_children * slots_};
+    }
+
+    size_t slots() const noexcept { return slots_; }
+    std::span<T> values() noexcept { return values_; }
+    std::span<const T> values() const noexcept { return values_; }
+
+private:
+    size_t slots_;
+    std::vector<T> values_;
+};
+
+}
+
+#endif
@@ -0,0 +1,402 @@
+#ifndef POKER_ENGINE_SOLVER_MCCFR_HPP
+#define POKER_ENGINE_SOLVER_MCCFR_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/core/detail/mapped_file.hpp"
+#include "PokerEngine/core/detail/xoshiro.hpp"
+#include "PokerEngine/evaluator/hand_evaluator.hpp"
+#include "PokerEngine/abstraction/bucket_table.hpp"
+#include "PokerEngine/simulator/detail/combo_sampler.hpp"
+#include "PokerEngine/solver/game_tree.hpp"
+
+namespace PokerEngine::Solver {
+
+/**
+ * @brief Maps a player's hole cards and the board to an information set bucket, per street
+ */
+struct CardAbstraction {
+    // Buckets per street, indexed by board size - 3
+    std::array<uint32_t, 3> num_buckets{};
+    // Called with the board of the street being bucketed (3, 4 or 5 cards), must be thread safe
+    std::function<uint32_t(Core::CardMask hero, Core::CardMask board)> bucket;
+};
+
+/**
+ * @brief One bucket per hole card combo, ignoring the board. Exact when the board is fixed, i.e. river games.
+ */
+inline CardAbstraction comboAbstraction() {
+    return {{Core::NUM_COMBOS, Core::NUM_COMBOS, Core::NUM_COMBOS}, [](Core::CardMask hero, Core::CardMask) {
+        return static_cast<uint32_t>(Core::comboIndex(std::countr_zero(hero), 63 - std::countl_zero(hero)));
+    }};
+}
+
+/**
+ * @brief Buckets from tables built by buildAbstraction, indexed by board size - 3. Tables must outlive
+ * the abstraction, streets the tree never reaches may be null.
+ */
+inline CardAbstraction bucketTableAbstraction(std::array<const Abstraction::BucketTable*, 3> tables) {
+    CardAbstraction abstraction{};
+    for (size_t s = 0; s < tables.size(); ++s) {
+        if (!tables[s]) continue;
+        if (tables[s]->boardSize() != static_cast<int>(s) + 3)
+            throw std::invalid_argument("Bucket table is for a different street");
+        abstraction.num_buckets[s] = tables[s]->numBuckets();
+    }
+    abstraction.bucket = [tables](Core::CardMask hero, Core::CardMask board) -> uint32_t {
+        return tables[std::popcount(board) - 3]->bucket(hero, board);
+    };
+    return abstraction;
+}
+
+struct MCCFROptions {
+    unsigned threads = std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    // Written every checkpoint_every iterations when both are set
+    std::string checkpoint_path;
+    uint64_t checkpoint_every = 0;
+    // Called with the iterations run after each checkpoint
+    std::function<void(uint64_t)> on_checkpoint;
+};
+
+/**
+ * @brief External sampling Monte Carlo CFR over a GameTree with a card abstraction.
+ *
+ * Each iteration deals both hands from the ranges and the rest of the board, buckets every street
+ * once and scores the showdown once with HandEvaluator, then traverses the tree for each player in
+ * turn: every action of the traverser is explored, opponent actions are sampled. Chance nodes need no
+ * sampling of their own since the whole runout is dealt upfront.
+ *
+ * Regrets and strategy sums are flat double arrays laid out like ActionTable, with the bucket as the
+ * slot. Under linear averaging a strategy sum grows like t^2/2, so in float the increment of a late
+ * iteration would round away long before the hundreds of millions of iterations a large game needs.
+ * Workers share them without locks: updates are relaxed atomic adds through std::atomic_ref, so
+ * concurrent iterations may read slightly stale regrets, which MCCFR tolerates. Each worker owns a
+ * Xoshiro256 generator. The average strategy weighs iteration t by t, as in linear CFR, so the poor
+ * early strategies fade out of it.
+ */
+class MCCFRSolver {
+public:
+    struct CheckpointHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t iterations;
+        uint64_t num_actions;
+        uint64_t slots;
+    };
+
+    static constexpr std::array<char, 4> MAGIC{'P', 'E', 'M', 'C'};
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t MAX_ACTIONS = 32;
+
+    /**
+     * @param tree Must outlive the solver
+     * @param board Cards dealt when the tree starts, tree.boardSize() of them
+     */
+    MCCFRSolver(const GameTree& tree, const Core::Range& range0, const Core::Range& range1,
+                const Core::Board& board, CardAbstraction abstraction, MCCFROptions options = {});
+
+    /**
+     * @brief Run iterations more iterations, each traversing the tree once per player
+     */
+    void run(uint64_t iterations);
+
+    uint64_t iterations() const noexcept { return iterations_; }
+    const GameTree& tree() const noexcept { return tree_; }
+
+    /**
+     * @brief Average strategy of an action node for one bucket, one probability per child
+     */
+    std::vector<double> averageStrategy(size_t node, uint32_t bucket) const;
+
+    /**
+     * @brief Bucket of a hand at an action node's street
+     */
+    uint32_t bucket(size_t node, Core::CardMask hero, Core::CardMask board) const;
+
+    void saveCheckpoint(const std::string& path) const;
+    /**
+     * @brief Restore regrets, strategy sums and the iteration count, the tree and abstraction must match
+     */
+    void loadCheckpoint(const std::string& path);
+
+private:
+    struct Deal {
+        std::array<std::array<uint32_t, 3>, 2> buckets;
+        double weight; // of this iteration in the average strategy
+        int result; // showdown result for player 0: 1 win, 0 tie, -1 loss
+    };
+
+    Deal deal(Core::detail::Xoshiro256& rng) const;
+    double traverse(size_t index, int player, const Deal& deal, Core::detail::Xoshiro256& rng);
+
+    size_t slot(const TreeNode& node, size_t action, uint32_t bucket) const noexcept {
+        return (node.action_offset + action) * slots_ + bucket;
+    }
+
+    const GameTree& tree_;
+    Core::CardMask board_;
+    std::array<Simulator::detail::ComboSampler, 2> samplers_;
+    CardAbstraction abstraction_;
+    MCCFROptions options_;
+    Evaluator::HandEvaluator eval_{};
+
+    size_t slots_ = 0;
+    std::vector<double> regrets_;
+    std::vector<double> strategy_sums_;
+    // per node, payoff of each player for a showdown lost, tied and won (fold nodes ignore the result)
+    std::vector<std::array<std::array<double, 3>, 2>> payoffs_;
+    std::vector<Core::detail::Xoshiro256> rngs_;
+    uint64_t iterations_ = 0;
+};
+
+inline MCCFRSolver::MCCFRSolver(const GameTree& tree, const Core::Range& range0, const Core::Range& range1,
+                                const Core::Board& board, CardAbstraction abstraction, MCCFROptions options)
+    : tree_(tree), board_(Core::cardsMask(board.get())),
+      samplers_{Simulator::detail::ComboSampler{range0, board_}, Simulator::detail::ComboSampler{range1, board_}},
+      abstraction_(std::move(abstraction)), options_(std::move(options))
+{
+    if (static_cast<int>(board.size()) != tree.boardSize())
+        throw std::invalid_argument("Board does not match the street the tree starts on");
+    if (samplers_[0].empty() || samplers_[1].empty())
+        throw std::invalid_argument("Both ranges need a combo not blocked by the board");
+    if (!abstraction_.bucket)
+        throw std::invalid_argument("Card abstraction has no bucket function");
+
+    for (const auto& node : tree.nodes()) {
+        if (node.type != TreeNode::Type::Action) continue;
+        if (node.num_children > MAX_ACTIONS)
+            throw std::invalid_argument("Too many actions at a node");
+        const uint32_t buckets = abstraction_.num_buckets[node.board_size - 3];
+        if (buckets == 0)
+            throw std::invalid_argument("Card abstraction has no buckets for a street the tree reaches");
+        slots_ = std::max<size_t>(slots_, buckets);
+    }
+
+    regrets_.assign(tree.numActions() * slots_, 0.0);
+    strategy_sums_.assign(tree.numActions() * slots_, 0.0);
+
+    payoffs_.resize(tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& node = tree.node(i);
+        if (node.type != TreeNode::Type::Fold && node.type != TreeNode::Type::Showdown) continue;
+        for (int p = 0; p < 2; ++p) {
+            for (int r = -1; r <= 1; ++r) payoffs_[i][p][r + 1] = tree.payoff(node, p, r);
+        }
+    }
+
+    const unsigned threads = std::max(1u, options_.threads);
+    for (unsigned t = 0; t < threads; ++t) rngs_.emplace_back(options_.seed + 0x9E3779B97F4A7C15ull * t);
+}
+
+inline MCCFRSolver::Deal MCCFRSolver::deal(Core::detail::Xoshiro256& rng) const {
+    constexpr int MAX_ATTEMPTS = 1000;
+    std::array<Core::CardMask, 2> hands{};
+    // both hands drawn independently and redrawn on a clash, so each disjoint pair comes up in
+    // proportion to the product of its weights, as card removal requires
+    for (int attempt = 0;; ++attempt) {
+        if (attempt == MAX_ATTEMPTS)
+            throw std::runtime_error("Ranges leave no deal with disjoint hands");
+        hands[0] = samplers_[0].mask(samplers_[0].sample(rng));
+        hands[1] = samplers_[1].mask(samplers_[1].sample(rng));
+        if (!(hands[0] & hands[1])) break;
+    }
+
+    // deal the runout a street at a time so each street is bucketed on its own board
+    Deal d{};
+    Core::CardMask board = board_;
+    const Core::CardMask dealt = hands[0] | hands[1];
+    for (int s = tree_.boardSize() - 3; s < 3; ++s) {
+        while (std::popcount(board) < s + 3) {
+            const Core::CardMask card = Core::CardMask{1} << rng.below(Core::NUM_CARDS);
+            if (!(card & (board | dealt))) board |= card;
+        }
+        for (int p = 0; p < 2; ++p) d.buckets[p][s] = abstraction_.bucket(hands[p], board);
+    }
+
+    const uint64_t score0 = eval_.score(board | hands[0]);
+    const uint64_t score1 = eval_.score(board | hands[1]);
+    d.result = score0 > score1 ? 1 : (score0 == score1 ? 0 : -1);
+    return d;
+}
+
+inline double MCCFRSolver::traverse(size_t index, int player, const Deal& d, Core::detail::Xoshiro256& rng) {
+    const TreeNode& node = tree_.node(index);
+    switch (node.type) {
+        case TreeNode::Type::Fold:
+        case TreeNode::Type::Showdown:
+            return payoffs_[index][player][(player == 0 ? d.result : -d.result) + 1];
+        case TreeNode::Type::Chance:
+            return traverse(node.first_child, player, d, rng);
+        case TreeNode::Type::Action:
+            break;
+    }
+
+    const size_t actions = node.num_children;
+    const uint32_t bucket = d.buckets[node.player][node.board_size - 3];
+
+    // regret matching on the positive part of the regrets
+    std::array<double, MAX_ACTIONS> strategy{};
+    double total = 0.0;
+    for (size_t a = 0; a < actions; ++a) {
+        const double r = std::atomic_ref<double>(regrets_[slot(node, a, bucket)]).load(std::memory_order_relaxed);
+        strategy[a] = std::max(r, 0.0);
+        total += strategy[a];
+    }
+    for (size_t a = 0; a < actions; ++a) strategy[a] = total > 0.0 ? strategy[a] / total : 1.0 / actions;
+
+    if (node.player == player) {
+        std::array<double, MAX_ACTIONS> values{};
+        double value = 0.0;
+        for (size_t a = 0; a < actions; ++a) {
+            values[a] = traverse(node.first_child + a, player, d, rng);
+            value += strategy[a] * values[a];
+        }
+        for (size_t a = 0; a < actions; ++a) {
+            std::atomic_ref<double>(regrets_[slot(node, a, bucket)])
+                .fetch_add(values[a] - value, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    // the opponent's current strategy feeds the average, then one action is sampled from it
+    for (size_t a = 0; a < actions; ++a) {
+        std::atomic_ref<double>(strategy_sums_[slot(node, a, bucket)])
+            .fetch_add(d.weight * strategy[a], std::memory_order_relaxed);
+    }
+    double pick = rng.uniform();
+    size_t chosen = actions - 1;
+    for (size_t a = 0; a < actions; ++a) {
+        pick -= strategy[a];
+        if (pick < 0.0) {
+            chosen = a;
+            break;
+        }
+    }
+    return traverse(node.first_child + chosen, player, d, rng);
+}
+
+inline void MCCFRSolver::run(uint64_t iterations) {
+    const bool checkpoints = !options_.checkpoint_path.empty() && options_.checkpoint_every > 0;
+    const uint64_t target = iterations_ + iterations;
+    constexpr uint64_t BATCH = 64;
+
+    while (iterations_ < target) {
+        // workers run up to the next checkpoint, which is written once they have all stopped
+        uint64_t chunk_end = target;
+        if (checkpoints) chunk_end = std::min(target, (iterations_ / options_.checkpoint_every + 1) * options_.checkpoint_every);
+
+        std::atomic<uint64_t> next{iterations_};
+        std::vector<std::exception_ptr> errors(rngs_.size());
+        {
+            std::vector<std::jthread> workers;
+            for (size_t t = 0; t < rngs_.size(); ++t) {
+                workers.emplace_back([&, t] {
+                    try {
+                        auto& rng = rngs_[t];
+                        for (uint64_t begin = next.fetch_add(BATCH); begin < chunk_end; begin = next.fetch_add(BATCH)) {
+                            const uint64_t end = std::min(begin + BATCH, chunk_end);
+                            for (uint64_t i = begin; i < end; ++i) {
+                                Deal d = deal(rng);
+                                d.weight = static_cast<double>(i + 1);
+                                traverse(0, 0, d, rng);
+                                traverse(0, 1, d, rng);
+                            }
+                        }
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                        next = chunk_end;
+                    }
+                });
+            }
+        }
+        for (const auto& e : errors) {
+            if (e) std::rethrow_exception(e);
+        }
+
+        iterations_ = chunk_end;
+        if (checkpoints && iterations_ % options_.checkpoint_every == 0) {
+            saveCheckpoint(options_.checkpoint_path);
+            if (options_.on_checkpoint) options_.on_checkpoint(iterations_);
+        }
+    }
+}
+
+inline std::vector<double> MCCFRSolver::averageStrategy(size_t index, uint32_t bucket) const {
+    if (index >= tree_.size() || tree_.node(index).type != TreeNode::Type::Action)
+        throw std::invalid_argument("Strategy is only defined at action nodes");
+    const TreeNode& node = tree_.node(index);
+    if (bucket >= abstraction_.num_buckets[node.board_size - 3])
+        throw std::out_of_range("Bucket out of range for the node's street");
+
+    std::vector<double> strategy(node.num_children);
+    double total = 0.0;
+    for (size_t a = 0; a < strategy.size(); ++a) total += strategy[a] = strategy_sums_[slot(node, a, bucket)];
+    for (auto& s : strategy) s = total > 0.0 ? s / total : 1.0 / strategy.size();
+    return strategy;
+}
+
+inline uint32_t MCCFRSolver::bucket(size_t index, Core::CardMask hero, Core::CardMask board) const {
+    if (std::popcount(board) != tree_.node(index).board_size)
+        throw std::invalid_argument("Board does not match the node's street");
+    return abstraction_.bucket(hero, board);
+}
+
+inline void MCCFRSolver::saveCheckpoint(const std::string& path) const {
+    CheckpointHeader header{};
+    std::memcpy(header.magic, MAGIC.data(), MAGIC.size());
+    header.version = VERSION;
+    header.iterations = iterations_;
+    header.num_actions = tree_.numActions();
+    header.slots = slots_;
+
+    // written aside and renamed over the old checkpoint, so a crash never leaves a torn file
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot open file for writing: " + tmp);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(regrets_.data()), static_cast<std::streamsize>(regrets_.size() * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(strategy_sums_.data()), static_cast<std::streamsize>(strategy_sums_.size() * sizeof(double)));
+        if (!out) throw std::runtime_error("Failed writing checkpoint: " + tmp);
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+inline void MCCFRSolver::loadCheckpoint(const std::string& path) {
+    const Core::detail::MappedFile file(path);
+    CheckpointHeader header{};
+    if (file.size() < sizeof(header))
+        throw std::runtime_error("Checkpoint file is truncated: " + path);
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC.data(), MAGIC.size()) != 0 || header.version != VERSION)
+        throw std::runtime_error("Not a compatible checkpoint: " + path);
+    if (header.num_actions != tree_.numActions() || header.slots != slots_)
+        throw std::runtime_error("Checkpoint was written for a different tree or abstraction: " + path);
+
+    const size_t bytes = regrets_.size() * sizeof(double);
+    if (file.size() != sizeof(header) + 2 * bytes)
+        throw std::runtime_error("Checkpoint file has unexpected size: " + path);
+    std::memcpy(regrets_.data(), file.data() + sizeof(header), bytes);
+    std::memcpy(strategy_sums_.data(), file.data() + sizeof(header) + bytes, bytes);
+    iterations_ = header.iterations;
+}
+
+}
+
+#endif
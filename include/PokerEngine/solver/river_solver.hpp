@@ -0,0 +1,413 @@
+#ifndef POKER_ENGINE_SOLVER_RIVER_SOLVER_HPP
+#define POKER_ENGINE_SOLVER_RIVER_SOLVER_HPP
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/range.hpp"
+#include "PokerEngine/core/board.hpp"
+#include "PokerEngine/simulator/river_sweep.hpp"
+#include "PokerEngine/solver/game_tree.hpp"
+
+namespace PokerEngine::Solver {
+
+using RiverSolverConfig = BetSizing;
+using RiverNode = TreeNode;
+
+/**
+ * @brief Heads up river subgame solved with vectorised CFR+.
+ *
+ * The betting tree is a river only GameTree. Every action node
+ * owns one contiguous (actions x hands) block in the regret and strategy sum arrays, and each
+ * traversal handles all combos of a player at once. Showdowns use a RiverSweep per player built
+ * once, so a terminal costs O(n + m) rather than a pass over every combo pair.
+ *
+ * Payoffs are chips won from the pot net of the player's own river commitment, so the two
+ * players' payoffs always sum to the starting pot.
+ */
+class RiverSolver {
+public:
+    /**
+     * @param oop_range Range of the player first to act
+     * @param pot Chips in the pot at the start of the river
+     */
+    RiverSolver(const Core::Range& oop_range, const Core::Range& ip_range, const Core::Board& board,
+                int pot, int oop_stack, int ip_stack, RiverSolverConfig config = {});
+
+    /**
+     * @brief Run CFR+ iterations until max_iterations, or until exploitability is at most
+     * target_fraction of the pot. Exploitability is measured every check_every iterations.
+     * @param on_check Called with (iterations run, exploitability in chips) at each measurement
+     * @return Exploitability in chips after the last iteration
+     */
+    double solve(int max_iterations, double target_fraction = 0.0, int check_every = 25,
+                 const std::function<void(int, double)>& on_check = {});
+
+    /**
+     * @brief Mean of the two players' best response gains against the average strategy, in chips
+     */
+    double exploitability() const;
+
+    int iterations() const noexcept { return iterations_; }
+    int pot() const noexcept { return pot_; }
+
+    std::span<const RiverNode> nodes() const noexcept { return tree_.nodes(); }
+    const RiverNode& root() const noexcept { return tree_.root(); }
+    const GameTree& tree() const noexcept { return tree_; }
+
+    /**
+     * @brief Hands of a player not blocked by the board, the order used by every per hand array
+     */
+    const std::vector<Core::CardMask>& hands(int player) const noexcept { return hands_[player]; }
+
+    /**
+     * @brief Average strategy at an action node, (num_children x hands) row major by action
+     */
+    std::vector<double> averageStrategy(size_t node) const;
+
+    /**
+     * @brief EV in chips of each hand of player against the opponent's average strategy when both play
+     * it, i.e. per live opposing combo. Hands with no live opposing combo have 0.
+     */
+    std::vector<double> expectedValues(int player) const;
+
+private:
+    using Values = std::vector<double>;
+
+    // buffers of one level of the CFR recursion, reused across nodes and iterations
+    struct Scratch {
+        Values strategy;
+        Values child_values;
+        Values action_values;
+        Values reach;
+    };
+
+    void cfr(size_t node, int player, const Values& opponent_reach, Values& values, double weight, size_t depth = 0);
+    void bestResponse(size_t node, int player, const Values& opponent_reach, Values& values) const;
+    void averageStrategyInto(size_t node, Values& strategy) const;
+
+    void liveWeight(int player, const Values& opponent_reach, Values& live) const;
+    void terminalValues(const RiverNode& node, int player, const Values& opponent_reach, Values& values) const;
+
+    // weights_ is filled while hands_ is initialised, so it is declared first
+    std::array<std::vector<double>, 2> weights_;
+    std::array<std::vector<Core::CardMask>, 2> hands_;
+    std::array<std::vector<std::array<uint8_t, 2>>, 2> cards_;
+    std::array<std::vector<int32_t>, 2> same_combo_; // index of the identical combo in the opponent's hands or -1
+    std::array<Simulator::RiverSweep, 2> sweeps_;
+
+    int pot_;
+    GameTree tree_;
+    std::vector<size_t> offsets_; // per node, start of its (num_children x hands) slice of the arrays below
+    std::vector<double> regrets_;
+    std::vector<double> strategy_sums_;
+    std::vector<Scratch> scratch_; // one per tree depth, sized for the largest node at that depth
+    int iterations_ = 0;
+};
+
+namespace detail {
+    inline Simulator::RiverSweep make_sweep(const std::vector<Core::CardMask>& hands,
+                                            const std::vector<Core::CardMask>& opponents, Core::CardMask board)
+    {
+        if (std::popcount(board) != Simulator::detail::MAX_BOARD_SIZE_NLH)
+            throw std::invalid_argument("River solver needs a complete board");
+        return Simulator::RiverSweep{hands, opponents, board};
+    }
+
+    inline GameTree river_tree(int pot, int oop_stack, int ip_stack, BetSizing sizing) {
+        GameTreeConfig config{};
+        config.board_size = Simulator::detail::MAX_BOARD_SIZE_NLH;
+        config.pot = pot;
+        config.stacks = {oop_stack, ip_stack};
+        config.streets[2] = std::move(sizing);
+        return GameTree{config};
+    }
+}
+
+inline RiverSolver::RiverSolver(const Core::Range& oop_range, const Core::Range& ip_range, const Core::Board& board,
+                                int pot, int oop_stack, int ip_stack, RiverSolverConfig config)
+    : hands_{Simulator::detail::live_hands(oop_range, Core::cardsMask(board.get()), weights_[0]),
+             Simulator::detail::live_hands(ip_range, Core::cardsMask(board.get()), weights_[1])},
+      sweeps_{detail::make_sweep(hands_[0], hands_[1], Core::cardsMask(board.get())),
+              detail::make_sweep(hands_[1], hands_[0], Core::cardsMask(board.get()))},
+      pot_(pot), tree_(detail::river_tree(pot, oop_stack, ip_stack, std::move(config)))
+{
+    if (hands_[0].empty() || hands_[1].empty())
+        throw std::invalid_argument("Both ranges need a combo not blocked by the board");
+
+    for (int p = 0; p < 2; ++p) {
+        std::array<int32_t, Core::NUM_COMBOS> index_of{};
+        index_of.fill(-1);
+        for (size_t i = 0; i < hands_[1 - p].size(); ++i) {
+            const Core::CardMask m = hands_[1 - p][i];
+            index_of[Core::comboIndex(std::countr_zero(m), 63 - std::countl_zero(m))] = static_cast<int32_t>(i);
+        }
+        for (const Core::CardMask m : hands_[p]) {
+            const int low = std::countr_zero(m), high = 63 - std::countl_zero(m);
+            cards_[p].push_back({static_cast<uint8_t>(low), static_cast<uint8_t>(high)});
+            same_combo_[p].push_back(index_of[Core::comboIndex(low, high)]);
+        }
+    }
+
+    size_t offset = 0;
+    offsets_.assign(tree_.size(), 0);
+    for (size_t i = 0; i < tree_.size(); ++i) {
+        const auto& node = tree_.node(i);
+        if (node.type != RiverNode::Type::Action) continue;
+        offsets_[i] = offset;
+        offset += node.num_children * hands_[node.player].size();
+    }
+    regrets_.assign(offset, 0.0);
+    strategy_sums_.assign(offset, 0.0);
+
+    // children are stored after their parent, so one forward pass assigns every depth
+    std::vector<size_t> depth(tree_.size(), 0);
+    const size_t max_hands = std::max(hands_[0].size(), hands_[1].size());
+    for (size_t i = 0; i < tree_.size(); ++i) {
+        const auto& node = tree_.node(i);
+        if (node.type != RiverNode::Type::Action) continue;
+        for (size_t c = 0; c < node.num_children; ++c) depth[node.first_child + c] = depth[i] + 1;
+        if (scratch_.size() <= depth[i]) scratch_.resize(depth[i] + 1);
+        Scratch& scratch = scratch_[depth[i]];
+        const size_t block = node.num_children * hands_[node.player].size();
+        scratch.strategy.reserve(std::max(scratch.strategy.capacity(), block));
+        scratch.action_values.reserve(std::max(scratch.action_values.capacity(), block));
+        scratch.child_values.reserve(max_hands);
+        scratch.reach.reserve(max_hands);
+    }
+}
+
+inline void RiverSolver::liveWeight(int player, const Values& opponent_reach, Values& live) const {
+    double total = 0.0;
+    std::array<double, Core::NUM_CARDS> card_total{};
+    const auto& opp_cards = cards_[1 - player];
+    for (size_t o = 0; o < opponent_reach.size(); ++o) {
+        total += opponent_reach[o];
+        card_total[opp_cards[o][0]] += opponent_reach[o];
+        card_total[opp_cards[o][1]] += opponent_reach[o];
+    }
+
+    const auto& cards = cards_[player];
+    const auto& same = same_combo_[player];
+    live.resize(cards.size());
+    for (size_t h = 0; h < cards.size(); ++h) {
+        // inclusion-exclusion, the identical combo was removed once per card
+        live[h] = total - card_total[cards[h][0]] - card_total[cards[h][1]] + (same[h] >= 0 ? opponent_reach[same[h]] : 0.0);
+    }
+}
+
+inline void RiverSolver::terminalValues(const RiverNode& node, int player, const Values& opponent_reach, Values& values) const {
+    const int opp = 1 - player;
+    const size_t n = hands_[player].size();
+    values.resize(n);
+
+    if (node.type == RiverNode::Type::Fold) {
+        liveWeight(player, opponent_reach, values);
+        const double payoff = node.player == player ? -node.commit[player] : pot_ + node.commit[opp];
+        for (auto& v : values) v *= payoff;
+        return;
+    }
+
+    Values beats(n), ties(n), live(n);
+    sweeps_[player].showdown(opponent_reach, beats, ties, live);
+    const double win = pot_ + node.commit[opp];
+    const double tie = (pot_ + node.commit[0] + node.commit[1]) / 2.0 - node.commit[player];
+    const double loss = -node.commit[player];
+    for (size_t h = 0; h < n; ++h) {
+        values[h] = win * beats[h] + tie * ties[h] + loss * (live[h] - beats[h] - ties[h]);
+    }
+}
+
+inline void RiverSolver::cfr(size_t index, int player, const Values& opponent_reach, Values& values, double weight, size_t depth) {
+    const RiverNode& node = tree_.node(index);
+    if (node.type != RiverNode::Type::Action) {
+        terminalValues(node, player, opponent_reach, values);
+        return;
+    }
+
+    const size_t actions = node.num_children;
+    const size_t n = hands_[node.player].size();
+    double* regret = regrets_.data() + offsets_[index];
+    Scratch& scratch = scratch_[depth];
+
+    // regret matching+ over the node's contiguous block
+    Values& strategy = scratch.strategy;
+    strategy.resize(actions * n);
+    for (size_t h = 0; h < n; ++h) {
+        double sum = 0.0;
+        for (size_t a = 0; a < actions; ++a) sum += regret[a * n + h];
+        for (size_t a = 0; a < actions; ++a) strategy[a * n + h] = sum > 0.0 ? regret[a * n + h] / sum : 1.0 / actions;
+    }
+
+    values.assign(hands_[player].size(), 0.0);
+    Values& child_values = scratch.child_values;
+
+    if (node.player == player) {
+        Values& action_values = scratch.action_values;
+        action_values.resize(actions * n);
+        for (size_t a = 0; a < actions; ++a) {
+            cfr(node.first_child + a, player, opponent_reach, child_values, weight, depth + 1);
+            std::copy(child_values.begin(), child_values.end(), action_values.begin() + a * n);
+            for (size_t h = 0; h < n; ++h) values[h] += strategy[a * n + h] * child_values[h];
+        }
+        for (size_t a = 0; a < actions; ++a) {
+            for (size_t h = 0; h < n; ++h) {
+                regret[a * n + h] = std::max(regret[a * n + h] + action_values[a * n + h] - values[h], 0.0);
+            }
+        }
+        return;
+    }
+
+    double* sums = strategy_sums_.data() + offsets_[index];
+    Values& reach = scratch.reach;
+    reach.resize(n);
+    for (size_t a = 0; a < actions; ++a) {
+        for (size_t h = 0; h < n; ++h) {
+            reach[h] = opponent_reach[h] * strategy[a * n + h];
+            sums[a * n + h] += weight * reach[h];
+        }
+        cfr(node.first_child + a, player, reach, child_values, weight, depth + 1);
+        for (size_t h = 0; h < values.size(); ++h) values[h] += child_values[h];
+    }
+}
+
+inline void RiverSolver::averageStrategyInto(size_t index, Values& strategy) const {
+    const RiverNode& node = tree_.node(index);
+    const size_t actions = node.num_children;
+    const size_t n = hands_[node.player].size();
+    const double* sums = strategy_sums_.data() + offsets_[index];
+
+    strategy.resize(actions * n);
+    for (size_t h = 0; h < n; ++h) {
+        double total = 0.0;
+        for (size_t a = 0; a < actions; ++a) total += sums[a * n + h];
+        for (size_t a = 0; a < actions; ++a) strategy[a * n + h] = total > 0.0 ? sums[a * n + h] / total : 1.0 / actions;
+    }
+}
+
+inline std::vector<double> RiverSolver::averageStrategy(size_t node) const {
+    if (node >= tree_.size() || tree_.node(node).type != RiverNode::Type::Action)
+        throw std::invalid_argument("Strategy is only defined at action nodes");
+    Values strategy;
+    averageStrategyInto(node, strategy);
+    return strategy;
+}
+
+inline void RiverSolver::bestResponse(size_t index, int player, const Values& opponent_reach, Values& values) const {
+    const RiverNode& node = tree_.node(index);
+    if (node.type != RiverNode::Type::Action) {
+        terminalValues(node, player, opponent_reach, values);
+        return;
+    }
+
+    const size_t actions = node.num_children;
+    Values child_values;
+
+    if (node.player == player) {
+        values.assign(hands_[player].size(), -std::numeric_limits<double>::infinity());
+        for (size_t a = 0; a < actions; ++a) {
+            bestResponse(node.first_child + a, player, opponent_reach, child_values);
+            for (size_t h = 0; h < values.size(); ++h) values[h] = std::max(values[h], child_values[h]);
+        }
+        return;
+    }
+
+    Values strategy;
+    averageStrategyInto(index, strategy);
+    const size_t n = hands_[node.player].size();
+    values.assign(hands_[player].size(), 0.0);
+    Values reach(n);
+    for (size_t a = 0; a < actions; ++a) {
+        for (size_t h = 0; h < n; ++h) reach[h] = opponent_reach[h] * strategy[a * n + h];
+        bestResponse(node.first_child + a, player, reach, child_values);
+        for (size_t h = 0; h < values.size(); ++h) values[h] += child_values[h];
+    }
+}
+
+inline double RiverSolver::exploitability() const {
+    double best_response_total = 0.0;
+    for (int p = 0; p < 2; ++p) {
+        Values values, live;
+        bestResponse(0, p, weights_[1 - p], values);
+        liveWeight(p, weights_[1 - p], live);
+
+        // values are summed over opposing combos, normalise by the weight of all live pairs
+        double value = 0.0, pairs = 0.0;
+        for (size_t h = 0; h < values.size(); ++h) {
+            value += weights_[p][h] * values[h];
+            pairs += weights_[p][h] * live[h];
+        }
+        best_response_total += pairs > 0.0 ? value / pairs : 0.0;
+    }
+    return (best_response_total - pot_) / 2.0;
+}
+
+inline double RiverSolver::solve(int max_iterations, double target_fraction, int check_every,
+                                 const std::function<void(int, double)>& on_check)
+{
+    Values values;
+    double exploit = exploitability();
+    check_every = std::max(check_every, 1);
+
+    for (int i = 0; i < max_iterations; ++i) {
+        ++iterations_;
+        // alternating updates, later iterations weigh more in the average (CFR+ linear averaging)
+        for (int p = 0; p < 2; ++p) cfr(0, p, weights_[1 - p], values, iterations_);
+
+        if ((i + 1) % check_every == 0 || i + 1 == max_iterations) {
+            exploit = exploitability();
+            if (on_check) on_check(iterations_, exploit);
+            if (exploit <= target_fraction * pot_) break;
+        }
+    }
+    return exploit;
+}
+
+inline std::vector<double> RiverSolver::expectedValues(int player) const {
+    if (player != 0 && player != 1) throw std::invalid_argument("Player is 0 or 1");
+
+    // evaluate the average profile: best response machinery with the player's own average strategy
+    std::function<void(size_t, const Values&, Values&)> walk = [&](size_t index, const Values& opponent_reach, Values& values) {
+        const RiverNode& node = tree_.node(index);
+        if (node.type != RiverNode::Type::Action) {
+            terminalValues(node, player, opponent_reach, values);
+            return;
+        }
+        Values strategy, child_values;
+        averageStrategyInto(index, strategy);
+        const size_t n = hands_[node.player].size();
+        values.assign(hands_[player].size(), 0.0);
+
+        if (node.player == player) {
+            for (size_t a = 0; a < node.num_children; ++a) {
+                walk(node.first_child + a, opponent_reach, child_values);
+                for (size_t h = 0; h < n; ++h) values[h] += strategy[a * n + h] * child_values[h];
+            }
+            return;
+        }
+        Values reach(n);
+        for (size_t a = 0; a < node.num_children; ++a) {
+            for (size_t h = 0; h < n; ++h) reach[h] = opponent_reach[h] * strategy[a * n + h];
+            walk(node.first_child + a, reach, child_values);
+            for (size_t h = 0; h < values.size(); ++h) values[h] += child_values[h];
+        }
+    };
+
+    Values values, live;
+    walk(0, weights_[1 - player], values);
+    liveWeight(player, weights_[1 - player], live);
+    for (size_t h = 0; h < values.size(); ++h) values[h] = live[h] > 1e-12 ? values[h] / live[h] : 0.0;
+    return values;
+}
+
+}
+
+#endif
@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <memory>
+#include <fstream>
+#include <thread>
 
 #include <cxxopts.hpp>
 
@@ -13,6 +16,7 @@
 #include "PokerEngine/core/factory/deck_factory.hpp"
 #include "PokerEngine/simulator/poker_simulator.hpp"
 #include "PokerEngine/simulator/monte_carlo_strategy.hpp"
+#include "PokerEngine/simulator/query_lines.hpp"
 
 using namespace PokerEngine;
 using namespace PokerEngine::Core;
@@ -27,10 +31,12 @@ struct SimulationStats {
 SimulationStats run_simulation(const Range& hero_range,
                                 const Range& villain_range,
                                 const Board& board,
-                                int iterations)
+                                int iterations,
+                                std::shared_ptr<const Simulator::PreflopEquityTable> preflop_table = nullptr,
+                                Deck deck = Factory::DeckFactory::createStandardDeck())
 {
-    auto deck = Factory::DeckFactory::createStandardDeck();
-    Simulator::PokerSimulator sim{ hero_range, Board{board}, 1, deck };
+    Simulator::PokerSimulator sim{ hero_range, Board{board}, 1, std::move(deck) };
+    sim.usePreflopTable(std::move(preflop_table));
     Simulator::MonteCarloNLHStrategy solver{};
 
     auto start = std::chrono::high_resolution_clock::now();
@@ -77,10 +83,62 @@ Range parse_range(const std::string& s) {
     return range;
 }
 
+Range parse_single_hand(const std::string& s) {
+    Hand cards = parse_hand(s);
+    if (cards.get().size() != 2) throw std::invalid_argument("A hand needs exactly two cards");
+    Range range;
+    range.addCombo(cards.get()[0], cards.get()[1]);
+    return range;
+}
+
+/**
+ * @brief Answer JSON lines equity queries from in, one result line per query in input order.
+ * The deck and preflop table are set up once, and each worker keeps the ranges it has parsed,
+ * since batches tend to repeat the same few ranges.
+ */
+int run_batch(std::istream& in, unsigned threads, size_t max_in_flight,
+              std::shared_ptr<const Simulator::PreflopEquityTable> preflop_table)
+{
+    std::ios::sync_with_stdio(false);
+    const Deck deck = Factory::DeckFactory::createStandardDeck();
+
+    auto answer = [&](std::string_view line) -> std::string {
+        thread_local Simulator::RangeCache ranges;
+        auto range_of = [&](const std::string& hand, const std::string& range, const char* who) {
+            if (hand.empty() == range.empty())
+                throw std::invalid_argument(std::string("Exactly one of ") + who + " and " + who + "_range must be given");
+            const std::string key = (hand.empty() ? "r:" : "h:") + (hand.empty() ? range : hand);
+            return ranges.get(key, [&] { return hand.empty() ? parse_range(range) : parse_single_hand(hand); });
+        };
+
+        Simulator::EquityQuery query;
+        try {
+            query = Simulator::parseEquityQuery(line);
+            // shared, so the villain lookup dropping the cache cannot free the hero's range
+            const auto hero_range = range_of(query.hero, query.hero_range, "hero");
+            const auto villain_range = range_of(query.villain, query.villain_range, "villain");
+            const int iterations = query.trials();
+            const auto stats = run_simulation(*hero_range, *villain_range, parse_board(query.board), iterations, preflop_table, deck);
+
+            Simulator::SimResult result{};
+            result.win = stats.win;
+            result.tie = stats.tie;
+            result.loss = stats.loss;
+            return Simulator::formatEquityResult(query, result, iterations);
+        } catch (const std::exception& e) {
+            return Simulator::formatEquityError(query.id, e.what());
+        }
+    };
+
+    Simulator::answerLinesInOrder(in, std::cout, answer, threads, max_in_flight);
+    return 0;
+}
+
 void printUsageInfo(const std::string& program_name) {
     std::cerr << "Usage: " << program_name << " [--hero HERO_HAND | --hero-range HERO_RANGE] [--villain VILLAIN_HAND | --villain-range VILLAIN_RANGE] --board BOARD --iterations N\n";
     std::cerr << "Example (single hands): ./app --hero AsAd --villain KdKh --board Ad --iterations 100000\n";
     std::cerr << "Example (ranges): ./app --hero-range \"AsAd,AcAh\" --villain-range \"KdKh,KcKs\" --board Ad --iterations 100000\n";
+    std::cerr << "Example (batch): ./app --batch queries.jsonl > results.jsonl\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -93,6 +151,10 @@ int main(int argc, char* argv[]) {
         ("hero-range", "Hero range e.g. TT,AT+", cxxopts::value<std::string>())
         ("villain-range", "Villain range e.g. TT,AT+", cxxopts::value<std::string>())
         ("iterations", "Iterations for simulation", cxxopts::value<int>()->default_value("10000"))
+        ("preflop-table", "Precomputed preflop equity table, used for pre-flop queries", cxxopts::value<std::string>())
+        ("batch", "Answer JSON lines queries from a file, - for stdin", cxxopts::value<std::string>())
+        ("threads", "Worker threads for --batch", cxxopts::value<unsigned>()->default_value(std::to_string(std::thread::hardware_concurrency())))
+        ("max-in-flight", "Queries read ahead of the output for --batch", cxxopts::value<size_t>()->default_value("1024"))
         ("h,help", "Print usage");
 
     auto args = options.parse(argc, argv);
@@ -104,6 +166,30 @@ int main(int argc, char* argv[]) {
         exit(0);
     }
 
+    if (args.count("batch")) {
+        try {
+            std::shared_ptr<const Simulator::PreflopEquityTable> preflop_table;
+            if (args.count("preflop-table")) {
+                preflop_table = std::make_shared<const Simulator::PreflopEquityTable>(args["preflop-table"].as<std::string>());
+            }
+
+            const std::string path = args["batch"].as<std::string>();
+            const unsigned threads = args["threads"].as<unsigned>();
+            const size_t max_in_flight = args["max-in-flight"].as<size_t>();
+            if (path == "-") return run_batch(std::cin, threads, max_in_flight, preflop_table);
+
+            std::ifstream file(path);
+            if (!file) {
+                std::cerr << "Error: cannot open " << path << "\n";
+                return 1;
+            }
+            return run_batch(file, threads, max_in_flight, preflop_table);
+        } catch (const std::exception& e) {
+            std::cerr << "Batch error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
     bool hero_defined_once = args.count("hero") ^ args.count("hero-range");
     bool villain_defined_once = args.count("villain") ^ args.count("villain-range");
 
@@ -136,7 +222,12 @@ int main(int argc, char* argv[]) {
     int iterations = args["iterations"].as<int>();
 
     try {
-        auto stats = run_simulation(hero_range, villain_range, board, iterations);
+        std::shared_ptr<const Simulator::PreflopEquityTable> preflop_table;
+        if (args.count("preflop-table")) {
+            preflop_table = std::make_shared<const Simulator::PreflopEquityTable>(args["preflop-table"].as<std::string>());
+        }
+
+        auto stats = run_simulation(hero_range, villain_range, board, iterations, preflop_table);
 
         std::cout << std::fixed << std::setprecision(4);
         std::cout << "=== Monte Carlo Simulation ===\n";
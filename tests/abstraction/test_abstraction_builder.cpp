@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <filesystem>
+
+#include "PokerEngine/abstraction/abstraction_builder.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    // jacks to aces in every suit, small enough to build an abstraction in a test
+    CardMask smallDeck() {
+        CardMask deck = 0;
+        for (int suit = 0; suit < 4; ++suit) {
+            for (int rank = 9; rank < 13; ++rank) deck |= CardMask{1} << (suit * 13 + rank);
+        }
+        return deck;
+    }
+
+    CardMask mask(std::vector<Card> cards) { return cardsMask(cards); }
+
+    std::string tempPath(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(AbstractionBuilder, EnumeratesOneSituationPerIsomorphismClass) {
+    const CardMask deck = smallDeck();
+    std::set<uint64_t> expected;
+    Simulator::detail::for_each_subset(deck, 3, [&](CardMask board) {
+        Simulator::detail::for_each_subset(deck & ~board, 2, [&](CardMask hero) {
+            expected.insert(Abstraction::canonicalSituationKey(board, hero));
+        });
+    });
+
+    std::set<uint64_t> enumerated;
+    size_t calls = 0;
+    uint64_t previous = 0;
+    Abstraction::forEachCanonicalSituation(deck, 3, [&](CardMask board, CardMask hero) {
+        ++calls;
+        const uint64_t key = Abstraction::situationKey(board, hero);
+        EXPECT_EQ(key, Abstraction::canonicalSituationKey(board, hero));
+        // keys arrive sorted, so the builder can stream them to the table
+        EXPECT_GT(key, previous);
+        previous = key;
+        enumerated.insert(key);
+    });
+
+    EXPECT_EQ(calls, expected.size());
+    EXPECT_EQ(enumerated, expected);
+}
+
+TEST(AbstractionBuilder, RejectsAsymmetricDeck) {
+    EXPECT_THROW(Abstraction::forEachCanonicalSituation(smallDeck() & ~cardMask("As"_c), 3, [](CardMask, CardMask) {}),
+                 std::invalid_argument);
+}
+
+TEST(AbstractionBuilder, KMeansSeparatesDistinctGroups) {
+    std::vector<float> points;
+    for (int i = 0; i < 300; ++i) {
+        const float centre = static_cast<float>(i % 3) * 10.0f;
+        points.push_back(centre + 0.01f * (i % 7));
+        points.push_back(centre - 0.01f * (i % 5));
+    }
+
+    auto result = Abstraction::detail::kmeans(points.data(), 300, 2, 3, 50, 0.0, 4, 7);
+    for (int i = 3; i < 300; ++i) EXPECT_EQ(result.assignment[i], result.assignment[i % 3]);
+    EXPECT_NE(result.assignment[0], result.assignment[1]);
+    EXPECT_NE(result.assignment[1], result.assignment[2]);
+    EXPECT_NE(result.assignment[0], result.assignment[2]);
+}
+
+TEST(AbstractionBuilder, BuildsTableWithLookupForEverySuitLabelling) {
+    const std::string path = tempPath("poker_engine_test_buckets.bin");
+    Abstraction::AbstractionOptions options{};
+    options.deck = smallDeck();
+    options.board_size = 4;
+    options.num_buckets = 8;
+    options.bins = 10;
+    options.threads = 4;
+
+    const auto stats = Abstraction::buildAbstraction(path, options);
+    EXPECT_FALSE(std::filesystem::exists(path + ".features"));
+
+    Abstraction::BucketTable table{path};
+    EXPECT_EQ(table.size(), stats.situations);
+    EXPECT_GT(stats.iterations, 0);
+    EXPECT_EQ(table.boardSize(), 4);
+    EXPECT_EQ(table.numBuckets(), 8);
+    for (auto b : table.buckets()) EXPECT_LT(b, 8);
+
+    // suit relabellings share a bucket
+    const auto a = table.bucket(mask({"Ah"_c, "Kh"_c}), mask({"Qh"_c, "Jh"_c, "Jc"_c, "Ks"_c}));
+    const auto b = table.bucket(mask({"Ad"_c, "Kd"_c}), mask({"Qd"_c, "Jd"_c, "Js"_c, "Kc"_c}));
+    EXPECT_EQ(a, b);
+
+    // quads and a board-playing weak kicker cannot share a bucket
+    EXPECT_NE(table.bucket(mask({"Ah"_c, "Ad"_c}), mask({"As"_c, "Ac"_c, "Kh"_c, "Qd"_c})),
+              table.bucket(mask({"Jc"_c, "Jd"_c}), mask({"Ah"_c, "Ad"_c, "Kh"_c, "Ks"_c})));
+
+    EXPECT_THROW(table.bucket(mask({"Ah"_c, "Kh"_c}), mask({"Qh"_c, "Jh"_c, "Jc"_c})), std::out_of_range);
+    std::filesystem::remove(path);
+}
+
+TEST(AbstractionBuilder, BuildsRiverTable) {
+    const std::string path = tempPath("poker_engine_test_river_buckets.bin");
+    Abstraction::AbstractionOptions options{};
+    options.deck = smallDeck();
+    options.board_size = 5;
+    options.num_buckets = 4;
+    options.threads = 2;
+
+    const auto stats = Abstraction::buildAbstraction(path, options);
+    Abstraction::BucketTable table{path};
+    EXPECT_EQ(table.size(), stats.situations);
+    EXPECT_TRUE(std::is_sorted(table.keys().begin(), table.keys().end()));
+    // quad jacks and the weakest two pair cannot share a bucket
+    const CardMask board = mask({"Ah"_c, "Kd"_c, "Qc"_c, "Jh"_c, "Js"_c});
+    EXPECT_NE(table.bucket(mask({"Jc"_c, "Jd"_c}), board), table.bucket(mask({"Ks"_c, "Qs"_c}), board));
+    std::filesystem::remove(path);
+}
+
+TEST(AbstractionBuilder, FailedBuildLeavesNoFiles) {
+    const std::string path = tempPath("poker_engine_test_failed_buckets.bin");
+    Abstraction::AbstractionOptions options{};
+    options.deck = smallDeck() & ~cardMask("As"_c);
+    options.num_buckets = 4;
+
+    EXPECT_THROW(Abstraction::buildAbstraction(path, options), std::invalid_argument);
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_FALSE(std::filesystem::exists(path + ".features"));
+}
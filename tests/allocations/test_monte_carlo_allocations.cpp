@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/monte_carlo_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+// Counts heap allocations made on the current thread while enabled. Replacing the global operators
+// affects the whole program, so this file builds into its own test executable.
+namespace {
+    thread_local bool counting_allocations = false;
+    thread_local size_t allocation_count = 0;
+}
+
+// out of line so the compiler does not pair the inlined malloc and free against new and delete
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    if (counting_allocations) ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    size_t allocationsFor(int iterations) {
+        Simulator::MonteCarloNLHStrategy strategy{Simulator::ResultMode::PerCombo};
+        auto deck = Factory::DeckFactory::createStandardDeck();
+        Range hero{"AKs"_r};
+        std::vector<Range> villains{Range{"QQ+"_r}, Range{"T9s"_r}};
+        Board board{{"2h"_c, "7d"_c, "9c"_c}};
+
+        allocation_count = 0;
+        counting_allocations = true;
+        strategy.run(hero, board, 2, deck, villains, iterations, 17);
+        counting_allocations = false;
+        return allocation_count;
+    }
+}
+
+TEST(MonteCarloAllocations, ZeroAllocationsPerTrial) {
+    const size_t setup = allocationsFor(10);
+    const size_t many = allocationsFor(200000);
+
+    EXPECT_EQ(many, setup) << "allocations must not grow with the number of trials";
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <set>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/suit_isomorphism.hpp"
+#include "PokerEngine/evaluator/detail/bit_mask.hpp"
+
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+TEST(CardMaskTest, MatchesEvaluatorLayout) {
+    for (int i = 0; i < NUM_CARDS; ++i) {
+        Card c = cardFromIndex(i);
+        EXPECT_EQ(cardIndex(c), i);
+        EXPECT_EQ(cardMask(c), PokerEngine::Evaluator::detail::card_bitmask(c));
+    }
+}
+
+TEST(CardMaskTest, ComboIndexIsDense) {
+    std::set<int> ids;
+    for (int a = 0; a < NUM_CARDS; ++a) {
+        for (int b = a + 1; b < NUM_CARDS; ++b) {
+            int id = comboIndex(a, b);
+            EXPECT_EQ(id, comboIndex(b, a));
+            EXPECT_EQ(comboCardsFromIndex(id), std::make_pair(a, b));
+            ids.insert(id);
+        }
+    }
+    EXPECT_EQ(ids.size(), NUM_COMBOS);
+    EXPECT_EQ(*ids.rbegin(), NUM_COMBOS - 1);
+}
+
+TEST(SuitIsomorphismTest, IsomorphicSituationsShareCanonicalForm) {
+    // AsKs vs QhQd on 2c7c9d is isomorphic to AhKh vs QsQc on 2d7d9c
+    std::array<CardMask, 3> lhs{
+        cardsMask({"2c"_c, "7c"_c, "9d"_c}), cardsMask({"As"_c, "Ks"_c}), cardsMask({"Qh"_c, "Qd"_c})
+    };
+    std::array<CardMask, 3> rhs{
+        cardsMask({"2d"_c, "7d"_c, "9c"_c}), cardsMask({"Ah"_c, "Kh"_c}), cardsMask({"Qs"_c, "Qc"_c})
+    };
+    EXPECT_EQ(canonicalise(lhs), canonicalise(rhs));
+
+    std::array<CardMask, 3> different{
+        cardsMask({"2c"_c, "7c"_c, "9d"_c}), cardsMask({"Ac"_c, "Kc"_c}), cardsMask({"Qh"_c, "Qd"_c})
+    };
+    EXPECT_NE(canonicalise(lhs), canonicalise(different));
+}
+
+TEST(SuitIsomorphismTest, PreservesCardCount) {
+    CardMask mask = cardsMask({"Ah"_c, "Kd"_c, "2c"_c, "2s"_c});
+    for (const auto& perm : SUIT_PERMUTATIONS) {
+        EXPECT_EQ(std::popcount(permuteSuits(mask, perm)), 4);
+    }
+}
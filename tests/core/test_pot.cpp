@@ -30,4 +30,24 @@ TEST(Pot, GettingWinningsFromPotSidePotInvolved) {
     int p2_winnings = pot.getWinningsForPlayer(Pot::PlayerId{2});
     ASSERT_EQ(p2_winnings, 200);
     ASSERT_TRUE(pot.empty());
-}
\ No newline at end of file
+}
+
+TEST(Pot, SidePotsLayerLiveContributions) {
+    Pot pot;
+    pot.addContribution(Pot::PlayerId{1}, 100);
+    pot.addContribution(Pot::PlayerId{2}, 300);
+    pot.addContribution(Pot::PlayerId{3}, 300);
+    pot.addContribution(Pot::PlayerId{4}, 150); // folded
+    pot.addContribution(Pot::PlayerId{5}, 20);  // folded
+
+    const std::vector<Pot::PlayerId> live{1, 2, 3};
+    const auto pots = pot.sidePots(live);
+    ASSERT_EQ(pots.size(), 2u);
+    EXPECT_EQ(pots[0].amount, 420);
+    EXPECT_EQ(pots[0].eligible, (std::vector<Pot::PlayerId>{1, 2, 3}));
+    EXPECT_EQ(pots[1].amount, 450);
+    EXPECT_EQ(pots[1].eligible, (std::vector<Pot::PlayerId>{2, 3}));
+    EXPECT_EQ(pot.getTotal(), 870);
+
+    EXPECT_TRUE(pot.sidePots(std::span<const Pot::PlayerId>{}).empty());
+}
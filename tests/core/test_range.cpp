@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <limits>
 #include <gtest/gtest.h>
 
 #include "PokerEngine/core/range.hpp"
@@ -91,4 +92,63 @@ TEST(RangeTest, FromToken) {
     std::sort(expected_combos.begin(),expected_combos.end());
 
     ASSERT_EQ(combo_from_token, expected_combos);
-}
\ No newline at end of file
+}
+
+TEST(RangeTest, ReweightIsBayesUpdate) {
+    Range r{"AKs"_r};
+    r.addCombo("Qs"_c, "Qh"_c, 2.0);
+    ASSERT_DOUBLE_EQ(r.totalWeight(), 6.0);
+
+    // suited AK always bets, QQ half the time
+    const std::vector<double> likelihood{1.0, 1.0, 1.0, 1.0, 0.5};
+    const double evidence = r.reweight(likelihood);
+    EXPECT_DOUBLE_EQ(evidence, 5.0 / 6.0);
+    EXPECT_DOUBLE_EQ(r.totalWeight(), 1.0);
+    EXPECT_DOUBLE_EQ(r.combos()[0].weight, 0.2);
+    EXPECT_DOUBLE_EQ(r.combos()[4].weight, 0.2);
+
+    // a callable likelihood, combos holding a heart never bet
+    auto has_heart = [](const PokerEngine::Core::Combo& c) {
+        return c.c1.suit() == PokerEngine::Core::Suit::Hearts || c.c2.suit() == PokerEngine::Core::Suit::Hearts;
+    };
+    r.reweight([&](const PokerEngine::Core::Combo& c) { return has_heart(c) ? 0.0 : 1.0; });
+    for (const auto& c : r.combos()) {
+        if (has_heart(c)) EXPECT_EQ(c.weight, 0.0);
+        else EXPECT_DOUBLE_EQ(c.weight, 1.0 / 3.0);
+    }
+
+    // impossible actions and malformed likelihoods leave the range as it was
+    const auto before = r.combos();
+    EXPECT_THROW(r.reweight(std::vector<double>(5, 0.0)), std::invalid_argument);
+    EXPECT_THROW(r.reweight(std::vector<double>(4, 1.0)), std::invalid_argument);
+    EXPECT_THROW(r.reweight(std::vector<double>{1.0, 1.0, -1.0, 1.0, 1.0}), std::invalid_argument);
+    for (size_t i = 0; i < before.size(); ++i) EXPECT_EQ(r.combos()[i].weight, before[i].weight);
+}
+
+TEST(RangeTest, SamplingFollowsWeightUpdates) {
+    std::mt19937 rng(7);
+    Range r{};
+    Card a{"Ah"}, b{"Kd"}, c{"Qs"}, d{"Jc"};
+    r.addCombo(a, b, 1.0);
+    r.addCombo(c, d, 1.0);
+
+    r.setWeight(0, 0.0);
+    for (int i = 0; i < 200; ++i) EXPECT_EQ(*r.sample(rng), PokerEngine::Core::Combo(c, d, 1.0));
+
+    r.setWeight(0, 3.0);
+    EXPECT_DOUBLE_EQ(r.totalWeight(), 4.0);
+    int count_ab = 0;
+    for (int i = 0; i < 10000; ++i) count_ab += *r.sample(rng) == PokerEngine::Core::Combo(a, b, 1.0);
+    EXPECT_NEAR(count_ab / 10000.0, 0.75, 0.02);
+
+    r.removeBlocked({a});
+    EXPECT_DOUBLE_EQ(r.totalWeight(), 1.0);
+    r.normalise();
+    EXPECT_DOUBLE_EQ(r.combos()[0].weight, 1.0);
+    EXPECT_THROW(r.setWeight(1, 1.0), std::out_of_range);
+    EXPECT_THROW(r.setWeight(0, -1.0), std::invalid_argument);
+    EXPECT_THROW(r.setWeight(0, std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+    EXPECT_THROW(r.setWeight(0, std::numeric_limits<double>::infinity()), std::invalid_argument);
+    // a rejected weight leaves the range as it was
+    EXPECT_DOUBLE_EQ(r.totalWeight(), 1.0);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/ev/bet_sizing.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+#include "PokerEngine/simulator/river_sweep.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+TEST(BetSizing, RiverEquityMatchesSweep) {
+    const Board board{{"Ah"_c, "Kd"_c, "7c"_c, "7s"_c, "2h"_c}};
+    Range hero{"AK"_r};
+    hero.addCombo("QQ"_r);
+    hero.addCombo("8h"_c, "9h"_c);
+    Range villain{"77"_r};
+    villain.addCombo("AQ"_r);
+    villain.addCombo("JJ"_r);
+
+    const EV::BetSizingOptimizer optimizer{hero, villain, board};
+    EXPECT_EQ(optimizer.runouts(), 1u);
+    const auto result = optimizer.evaluate(100.0, 1000.0);
+    const auto expected = Simulator::riverEquities(hero, villain, board).hero.equity;
+
+    size_t i = 0;
+    for (size_t h = 0; h < hero.size(); ++h) {
+        if (comboMask(hero.combos()[h]) & cardsMask(board.get())) continue;
+        ASSERT_LT(i, result.combos.size());
+        EXPECT_NEAR(result.combos[i].equity, expected[h], 1e-12);
+        EXPECT_NEAR(result.combos[i].check_ev, expected[h] * 100.0, 1e-9);
+        ++i;
+    }
+    EXPECT_EQ(i, result.combos.size());
+}
+
+TEST(BetSizing, NutsBetBigAndAirChecks) {
+    const Board board{{"Ah"_c, "Kd"_c, "7c"_c, "7s"_c, "2h"_c}};
+    Range hero{};
+    hero.addCombo("7h"_c, "7d"_c);
+    hero.addCombo("3c"_c, "4c"_c);
+    const Range villain{"QQ+"_r};
+
+    const EV::BetSizingOptimizer optimizer{hero, villain, board};
+
+    // against minimum defense a pure bluff breaks even, the nuts gains most from the largest size
+    auto result = optimizer.evaluate(100.0, 1000.0);
+    const auto& nuts = result.combos[0];
+    const auto& air = result.combos[1];
+    EXPECT_EQ(nuts.best, static_cast<int>(result.sizes.size()) - 1);
+    EXPECT_NEAR(nuts.best_ev, 100.0 + 200.0 / 3.0, 1e-9);
+    for (double ev : air.ev) EXPECT_NEAR(ev, 0.0, 1e-9);
+
+    // a villain who never folds makes every bluff lose its bet
+    EV::BetSizingOptions options{};
+    options.model = EV::FoldEquityModel::constant(0.0);
+    result = optimizer.evaluate(100.0, 1000.0, options);
+    EXPECT_EQ(result.combos[1].best, -1);
+    EXPECT_NEAR(result.combos[1].ev[0], -25.0, 1e-9);
+
+    // sizes beyond the stack go all in
+    result = optimizer.evaluate(100.0, 60.0, options);
+    EXPECT_DOUBLE_EQ(result.sizes.back(), 60.0);
+    EXPECT_NEAR(result.combos[0].best_ev, 100.0 + 60.0, 1e-9);
+}
+
+TEST(BetSizing, ContinuingRangeIsVillainsStrongest) {
+    const Board board{{"Ah"_c, "Kd"_c, "7c"_c, "7s"_c, "2h"_c}};
+    Range hero{};
+    hero.addCombo("Ac"_c, "Qc"_c);
+    Range villain{"AK"_r};
+    villain.addCombo("JJ"_r);
+
+    // 9 of the 15 combos continue: exactly the AK, which beat hero every time
+    EV::BetSizingOptions options{};
+    options.pot_fractions = {0.5};
+    options.model = EV::FoldEquityModel::constant(0.4);
+    const auto result = EV::BetSizingOptimizer{hero, villain, board}.evaluate(100.0, 1000.0, options);
+
+    const auto& combo = result.combos[0];
+    // hero's ace leaves 6 AK and 6 JJ, so hero sees half of villain's range fold
+    EXPECT_NEAR(result.continue_fraction[0], 0.6, 1e-12);
+    EXPECT_NEAR(combo.equity, 0.5, 1e-12);
+    EXPECT_NEAR(combo.ev[0], 0.5 * 100.0 + 0.5 * -50.0, 1e-9);
+}
+
+TEST(BetSizing, FlopEquityMatchesExactEnumeration) {
+    const Board flop{{"Ah"_c, "7d"_c, "2c"_c}};
+    Range hero{};
+    hero.addCombo("8h"_c, "9h"_c);
+    hero.addCombo("Kc"_c, "Kd"_c);
+    Range villain{"A9s+"_r};
+    villain.addCombo("77"_r);
+
+    const EV::BetSizingOptimizer optimizer{hero, villain, flop};
+    EXPECT_EQ(optimizer.runouts(), 1176u);
+    const auto result = optimizer.evaluate(100.0, 500.0);
+
+    const Simulator::ExactNLHStrategy exact{};
+    for (const auto& combo : result.combos) {
+        Range single{};
+        single.addCombo(combo.combo.c1, combo.combo.c2);
+        const auto expected = exact.run(single, flop, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+        EXPECT_NEAR(combo.equity, expected.win + expected.tie / 2.0, 1e-9);
+    }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "PokerEngine/ev/ev_calculator.hpp"
+#include "PokerEngine/ev/basic_poker_calc.hpp"
 
 using namespace PokerEngine::EV;
 
@@ -18,4 +19,40 @@ TEST(EVCalc, Test2) {
 
     double ev = calculateEV({wo1, wo2});
     ASSERT_DOUBLE_EQ(ev, 25);
-}
\ No newline at end of file
+}
+
+TEST(EVCalc, SpanAndArraysAgree) {
+    const std::vector<WeightedOutcome> outcomes{{0.25, 40.0}, {0.5, -10.0}, {0.25, 8.0}};
+    const std::vector<double> weights{0.25, 0.5, 0.25};
+    const std::vector<double> values{40.0, -10.0, 8.0};
+
+    ASSERT_DOUBLE_EQ(calculateEV(outcomes), 7.0);
+    ASSERT_DOUBLE_EQ(calculateEV(std::span<const WeightedOutcome>(outcomes).first(2)), 20.0 / 3.0);
+    ASSERT_DOUBLE_EQ(calculateEV(weights, values), 7.0);
+    ASSERT_DOUBLE_EQ(calculateEV(std::vector<double>{}, std::vector<double>{}), 0.0);
+    EXPECT_THROW(calculateEV(weights, std::vector<double>{1.0}), std::invalid_argument);
+}
+
+TEST(EVCalc, BatchMatchesScalar) {
+    std::vector<double> equity, pot, bet, call;
+    for (int i = 0; i < 1003; ++i) {
+        equity.push_back((i % 101) / 100.0);
+        pot.push_back(10.0 + i);
+        bet.push_back(0.5 * (10.0 + i));
+        call.push_back(0.25 * i);
+    }
+
+    std::vector<double> out(equity.size());
+    calcCallEV(equity, pot, bet, out);
+    for (size_t i = 0; i < out.size(); ++i) {
+        const double expected = calculateEV({{equity[i], pot[i] + bet[i]}, {1.0 - equity[i], -bet[i]}});
+        ASSERT_NEAR(out[i], expected, 1e-9);
+        ASSERT_DOUBLE_EQ(out[i], calcCallEV(equity[i], pot[i], bet[i]));
+    }
+
+    calcRaiseEV(equity, pot, bet, call, out);
+    for (size_t i = 0; i < out.size(); ++i) ASSERT_DOUBLE_EQ(out[i], calcRaiseEV(equity[i], pot[i], bet[i], call[i]));
+
+    EXPECT_THROW(calcCallEV(equity, pot, call, std::span<double>(out).first(3)), std::invalid_argument);
+    EXPECT_EQ(calcCallEV(0.5, 100, 50), 50.0);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "PokerEngine/ev/icm.hpp"
+
+using namespace PokerEngine::EV;
+
+namespace {
+    // Malmuth-Harville by enumerating every finishing order
+    std::vector<double> bruteForce(const std::vector<double>& stacks, const std::vector<double>& payouts) {
+        std::vector<size_t> order(stacks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<double> equity(stacks.size(), 0.0);
+        const double total = std::accumulate(stacks.begin(), stacks.end(), 0.0);
+        do {
+            double p = 1.0, left = total;
+            for (size_t place = 0; place < order.size(); ++place) {
+                p *= stacks[order[place]] / left;
+                left -= stacks[order[place]];
+            }
+            for (size_t place = 0; place < std::min(order.size(), payouts.size()); ++place) {
+                equity[order[place]] += p * payouts[place];
+            }
+        } while (std::next_permutation(order.begin(), order.end()));
+        return equity;
+    }
+}
+
+TEST(ICM, HeadsUpIsChipShare) {
+    const auto equity = icmEquity(std::vector<double>{75, 25}, {100, 0});
+    EXPECT_DOUBLE_EQ(equity[0], 75.0);
+    EXPECT_DOUBLE_EQ(equity[1], 25.0);
+}
+
+TEST(ICM, MatchesEveryFinishingOrder) {
+    const std::vector<double> stacks{5000, 3200, 2100, 1500, 900, 300, 4000};
+    const std::vector<double> payouts{50, 30, 20};
+    const auto equity = icmEquity(stacks, payouts);
+    const auto expected = bruteForce(stacks, payouts);
+
+    for (size_t i = 0; i < stacks.size(); ++i) EXPECT_NEAR(equity[i], expected[i], 1e-9);
+    EXPECT_NEAR(std::accumulate(equity.begin(), equity.end(), 0.0), 100.0, 1e-9);
+}
+
+TEST(ICM, MatchesEveryFinishingOrderWhenAllPlacesPay) {
+    const std::vector<double> stacks{700, 1200, 300, 2500, 900, 1600, 450, 1100};
+    const std::vector<double> payouts{30, 20, 15, 12, 9, 7, 4, 3};
+    const auto equity = icmEquity(stacks, payouts);
+    const auto expected = bruteForce(stacks, payouts);
+
+    for (size_t i = 0; i < stacks.size(); ++i) EXPECT_NEAR(equity[i], expected[i], 1e-9);
+}
+
+TEST(ICM, LargeFieldWithThreePaidPlaces) {
+    std::vector<double> stacks;
+    for (int i = 0; i < 24; ++i) stacks.push_back(500.0 + 137.0 * (i % 7) + 41.0 * i);
+    const std::vector<double> payouts{50, 30, 20};
+    ICMOptions options{};
+    options.max_exact_players = 24;
+    const auto equity = ICMCalculator{payouts, options}.equity(stacks);
+
+    // every ordered top three directly
+    const double total = std::accumulate(stacks.begin(), stacks.end(), 0.0);
+    std::vector<double> expected(stacks.size(), 0.0);
+    for (size_t a = 0; a < stacks.size(); ++a) {
+        const double pa = stacks[a] / total;
+        for (size_t b = 0; b < stacks.size(); ++b) {
+            if (b == a) continue;
+            const double pb = pa * stacks[b] / (total - stacks[a]);
+            for (size_t c = 0; c < stacks.size(); ++c) {
+                if (c == a || c == b) continue;
+                const double pc = pb * stacks[c] / (total - stacks[a] - stacks[b]);
+                expected[a] += pc * payouts[0];
+                expected[b] += pc * payouts[1];
+                expected[c] += pc * payouts[2];
+            }
+        }
+    }
+    for (size_t i = 0; i < stacks.size(); ++i) EXPECT_NEAR(equity[i], expected[i], 1e-9);
+}
+
+TEST(ICM, BustedPlayersShareTheBottomPlaces) {
+    const auto equity = icmEquity(std::vector<double>{100, 0, 0}, {60, 30, 10});
+    EXPECT_DOUBLE_EQ(equity[0], 60.0);
+    EXPECT_DOUBLE_EQ(equity[1], 20.0);
+    EXPECT_DOUBLE_EQ(equity[2], 20.0);
+
+    EXPECT_THROW(icmEquity(std::vector<double>{100, -1}, {60, 40}), std::invalid_argument);
+}
+
+TEST(ICM, MonteCarloApproximatesExact) {
+    std::vector<double> stacks;
+    for (int i = 0; i < 12; ++i) stacks.push_back(1000.0 + 350.0 * i);
+    const std::vector<double> payouts{40, 25, 15, 10, 6, 4};
+
+    const auto exact = ICMCalculator{payouts}.equity(stacks);
+    ICMOptions options{};
+    options.max_exact_players = 8;
+    options.trials = 400000;
+    const auto sampled = ICMCalculator{payouts, options}.equity(stacks);
+
+    for (size_t i = 0; i < stacks.size(); ++i) EXPECT_NEAR(sampled[i], exact[i], 0.15);
+}
+
+TEST(ICM, BatchMatchesSingleEvaluations) {
+    const ICMCalculator icm{{50, 30, 20}};
+    // outcomes of player 0 and 1 all in for 1000: player 0 doubles up, or busts
+    const std::vector<double> rows{2000, 0, 1500, 800, 0, 1000, 1500, 800, 1000, 1000, 1500, 800};
+    std::vector<double> out(rows.size());
+    icm.equityBatch(rows, 4, out);
+
+    for (size_t row = 0; row < rows.size(); row += 4) {
+        const auto single = icm.equity(std::span<const double>(rows).subspan(row, 4));
+        for (size_t i = 0; i < 4; ++i) EXPECT_DOUBLE_EQ(out[row + i], single[i]);
+    }
+    EXPECT_THROW(icm.equityBatch(rows, 5, out), std::invalid_argument);
+}
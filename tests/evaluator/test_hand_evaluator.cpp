@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <iterator>
 #include <ostream>
+#include <random>
 
 #include "PokerEngine/evaluator/hand_evaluator.hpp"
 
@@ -156,4 +157,35 @@ TEST(HandEvaluator, HandEvaluatorScores1) {
     auto hand_eval_2 = evaluator.evaluate(hand2);
 
     ASSERT_TRUE(hand_eval_1 > hand_eval_2);  
-}
\ No newline at end of file
+}
+
+TEST(HandEvaluator, MaskScoreMatchesEvaluate) {
+    PokerEngine::Evaluator::HandEvaluator evaluator{};
+    std::mt19937 rng(7);
+
+    std::vector<Card> deck;
+    for (int i = 0; i < 52; ++i) {
+        deck.emplace_back(static_cast<PokerEngine::Core::Rank>(i % 13 + 2), static_cast<PokerEngine::Core::Suit>(i / 13));
+    }
+
+    for (int trial = 0; trial < 20000; ++trial) {
+        std::shuffle(deck.begin(), deck.end(), rng);
+        std::vector<Card> hand(deck.begin(), deck.begin() + 5 + trial % 3);
+        auto mask = PokerEngine::Evaluator::detail::cards_bitmask(hand);
+        ASSERT_EQ(evaluator.score(mask), evaluator.evaluate(hand).score);
+    }
+}
+
+TEST(HandEvaluator, MaskScoreSpecialStraights) {
+    PokerEngine::Evaluator::HandEvaluator evaluator{};
+
+    for (const auto& hand : std::vector<std::vector<Card>>{
+            {"Ah"_c, "2h"_c, "3h"_c, "4h"_c, "5h"_c, "Kd"_c, "Kc"_c}, // steel wheel
+            {"As"_c, "2h"_c, "3d"_c, "4h"_c, "5c"_c, "Kd"_c, "9c"_c}, // wheel
+            {"Ah"_c, "Kh"_c, "Qh"_c, "Jh"_c, "Th"_c, "9h"_c, "2c"_c}, // royal flush
+            {"7h"_c, "7d"_c, "7c"_c, "3h"_c, "3d"_c, "3c"_c, "2c"_c}  // two sets of trips
+        }) {
+        auto mask = PokerEngine::Evaluator::detail::cards_bitmask(hand);
+        EXPECT_EQ(evaluator.score(mask), evaluator.evaluate(hand).score);
+    }
+}
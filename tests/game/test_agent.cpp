@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PokerEngine/game/agent.hpp"
+#include "PokerEngine/game/table_batch.hpp"
+#include "PokerEngine/game/equity_agent.hpp"
+#include "PokerEngine/game/self_play.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core::literals;
+using namespace PokerEngine::Game;
+
+namespace {
+    class CountingAgent : public SingleDecisionAgent {
+    public:
+        explicit CountingAgent(int* calls) : calls_(calls) {}
+        Action act(const Observation& observation) override {
+            ++*calls_;
+            return observation.legal.can_check ? Action::check() : Action::call();
+        }
+
+    private:
+        int* calls_;
+    };
+
+    Observation spot(Core::CardMask hole, Core::CardMask board, int opponents) {
+        Observation obs{};
+        obs.hole = hole;
+        obs.board = board;
+        obs.opponents = static_cast<uint8_t>(opponents);
+        return obs;
+    }
+}
+
+TEST(AgentTest, SingleDecisionAdapterAnswersEverySpot) {
+    int calls = 0;
+    CountingAgent agent(&calls);
+    std::vector<Observation> observations(3);
+    observations[1].legal.can_check = true;
+    std::vector<Action> actions(3);
+
+    agent.decide(observations, actions);
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(actions[0].type, ActionType::Call);
+    EXPECT_EQ(actions[1].type, ActionType::Check);
+}
+
+TEST(AgentTest, FunctionAgentsWrapSingleAndBatchCallables) {
+    auto single = makeAgent([](const Observation&) { return Action::fold(); });
+    int batches = 0;
+    auto batch = makeAgent([&batches](std::span<const Observation>, std::span<Action> actions) {
+        ++batches;
+        for (auto& a : actions) a = Action::raiseTo(10);
+    });
+
+    std::vector<Observation> observations(4);
+    std::vector<Action> actions(4);
+    single->decide(observations, actions);
+    EXPECT_EQ(actions[3].type, ActionType::Fold);
+    batch->decide(observations, actions);
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(actions[2].amount, 10);
+
+    const AgentFactory make = agentFactory<RandomAgent>(uint64_t{9});
+    EXPECT_NE(make(), nullptr);
+}
+
+TEST(AgentTest, TableBatchGathersPendingDecisionsByGroup) {
+    TableBatch tables({2, 1, 2, 0}, 5);
+    Core::detail::Xoshiro256 rng(3);
+    const std::array<int, 2> stacks{100, 100};
+    // table 3 is left without a hand
+    for (size_t t : {0, 1, 2, 4}) tables[t].startHand(stacks, static_cast<int>(t % 2), dealCards(2, rng));
+
+    std::vector<std::vector<Observation>> groups(2);
+    const size_t count = tables.gather(std::span(groups), [](size_t, int seat) { return seat; });
+    EXPECT_EQ(count, 4u);
+    // the button acts first heads up
+    ASSERT_EQ(groups[0].size(), 3u);
+    ASSERT_EQ(groups[1].size(), 1u);
+    EXPECT_EQ(groups[1][0].table, 1u);
+    EXPECT_EQ(groups[0][2].table, 4u);
+    EXPECT_EQ(groups[0][0].legal.call_amount, 1);
+    EXPECT_EQ(groups[0][0].opponents, 1);
+
+    std::vector<Action> folds(groups[0].size(), Action::fold());
+    tables.apply(groups[0], folds);
+    std::vector<Observation> all;
+    EXPECT_EQ(tables.gather(all), 1u);
+    EXPECT_EQ(all[0].table, 1u);
+    EXPECT_THROW(tables.apply(all, std::vector<Action>{}), std::invalid_argument);
+}
+
+TEST(AgentTest, EquityAgentEstimatesEquityForWholeBatch) {
+    EquityAgent agent({.trials = 4000, .seed = 5});
+    const std::vector<Observation> observations{
+        spot(Core::cardMask("Ah"_c) | Core::cardMask("As"_c), 0, 1),
+        spot(Core::cardMask("7h"_c) | Core::cardMask("2c"_c), 0, 1),
+        spot(Core::cardMask("Ah"_c) | Core::cardMask("As"_c), 0, 4),
+        // made royal flush on the river
+        spot(Core::cardMask("Ah"_c) | Core::cardMask("Kh"_c),
+             Core::cardMask("Qh"_c) | Core::cardMask("Jh"_c) | Core::cardMask("Th"_c) | Core::cardMask("2c"_c) | Core::cardMask("3d"_c), 3),
+    };
+    std::vector<double> equity(observations.size());
+    agent.equities(observations, equity);
+
+    EXPECT_NEAR(equity[0], 0.852, 0.02);
+    EXPECT_NEAR(equity[1], 0.346, 0.02);
+    EXPECT_NEAR(equity[2], 0.56, 0.03);
+    EXPECT_DOUBLE_EQ(equity[3], 1.0);
+}
+
+TEST(AgentTest, EquityAgentBeatsCallingStation) {
+    SelfPlayOptions options{};
+    options.duplicate_sets = 2000;
+    options.threads = 1;
+    const std::vector<AgentFactory> lineup{
+        agentFactory<EquityAgent>(EquityAgentOptions{.trials = 100}),
+        agentFactory<CallingStationAgent>(),
+    };
+
+    const MatchResult result = SelfPlayHarness(options).run(lineup);
+    EXPECT_GT(result.agents[0].bb_per_100, result.agents[0].ci95);
+    EXPECT_GT(static_cast<double>(result.decisions) / static_cast<double>(result.agent_calls), 8.0);
+}
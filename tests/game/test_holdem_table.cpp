@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <numeric>
+#include <vector>
+
+#include "PokerEngine/game/holdem_table.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core::literals;
+using namespace PokerEngine::Game;
+
+namespace {
+    Deal makeDeal(std::initializer_list<std::pair<Core::Card, Core::Card>> holes, std::array<Core::Card, 5> board) {
+        Deal deal{};
+        int s = 0;
+        for (auto [a, b] : holes) deal.holes[s++] = Core::cardMask(a) | Core::cardMask(b);
+        for (int i = 0; i < 5; ++i) deal.board[i] = Core::cardMask(board[i]);
+        return deal;
+    }
+
+    const std::array<Core::Card, 5> DRY_BOARD{"2c"_c, "7d"_c, "9h"_c, "Js"_c, "3d"_c};
+}
+
+TEST(HoldemTableTest, HeadsUpButtonPostsSmallBlindAndActsFirstPreflop) {
+    HoldemTable table({2, 1, 2, 0});
+    const std::array<int, 2> stacks{100, 100};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}}, DRY_BOARD));
+
+    EXPECT_EQ(table.street(), Street::Preflop);
+    EXPECT_EQ(table.toAct(), 0);
+    EXPECT_EQ(table.committed(0), 1);
+    EXPECT_EQ(table.committed(1), 2);
+    EXPECT_EQ(table.legalActions().call_amount, 1);
+    EXPECT_EQ(table.legalActions().min_raise_to, 4);
+    EXPECT_EQ(table.legalActions().max_raise_to, 100);
+
+    table.apply(Action::call());
+    // the big blind has the option
+    EXPECT_EQ(table.toAct(), 1);
+    EXPECT_TRUE(table.legalActions().can_check);
+    table.apply(Action::check());
+
+    EXPECT_EQ(table.street(), Street::Flop);
+    EXPECT_EQ(table.boardSize(), 3);
+    EXPECT_EQ(table.toAct(), 1);
+    EXPECT_EQ(table.currentBet(), 0);
+}
+
+TEST(HoldemTableTest, FoldAwardsPotToLastPlayer) {
+    HoldemTable table({3, 1, 2, 0});
+    const std::array<int, 3> stacks{100, 100, 100};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}, {"5c"_c, "4c"_c}}, DRY_BOARD));
+
+    // three handed the button acts first preflop
+    EXPECT_EQ(table.toAct(), 0);
+    table.apply(Action::raiseTo(6));
+    table.apply(Action::fold());
+    table.apply(Action::fold());
+
+    EXPECT_TRUE(table.handOver());
+    EXPECT_EQ(table.payoff(0), 3);
+    EXPECT_EQ(table.payoff(1), -1);
+    EXPECT_EQ(table.payoff(2), -2);
+    EXPECT_EQ(table.boardSize(), 0);
+}
+
+TEST(HoldemTableTest, ShowdownPaysBestHand) {
+    HoldemTable table({2, 1, 2, 0});
+    const std::array<int, 2> stacks{100, 100};
+    table.startHand(stacks, 1, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}}, DRY_BOARD));
+
+    table.apply(Action::raiseTo(6));
+    table.apply(Action::call());
+    while (!table.handOver()) table.apply(Action::check());
+
+    EXPECT_EQ(table.boardSize(), 5);
+    EXPECT_EQ(table.payoff(1), 6);
+    EXPECT_EQ(table.payoff(0), -6);
+}
+
+TEST(HoldemTableTest, RejectsIllegalActions) {
+    HoldemTable table({2, 1, 2, 0});
+    const std::array<int, 2> stacks{100, 100};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}}, DRY_BOARD));
+
+    EXPECT_THROW(table.apply(Action::check()), std::invalid_argument);
+    EXPECT_THROW(table.apply(Action::raiseTo(3)), std::invalid_argument);
+    EXPECT_THROW(table.apply(Action::raiseTo(101)), std::invalid_argument);
+    table.apply(Action::call());
+    EXPECT_THROW(table.apply(Action::fold()), std::invalid_argument);
+    EXPECT_THROW(table.apply(Action::call()), std::invalid_argument);
+}
+
+TEST(HoldemTableTest, ShortAllInDoesNotReopenBetting) {
+    HoldemTable table({3, 1, 2, 0});
+    const std::array<int, 3> stacks{100, 100, 15};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}, {"5c"_c, "4c"_c}}, DRY_BOARD));
+
+    table.apply(Action::raiseTo(10));
+    table.apply(Action::call());
+    // the big blind shoves 15, a raise of 5 against a raise of 8
+    EXPECT_EQ(table.legalActions().max_raise_to, 15);
+    table.apply(Action::raiseTo(15));
+    EXPECT_TRUE(table.isAllIn(2));
+
+    EXPECT_EQ(table.toAct(), 0);
+    auto legal = table.legalActions();
+    EXPECT_TRUE(legal.can_call);
+    EXPECT_FALSE(legal.can_raise);
+    EXPECT_EQ(legal.call_amount, 5);
+    EXPECT_THROW(table.apply(Action::raiseTo(40)), std::invalid_argument);
+    table.apply(Action::call());
+    EXPECT_FALSE(table.legalActions().can_raise);
+    table.apply(Action::call());
+
+    EXPECT_EQ(table.street(), Street::Flop);
+    EXPECT_EQ(table.potTotal(), 45);
+}
+
+TEST(HoldemTableTest, FullRaiseReopensBetting) {
+    HoldemTable table({3, 1, 2, 0});
+    const std::array<int, 3> stacks{100, 100, 100};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}, {"5c"_c, "4c"_c}}, DRY_BOARD));
+
+    table.apply(Action::raiseTo(6));
+    table.apply(Action::call());
+    table.apply(Action::raiseTo(20));
+    EXPECT_EQ(table.toAct(), 0);
+    EXPECT_TRUE(table.legalActions().can_raise);
+    EXPECT_EQ(table.legalActions().min_raise_to, 34);
+}
+
+TEST(HoldemTableTest, NoRaiseWhenNobodyCanRespond) {
+    HoldemTable table({2, 1, 2, 0});
+    const std::array<int, 2> stacks{100, 1000};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}}, DRY_BOARD));
+
+    // the button shoves, the big blind can only call or fold
+    table.apply(Action::raiseTo(100));
+    EXPECT_TRUE(table.isAllIn(0));
+    EXPECT_EQ(table.toAct(), 1);
+    const auto legal = table.legalActions();
+    EXPECT_TRUE(legal.can_call);
+    EXPECT_TRUE(legal.can_fold);
+    EXPECT_FALSE(legal.can_raise);
+    EXPECT_EQ(legal.call_amount, 98);
+    EXPECT_THROW(table.apply(Action::raiseTo(1000)), std::invalid_argument);
+    table.apply(Action::call());
+
+    EXPECT_TRUE(table.handOver());
+    EXPECT_EQ(table.boardSize(), 5);
+}
+
+TEST(HoldemTableTest, SidePotsGoToBestEligibleHands) {
+    HoldemTable table({3, 1, 2, 0});
+    // seat 2 has the nuts with the shortest stack, seat 1 beats seat 0 for the side pot
+    const std::array<int, 3> stacks{100, 60, 20};
+    table.startHand(stacks, 0, makeDeal({{"5h"_c, "4h"_c}, {"Ks"_c, "Kd"_c}, {"As"_c, "Ad"_c}}, DRY_BOARD));
+
+    table.apply(Action::raiseTo(100));
+    table.apply(Action::call());
+    table.apply(Action::call());
+
+    ASSERT_TRUE(table.handOver());
+    EXPECT_EQ(table.boardSize(), 5);
+    EXPECT_EQ(table.stack(2).chips(), 60);
+    EXPECT_EQ(table.stack(1).chips(), 80);
+    // the uncalled 40 comes back
+    EXPECT_EQ(table.stack(0).chips(), 40);
+}
+
+TEST(HoldemTableTest, SplitPotGivesOddChipLeftOfButton) {
+    HoldemTable table({3, 1, 2, 0});
+    const std::array<int, 3> stacks{100, 100, 100};
+    // both players left play the board's straight
+    const std::array<Core::Card, 5> board{"Tc"_c, "Jd"_c, "Qh"_c, "Ks"_c, "Ad"_c};
+    table.startHand(stacks, 0, makeDeal({{"2h"_c, "3h"_c}, {"2s"_c, "3s"_c}, {"4c"_c, "5c"_c}}, board));
+
+    table.apply(Action::fold());
+    table.apply(Action::raiseTo(4));
+    table.apply(Action::call());
+    while (!table.handOver()) table.apply(Action::check());
+
+    // an even pot splits evenly, an ante makes it odd
+    EXPECT_EQ(table.payoff(1), 0);
+    EXPECT_EQ(table.payoff(2), 0);
+
+    HoldemTable ante_table({3, 1, 2, 1});
+    ante_table.startHand(stacks, 0, makeDeal({{"2h"_c, "3h"_c}, {"2s"_c, "3s"_c}, {"4c"_c, "5c"_c}}, board));
+    ante_table.apply(Action::fold());
+    ante_table.apply(Action::call());
+    ante_table.apply(Action::check());
+    while (!ante_table.handOver()) ante_table.apply(Action::check());
+
+    // 4 blinds and 3 antes, seat 1 is first left of the button
+    EXPECT_EQ(ante_table.payoff(1), 1);
+    EXPECT_EQ(ante_table.payoff(2), 0);
+    EXPECT_EQ(ante_table.payoff(0), -1);
+}
+
+TEST(HoldemTableTest, BlindAllInRunsOutBoard) {
+    HoldemTable table({2, 5, 10, 0});
+    const std::array<int, 2> stacks{100, 4};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}}, DRY_BOARD));
+
+    // the big blind is all in for 4, the small blind has already covered it
+    EXPECT_TRUE(table.handOver());
+    EXPECT_EQ(table.payoff(1), 4);
+    EXPECT_EQ(table.payoff(0), -4);
+}
+
+TEST(HoldemTableTest, SkipsSeatsWithoutChips) {
+    HoldemTable table({4, 1, 2, 0});
+    const std::array<int, 4> stacks{0, 100, 100, 0};
+    table.startHand(stacks, 0, makeDeal({{"Ah"_c, "Kh"_c}, {"Qs"_c, "Qd"_c}, {"5c"_c, "4c"_c}, {"8c"_c, "8d"_c}}, DRY_BOARD));
+
+    // heads up between seats 1 and 2, seat 1 takes the button
+    EXPECT_EQ(table.button(), 1);
+    EXPECT_EQ(table.committed(1), 1);
+    EXPECT_EQ(table.committed(2), 2);
+    EXPECT_FALSE(table.inHand(0));
+    EXPECT_THROW(table.startHand(std::array<int, 4>{0, 100, 0, 0}, 0, Deal{}), std::invalid_argument);
+}
+
+TEST(HoldemTableTest, DealsDistinctCards) {
+    Core::detail::Xoshiro256 rng(7);
+    for (int i = 0; i < 1000; ++i) {
+        const Deal deal = dealCards(MAX_PLAYERS, rng);
+        Core::CardMask all = 0;
+        for (auto h : deal.holes) all |= h;
+        for (auto b : deal.board) all |= b;
+        ASSERT_EQ(std::popcount(all), 2 * MAX_PLAYERS + 5);
+    }
+}
+
+TEST(HoldemTableTest, RandomSelfPlayConservesChips) {
+    Core::detail::Xoshiro256 rng(42);
+    for (int players = 2; players <= MAX_PLAYERS; ++players) {
+        HoldemTable table({players, 1, 2, 1});
+        std::vector<int> stacks(players, 200);
+        for (int hand = 0; hand < 300; ++hand) {
+            if (std::count_if(stacks.begin(), stacks.end(), [](int c) { return c > 0; }) < 2) std::fill(stacks.begin(), stacks.end(), 200);
+            table.startHand(stacks, hand % players, dealCards(players, rng));
+            while (!table.handOver()) {
+                const LegalActions legal = table.legalActions();
+                const uint32_t roll = rng.below(10);
+                if (legal.can_raise && roll < 2) {
+                    table.apply(Action::raiseTo(legal.min_raise_to + static_cast<int>(rng.below(static_cast<uint32_t>(legal.max_raise_to - legal.min_raise_to + 1)))));
+                } else if (legal.can_fold && roll < 4) {
+                    table.apply(Action::fold());
+                } else {
+                    table.apply(legal.can_check ? Action::check() : Action::call());
+                }
+            }
+            int net = 0;
+            for (int s = 0; s < players; ++s) {
+                ASSERT_GE(table.stack(s).chips(), 0);
+                net += table.payoff(s);
+                stacks[s] = table.stack(s).chips();
+            }
+            ASSERT_EQ(net, 0);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PokerEngine/game/self_play.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Game;
+
+namespace {
+    class ShoveAgent : public Agent {
+    public:
+        void decide(std::span<const Observation> observations, std::span<Action> actions) override {
+            for (size_t i = 0; i < observations.size(); ++i) {
+                const LegalActions& legal = observations[i].legal;
+                actions[i] = legal.can_raise ? Action::raiseTo(legal.max_raise_to)
+                           : legal.can_check ? Action::check() : Action::call();
+            }
+        }
+    };
+
+    class FoldAgent : public Agent {
+    public:
+        void decide(std::span<const Observation> observations, std::span<Action> actions) override {
+            for (size_t i = 0; i < observations.size(); ++i) {
+                actions[i] = observations[i].legal.can_fold ? Action::fold() : Action::check();
+            }
+        }
+    };
+
+    class CheckAgent : public Agent {
+    public:
+        void decide(std::span<const Observation>, std::span<Action> actions) override {
+            for (auto& a : actions) a = Action::check();
+        }
+    };
+
+    template<typename T>
+    AgentFactory factory() {
+        return [] { return std::make_unique<T>(); };
+    }
+}
+
+TEST(SelfPlayHarnessTest, MirroredIdenticalAgentsBreakEvenExactly) {
+    SelfPlayOptions options{};
+    options.duplicate_sets = 500;
+    options.threads = 4;
+    options.tables_per_thread = 16;
+    const std::vector<AgentFactory> lineup{factory<CallingStationAgent>(), factory<CallingStationAgent>()};
+
+    const MatchResult result = SelfPlayHarness(options).run(lineup);
+    EXPECT_EQ(result.hands, 1000u);
+    ASSERT_EQ(result.agents.size(), 2u);
+    for (const auto& agent : result.agents) {
+        EXPECT_EQ(agent.hands, 1000u);
+        EXPECT_EQ(agent.chips, 0);
+        EXPECT_DOUBLE_EQ(agent.bb_per_100, 0.0);
+        EXPECT_DOUBLE_EQ(agent.ci95, 0.0);
+    }
+}
+
+TEST(SelfPlayHarnessTest, ReportsBigBlindsPerHundred) {
+    SelfPlayOptions options{};
+    options.duplicate_sets = 200;
+    options.threads = 2;
+    const std::vector<AgentFactory> lineup{factory<ShoveAgent>(), factory<FoldAgent>()};
+
+    // the folder gives up the small blind on the button and the big blind against a shove
+    const MatchResult result = SelfPlayHarness(options).run(lineup);
+    EXPECT_DOUBLE_EQ(result.agents[1].bb_per_100, -75.0);
+    EXPECT_DOUBLE_EQ(result.agents[0].bb_per_100, 75.0);
+    EXPECT_DOUBLE_EQ(result.agents[1].ci95, 0.0);
+    EXPECT_EQ(result.agents[0].chips, 600);
+}
+
+TEST(SelfPlayHarnessTest, BatchesDecisionsAcrossTables) {
+    SelfPlayOptions options{};
+    options.table = {6, 1, 2, 0};
+    options.duplicate_sets = 300;
+    options.threads = 1;
+    options.tables_per_thread = 32;
+    std::vector<AgentFactory> lineup;
+    for (int s = 0; s < 6; ++s) {
+        lineup.push_back(s % 2 ? factory<CallingStationAgent>() : AgentFactory([s] { return std::make_unique<RandomAgent>(s); }));
+    }
+
+    const MatchResult result = SelfPlayHarness(options).run(lineup);
+    EXPECT_EQ(result.hands, 1800u);
+    EXPECT_GT(static_cast<double>(result.decisions) / static_cast<double>(result.agent_calls), 4.0);
+
+    long long net = 0;
+    for (const auto& agent : result.agents) {
+        net += agent.chips;
+        EXPECT_GT(agent.ci95, 0.0);
+    }
+    EXPECT_EQ(net, 0);
+}
+
+TEST(SelfPlayHarnessTest, IllegalActionsAndBadLineupsThrow) {
+    SelfPlayOptions options{};
+    options.duplicate_sets = 10;
+    options.threads = 2;
+    const SelfPlayHarness harness(options);
+
+    const std::vector<AgentFactory> cheater{factory<CheckAgent>(), factory<CheckAgent>()};
+    EXPECT_THROW(harness.run(cheater), std::invalid_argument);
+    const std::vector<AgentFactory> short_lineup{factory<CheckAgent>()};
+    EXPECT_THROW(harness.run(short_lineup), std::invalid_argument);
+    EXPECT_THROW(SelfPlayHarness({.table = {11, 1, 2, 0}}), std::invalid_argument);
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/history/history_parser.hpp"
+#include "PokerEngine/history/allin_ev.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core::literals;
+using namespace PokerEngine::History;
+
+namespace {
+    // three way, short stack all in on the turn, the other two get it in on the same street
+    constexpr std::string_view TURN_ALL_IN = R"(PokerStars Hand #2001:  Hold'em No Limit ($1/$2 USD) - 2024/01/01 12:00:00 ET
+Table 'Beta' 6-max Seat #1 is the button
+Seat 1: a ($50 in chips)
+Seat 2: b ($200 in chips)
+Seat 3: c ($200 in chips)
+Seat 4: d ($200 in chips)
+b: posts small blind $1
+c: posts big blind $2
+*** HOLE CARDS ***
+d: raises $4 to $6
+a: calls $6
+b: calls $5
+c: calls $4
+*** FLOP *** [Ah 7d 2c]
+b: checks
+c: checks
+d: bets $10
+a: calls $10
+b: calls $10
+c: folds
+*** TURN *** [Ah 7d 2c] [9s]
+b: bets $30
+d: raises $154 to $184 and is all-in
+a: calls $34 and is all-in
+b: calls $154 and is all-in
+*** RIVER *** [Ah 7d 2c 9s] [Kd]
+*** SHOW DOWN ***
+b: shows [Ad Kc] (two pair, Aces and Kings)
+d: shows [8h Th] (high card Ace)
+a: shows [7h 7c] (three of a kind, Sevens)
+b collected $300 from side pot
+a collected $156 from main pot
+*** SUMMARY ***
+Total pot $456 | Rake $0
+
+)";
+
+    constexpr std::string_view NOT_ALL_IN = R"(PokerStars Hand #2002:  Hold'em No Limit ($1/$2 USD) - 2024/01/01 12:01:00 ET
+Table 'Beta' 6-max Seat #2 is the button
+Seat 1: a ($50 in chips)
+Seat 2: b ($200 in chips)
+b: posts small blind $1
+a: posts big blind $2
+*** HOLE CARDS ***
+b: folds
+Uncalled bet ($1) returned to a
+a collected $2 from pot
+*** SUMMARY ***
+Total pot $2 | Rake $0
+
+)";
+
+    // the same hand as a tournament, amounts in whole chips
+    std::string asTournament(std::string_view text) {
+        std::string out{text};
+        const size_t header_end = out.find('\n');
+        out.replace(0, header_end, "PokerStars Hand #3001: Tournament #5, Hold'em No Limit - Level I (1/2) - 2024/01/01 12:00:00 ET");
+        std::erase(out, '$');
+        return out;
+    }
+
+    // two hearts and two spades swapped, the same situation up to suits
+    std::string relabelled(std::string_view text) {
+        std::string out{text};
+        for (size_t i = 0; i + 1 < out.size(); ++i) {
+            const bool card = std::string_view{"23456789TJQKA"}.find(out[i]) != std::string_view::npos;
+            if (!card) continue;
+            if (out[i + 1] == 'h') out[i + 1] = 's';
+            else if (out[i + 1] == 's') out[i + 1] = 'h';
+        }
+        return out;
+    }
+}
+
+TEST(AllInEV, SplitsMainAndSidePotsOverRunouts) {
+    const std::string text = std::string(TURN_ALL_IN) + std::string(NOT_ALL_IN);
+    const ParsedHands parsed = parseHands(text, 1);
+    ASSERT_EQ(parsed.hands.size(), 2u);
+
+    const AllInEVEngine engine{2};
+    const auto results = engine.evaluate(parsed);
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    const auto& hand = parsed.hands[0];
+    EXPECT_EQ(r.id, 2001u);
+    EXPECT_EQ(r.street, Street::Turn);
+    EXPECT_EQ(r.board_size, 4);
+
+    // a: $50, b and d: $200, c folded $6. Main pot $156 three ways, side pot $300 between b and d
+    const auto board = hand.boardMask() & ~Core::cardMask("Kd"_c);
+    const auto a = hand.seats[0].hole, b = hand.seats[1].hole, d = hand.seats[3].hole;
+    std::array<double, 3> expected{};
+    int rivers = 0;
+    Evaluator::HandEvaluator eval{};
+    for (int c = 0; c < Core::NUM_CARDS; ++c) {
+        const Core::CardMask river = Core::CardMask{1} << c;
+        if (river & (board | a | b | d)) continue;
+        ++rivers;
+        const std::array<uint64_t, 3> s{eval.score(board | river | a), eval.score(board | river | b), eval.score(board | river | d)};
+        const uint64_t best = std::max({s[0], s[1], s[2]});
+        const double main_winners = (s[0] == best) + (s[1] == best) + (s[2] == best);
+        for (int i = 0; i < 3; ++i) expected[i] += s[i] == best ? 15600.0 / main_winners : 0.0;
+        const uint64_t side_best = std::max(s[1], s[2]);
+        const double side_winners = (s[1] == side_best) + (s[2] == side_best);
+        if (s[1] == side_best) expected[1] += 30000.0 / side_winners;
+        if (s[2] == side_best) expected[2] += 30000.0 / side_winners;
+    }
+    EXPECT_EQ(rivers, 42);
+    EXPECT_NEAR(r.ev_won[0], expected[0] / rivers, 1e-9);
+    EXPECT_NEAR(r.ev_won[1], expected[1] / rivers, 1e-9);
+    EXPECT_NEAR(r.ev_won[3], expected[2] / rivers, 1e-9);
+    EXPECT_EQ(r.ev_won[2], 0.0);
+    EXPECT_NEAR(r.equity[0] + r.equity[1] + r.equity[3], 1.0, 1e-12);
+
+    EXPECT_NEAR(r.evNet(hand, 0), expected[0] / rivers - 5000.0, 1e-9);
+
+    // totals are in dollars, not hundredths
+    const auto totals = allInTotals(parsed, results);
+    EXPECT_DOUBLE_EQ(totals.at("a").net, 106.0);
+    EXPECT_DOUBLE_EQ(totals.at("c").net, -6.0);
+    EXPECT_NEAR(totals.at("c").ev_net, -6.0, 1e-9);
+    EXPECT_EQ(totals.count("e"), 0u);
+}
+
+TEST(AllInEV, TotalsAddCashAndTournamentHandsInPrintedUnits) {
+    const std::string text = std::string(TURN_ALL_IN) + asTournament(TURN_ALL_IN);
+    const ParsedHands parsed = parseHands(text, 1);
+    ASSERT_EQ(parsed.hands.size(), 2u);
+    ASSERT_TRUE(parsed.hands[1].tournament);
+    EXPECT_EQ(parsed.hands[0].seats[0].won, 100 * parsed.hands[1].seats[0].won);
+
+    const auto results = AllInEVEngine{2}.evaluate(parsed);
+    ASSERT_EQ(results.size(), 2u);
+    const auto totals = allInTotals(parsed, results);
+    EXPECT_EQ(totals.at("a").hands, 2u);
+    EXPECT_DOUBLE_EQ(totals.at("a").net, 2 * 106.0);
+    EXPECT_DOUBLE_EQ(totals.at("c").net, 2 * -6.0);
+    EXPECT_NEAR(totals.at("b").ev_net, 2 * results[1].evNet(parsed.hands[1], 1), 1e-9);
+}
+
+TEST(AllInEV, SuitIsomorphicHandsShareOneEnumeration) {
+    std::string text;
+    for (int i = 0; i < 20; ++i) text += i % 2 ? relabelled(TURN_ALL_IN) : std::string(TURN_ALL_IN);
+    const ParsedHands parsed = parseHands(text, 2);
+    ASSERT_EQ(parsed.hands.size(), 20u);
+
+    const AllInEVEngine engine{3};
+    const auto results = engine.evaluate(parsed);
+    ASSERT_EQ(results.size(), 20u);
+    EXPECT_EQ(engine.cacheSize(), 1u);
+    for (const auto& r : results) {
+        for (size_t i = 0; i < 4; ++i) EXPECT_NEAR(r.ev_won[i], results[0].ev_won[i], 1e-9);
+    }
+}
+
+TEST(AllInEV, CacheCapacityBoundsTheMemo) {
+    std::string text;
+    for (int i = 0; i < 6; ++i) text += i % 2 ? relabelled(TURN_ALL_IN) : std::string(TURN_ALL_IN);
+    const ParsedHands parsed = parseHands(text, 2);
+
+    const AllInEVEngine memoised{2};
+    const AllInEVEngine uncached{2, 0};
+    const auto expected = memoised.evaluate(parsed);
+    const auto results = uncached.evaluate(parsed);
+    EXPECT_EQ(uncached.cacheSize(), 0u);
+    EXPECT_EQ(uncached.cacheHits(), 0u);
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t h = 0; h < results.size(); ++h) {
+        for (size_t i = 0; i < 4; ++i) EXPECT_NEAR(results[h].ev_won[i], expected[h].ev_won[i], 1e-9);
+    }
+}
+
+TEST(AllInEV, PreflopAllInMatchesExactEquity) {
+    constexpr std::string_view PREFLOP = R"(PokerStars Hand #2003:  Hold'em No Limit ($1/$2 USD) - 2024/01/01 12:02:00 ET
+Table 'Beta' 6-max Seat #1 is the button
+Seat 1: a ($100 in chips)
+Seat 2: b ($100 in chips)
+a: posts small blind $1
+b: posts big blind $2
+*** HOLE CARDS ***
+a: raises $98 to $100 and is all-in
+b: calls $98
+*** FLOP *** [2c 7d Ts]
+*** TURN *** [2c 7d Ts] [Jh]
+*** RIVER *** [2c 7d Ts Jh] [3s]
+*** SHOW DOWN ***
+a: shows [Ah Kh]
+b: shows [Qs Qc]
+b collected $199 from pot
+*** SUMMARY ***
+Total pot $200 | Rake $1
+
+)";
+    const ParsedHands parsed = parseHands(PREFLOP, 1);
+    const auto results = AllInEVEngine{1}.evaluate(parsed);
+    ASSERT_EQ(results.size(), 1u);
+
+    const auto& hand = parsed.hands[0];
+    const auto exact = Simulator::ExactNLHStrategy{}.pairEquity(0, hand.seats[0].hole, hand.seats[1].hole,
+                                                                 (Core::CardMask{1} << Core::NUM_CARDS) - 1);
+    EXPECT_NEAR(results[0].equity[0], exact.win + exact.tie / 2.0, 1e-9);
+    // rake comes out of every outcome
+    EXPECT_NEAR(results[0].ev_won[0] + results[0].ev_won[1], 19900.0, 1e-9);
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#include "PokerEngine/history/history_parser.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core::literals;
+using namespace PokerEngine::History;
+
+namespace {
+    constexpr std::string_view FOLD_TO_BET = R"(PokerStars Hand #1001:  Hold'em No Limit ($0.50/$1.00 USD) - 2024/01/01 12:00:00 ET
+Table 'Alpha' 6-max Seat #1 is the button
+Seat 1: alice ($100 in chips)
+Seat 2: bob smith ($80.50 in chips)
+Seat 3: bob ($120 in chips) is sitting out
+alice: posts small blind $0.50
+bob smith: posts big blind $1
+*** HOLE CARDS ***
+Dealt to alice [Ah Kd]
+alice: raises $2 to $3
+bob smith: calls $2
+*** FLOP *** [2c 7d Ts]
+bob smith: checks
+alice: bets $4
+bob smith: folds
+Uncalled bet ($4) returned to alice
+alice collected $5.70 from pot
+alice: doesn't show hand
+*** SUMMARY ***
+Total pot $6 | Rake $0.30
+Board [2c 7d Ts]
+Seat 1: alice (button) (small blind) collected ($5.70)
+Seat 2: bob smith (big blind) folded on the Flop
+
+)";
+
+    constexpr std::string_view ALL_IN = R"(PokerStars Hand #1002: Tournament #77, $10+$1 USD Hold'em No Limit - Level II (15/30) - 2024/01/01 12:05:00 ET
+Table '77 1' 9-max Seat #2 is the button
+Seat 1: a (500 in chips)
+Seat 2: b (1500 in chips)
+Seat 3: c (3000 in chips)
+a: posts the ante 5
+b: posts the ante 5
+c: posts the ante 5
+c: posts small blind 15
+a: posts big blind 30
+*** HOLE CARDS ***
+b: raises 1465 to 1495 and is all-in
+c: calls 1480
+a: calls 465 and is all-in
+*** FLOP *** [Qh 7c 2d]
+*** TURN *** [Qh 7c 2d] [9s]
+*** RIVER *** [Qh 7c 2d 9s] [3h]
+*** SHOW DOWN ***
+c: shows [Ac Ad] (a pair of Aces)
+b: shows [Kc Kd] (a pair of Kings)
+a: shows [7h 7s] (three of a kind, Sevens)
+c collected 2000 from side pot
+a collected 1515 from main pot
+*** SUMMARY ***
+Total pot 3515 Main pot 1515. Side pot 2000. | Rake 0
+Board [Qh 7c 2d 9s 3h]
+
+)";
+
+    constexpr std::string_view BROKEN = R"(PokerStars Hand #1003:  Hold'em No Limit ($0.50/$1.00 USD) - 2024/01/01 12:10:00 ET
+Table 'Alpha' 6-max Seat #2 is the button
+Seat 1: alice ($100 in chips)
+alice: posts small blind $0.50
+*** HOLE CARDS ***
+Dealt to alice [Zz Kd]
+*** SUMMARY ***
+
+)";
+
+    std::string sample(int copies) {
+        std::string text = "\xEF\xBB\xBF";
+        for (int i = 0; i < copies; ++i) {
+            text += FOLD_TO_BET;
+            text += ALL_IN;
+            text += BROKEN;
+        }
+        return text;
+    }
+}
+
+TEST(HistoryParser, ParsesCashHand) {
+    HandRecord hand{};
+    std::vector<ActionRecord> actions;
+    ASSERT_TRUE(HandParser{}.parse(FOLD_TO_BET, hand, actions));
+
+    EXPECT_EQ(hand.id, 1001u);
+    EXPECT_EQ(hand.table, "Alpha");
+    EXPECT_FALSE(hand.tournament);
+    EXPECT_EQ(hand.small_blind, 50);
+    EXPECT_EQ(hand.big_blind, 100);
+    EXPECT_EQ(hand.button, 1);
+    ASSERT_EQ(hand.num_players, 3);
+    EXPECT_EQ(hand.seats[1].name, "bob smith");
+    EXPECT_EQ(hand.seats[1].stack, 8050);
+    EXPECT_EQ(hand.seats[0].hole, Core::cardMask("Ah"_c) | Core::cardMask("Kd"_c));
+
+    // the longer name owns its lines, the sitting out player has none
+    EXPECT_EQ(hand.seats[0].contributed, 300);
+    EXPECT_EQ(hand.seats[1].contributed, 300);
+    EXPECT_EQ(hand.seats[2].contributed, 0);
+    EXPECT_EQ(hand.seats[0].won, 570);
+    EXPECT_EQ(hand.total_pot, 600);
+    EXPECT_EQ(hand.rake, 30);
+    EXPECT_EQ(hand.pot().getTotal(), 600);
+    EXPECT_EQ(hand.board_size, 3);
+    EXPECT_EQ(hand.board().get()[2], "Ts"_c);
+
+    ASSERT_EQ(actions.size(), 7u);
+    EXPECT_EQ(actions[2].type, ActionType::Raise);
+    EXPECT_EQ(actions[2].amount, 250);
+    EXPECT_EQ(actions[4].street, Street::Flop);
+    EXPECT_EQ(actions[6].type, ActionType::Fold);
+    EXPECT_EQ(actions[6].player, 1);
+}
+
+TEST(HistoryParser, ParsesAllInWithAntesAndSidePot) {
+    HandRecord hand{};
+    std::vector<ActionRecord> actions;
+    ASSERT_TRUE(HandParser{}.parse(ALL_IN, hand, actions));
+
+    EXPECT_TRUE(hand.tournament);
+    EXPECT_EQ(hand.big_blind, 30);
+    EXPECT_EQ(hand.table, "77 1");
+    EXPECT_EQ(hand.board_size, 5);
+    EXPECT_EQ(hand.board_cards[4], "3h"_c);
+
+    // tournament amounts are whole chips
+    EXPECT_EQ(hand.amountScale(), 1);
+    // contributions include antes, the raise adds its total less the ante free street commitment
+    EXPECT_EQ(hand.seats[0].contributed, 500);
+    EXPECT_EQ(hand.seats[1].contributed, 1500);
+    EXPECT_EQ(hand.seats[2].contributed, 1500);
+    EXPECT_EQ(hand.seats[0].won, 1515);
+    EXPECT_EQ(hand.seats[2].won, 2000);
+    EXPECT_EQ(hand.total_pot, 3515);
+    EXPECT_EQ(hand.seats[1].hole, Core::cardMask("Kc"_c) | Core::cardMask("Kd"_c));
+
+    const auto& raise = actions[5];
+    EXPECT_EQ(raise.type, ActionType::Raise);
+    EXPECT_TRUE(raise.all_in);
+    EXPECT_EQ(raise.amount, 1495);
+}
+
+TEST(HistoryParser, ParsesEightFigureTournamentStacks) {
+    // 45M chips would overflow int in hundredths, tournament amounts are kept in whole chips
+    constexpr std::string_view DEEP = R"(PokerStars Hand #1004: Tournament #78, $100+$9 USD Hold'em No Limit - Level XL (250000/500000) - 2024/01/02 03:00:00 ET
+Table '78 1' 9-max Seat #1 is the button
+Seat 1: a (45,250,000 in chips)
+Seat 2: b (12500000 in chips)
+a: posts the ante 50000
+b: posts the ante 50000
+a: posts small blind 250000
+b: posts big blind 500000
+*** HOLE CARDS ***
+a: raises 44700000 to 45200000 and is all-in
+b: calls 11950000 and is all-in
+Uncalled bet (32750000) returned to a
+*** FLOP *** [Qh 7c 2d]
+*** TURN *** [Qh 7c 2d] [9s]
+*** RIVER *** [Qh 7c 2d 9s] [3h]
+*** SHOW DOWN ***
+a: shows [Ac Ad] (a pair of Aces)
+b: shows [Kc Kd] (a pair of Kings)
+a collected 25000000 from pot
+*** SUMMARY ***
+Total pot 25000000 | Rake 0
+Board [Qh 7c 2d 9s 3h]
+
+)";
+
+    HandRecord hand{};
+    std::vector<ActionRecord> actions;
+    ASSERT_TRUE(HandParser{}.parse(DEEP, hand, actions));
+
+    EXPECT_TRUE(hand.tournament);
+    EXPECT_EQ(hand.big_blind, 500000);
+    EXPECT_EQ(hand.seats[0].stack, 45250000);
+    EXPECT_EQ(hand.seats[1].stack, 12500000);
+    EXPECT_EQ(hand.seats[0].contributed, 12500000);
+    EXPECT_EQ(hand.seats[1].contributed, 12500000);
+    EXPECT_EQ(hand.seats[0].won, 25000000);
+    EXPECT_EQ(hand.total_pot, 25000000);
+    EXPECT_EQ(hand.pot().getTotal(), 25000000);
+    EXPECT_EQ(actions[4].amount, 44950000);
+
+    const auto stats = forEachHand(DEEP, [](const HandRecord&, std::span<const ActionRecord>) {});
+    EXPECT_EQ(stats.hands, 1u);
+    EXPECT_EQ(stats.skipped, 0u);
+}
+
+TEST(HistoryParser, SkipsMalformedHandsAndKeepsOrder) {
+    const std::string text = sample(3);
+    std::vector<uint64_t> ids;
+    const auto stats = forEachHand(text, [&](const HandRecord& hand, std::span<const ActionRecord>) { ids.push_back(hand.id); });
+
+    EXPECT_EQ(stats.hands, 6u);
+    EXPECT_EQ(stats.skipped, 3u);
+    EXPECT_EQ(ids, (std::vector<uint64_t>{1001, 1002, 1001, 1002, 1001, 1002}));
+}
+
+TEST(HistoryParser, ParallelMatchesSerial) {
+    const std::string text = sample(200);
+    const ParsedHands serial = parseHands(text, 1);
+    const ParsedHands parallel = parseHands(text, 7);
+
+    ASSERT_EQ(serial.hands.size(), 400u);
+    EXPECT_EQ(serial.skipped, 200u);
+    ASSERT_EQ(parallel.hands.size(), serial.hands.size());
+    EXPECT_EQ(parallel.skipped, serial.skipped);
+    for (size_t i = 0; i < serial.hands.size(); ++i) {
+        EXPECT_EQ(parallel.hands[i].id, serial.hands[i].id);
+        EXPECT_EQ(parallel.hands[i].text.data(), serial.hands[i].text.data());
+        const auto a = serial.actionsOf(serial.hands[i]);
+        const auto b = parallel.actionsOf(parallel.hands[i]);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t k = 0; k < a.size(); ++k) EXPECT_EQ(a[k].amount, b[k].amount);
+    }
+
+    std::atomic<size_t> callbacks{0};
+    const auto stats = forEachHandParallel(text, [&](unsigned, const HandRecord&, std::span<const ActionRecord>) { ++callbacks; }, 5);
+    EXPECT_EQ(stats.hands, 400u);
+    EXPECT_EQ(callbacks.load(), 400u);
+}
+
+TEST(HistoryParser, MapsFiles) {
+    const auto path = (std::filesystem::temp_directory_path() / "poker_engine_test_history.txt").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << sample(2);
+    }
+    {
+        const HandHistoryFile file{path};
+        const ParsedHands parsed = file.parse(3);
+        ASSERT_EQ(parsed.hands.size(), 4u);
+        EXPECT_EQ(parsed.hands[1].seats[2].name, "c");
+        EXPECT_EQ(parsed.skipped, 2u);
+    }
+    std::filesystem::remove(path);
+    EXPECT_THROW(HandHistoryFile{path}, std::runtime_error);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/batch_simulator.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    Range hand(Card c1, Card c2) {
+        Range r{};
+        r.addCombo(c1, c2);
+        return r;
+    }
+
+    double equity(const Simulator::SimResult& r) { return r.win + r.tie / 2.0; }
+}
+
+TEST(BatchSimulator, MatchesExactEquityPerQuery) {
+    Board board{{"2h"_c, "7d"_c, "9c"_c}};
+    std::vector<Range> heroes{hand("Ah"_c, "Ad"_c), hand("8s"_c, "Ts"_c), Range{"KQs"_r}};
+    Range villain{"99"_r};
+    villain.addCombo("AK"_r);
+
+    Simulator::BatchPokerSimulator sim{heroes, board, 1, Factory::DeckFactory::createStandardDeck()};
+    auto results = sim.simulate({villain}, 40000, 11);
+    ASSERT_EQ(results.size(), heroes.size());
+
+    Simulator::ExactNLHStrategy exact{};
+    for (size_t q = 0; q < heroes.size(); ++q) {
+        auto expected = exact.run(heroes[q], board, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+        EXPECT_GT(results[q].trials, 0u);
+        EXPECT_NEAR(equity(results[q]), equity(expected), 0.015) << "query " << q;
+    }
+}
+
+TEST(BatchSimulator, QueryBlockedByBoardHasNoTrials) {
+    Board board{{"Ah"_c, "7d"_c, "9c"_c}};
+    std::vector<Range> heroes{hand("Ah"_c, "Ad"_c), hand("Ks"_c, "Kd"_c)};
+
+    Simulator::BatchPokerSimulator sim{heroes, board, 1, Factory::DeckFactory::createStandardDeck()};
+    auto results = sim.simulate({Range{"QQ"_r}}, 1000, 5);
+    EXPECT_EQ(results[0].trials, 0u);
+    EXPECT_GT(results[1].trials, 0u);
+}
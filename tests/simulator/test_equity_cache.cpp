@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/poker_simulator.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    Range hand(Card c1, Card c2) {
+        Range r{};
+        r.addCombo(c1, c2);
+        return r;
+    }
+
+    Simulator::SimResult makeResult(double win, double loss, size_t trials = 0) {
+        Simulator::SimResult r{};
+        r.win = win;
+        r.loss = loss;
+        r.trials = trials;
+        return r;
+    }
+
+    Simulator::PokerSimulator simulator(Range hero, Board board) {
+        return {std::move(hero), std::move(board), 1, Factory::DeckFactory::createStandardDeck()};
+    }
+}
+
+TEST(EquityCache, SuitIsomorphicQueriesShareAKey) {
+    auto deck = Factory::DeckFactory::createStandardDeck();
+    auto a = Simulator::makeEquityKey(hand("As"_c, "Ks"_c), Board{{"2s"_c, "7h"_c, "9d"_c}}, deck, {Range{"QQ"_r}}, 1000);
+    auto b = Simulator::makeEquityKey(hand("Ah"_c, "Kh"_c), Board{{"2h"_c, "7c"_c, "9s"_c}}, deck, {Range{"QQ"_r}}, 1000);
+    auto other_suits = Simulator::makeEquityKey(hand("Ah"_c, "Kh"_c), Board{{"2s"_c, "7c"_c, "9d"_c}}, deck, {Range{"QQ"_r}}, 1000);
+    auto other_iterations = Simulator::makeEquityKey(hand("As"_c, "Ks"_c), Board{{"2s"_c, "7h"_c, "9d"_c}}, deck, {Range{"QQ"_r}}, 2000);
+
+    EXPECT_EQ(a, b);
+    EXPECT_FALSE(a == other_suits);
+    EXPECT_FALSE(a == other_iterations);
+}
+
+TEST(EquityCache, HitReturnsStoredResultAndCountsStats) {
+    Simulator::EquityCache cache{64};
+    Simulator::ExactNLHStrategy exact{};
+    Range villain{"QQ"_r};
+
+    auto first = simulator(hand("As"_c, "Ks"_c), Board{{"2s"_c, "7h"_c, "9d"_c}}).simulate(cache, exact, {villain}, 0);
+    auto second = simulator(hand("Ad"_c, "Kd"_c), Board{{"2d"_c, "7s"_c, "9c"_c}}).simulate(cache, exact, {villain}, 0);
+
+    EXPECT_DOUBLE_EQ(first.win, second.win);
+    EXPECT_DOUBLE_EQ(first.tie, second.tie);
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(EquityCache, PerComboResultsAreRelabelledForTheCaller) {
+    Simulator::EquityCache cache{64};
+    Simulator::ExactNLHStrategy exact{Simulator::ResultMode::PerCombo};
+    Range villain{"QQ"_r};
+
+    simulator(hand("As"_c, "Ks"_c), Board{{"2s"_c, "7h"_c, "9d"_c}}).simulate(cache, exact, {villain}, 0);
+    auto hit = simulator(hand("Ad"_c, "Kd"_c), Board{{"2d"_c, "7s"_c, "9c"_c}}).simulate(cache, exact, {villain}, 0);
+    ASSERT_EQ(cache.stats().hits, 1u);
+
+    const Combo own{"Ad"_c, "Kd"_c, 1.0};
+    EXPECT_GT(hit.combos[comboIndex(own)].total(), 0.0);
+    EXPECT_EQ(hit.combos[comboIndex(Combo{"As"_c, "Ks"_c, 1.0})].total(), 0.0);
+}
+
+TEST(EquityCache, StrategiesDoNotShareEntries) {
+    Simulator::EquityCache cache{64};
+    Simulator::ExactNLHStrategy exact{};
+    Simulator::MonteCarloNLHStrategy monte_carlo{};
+    auto sim = simulator(hand("As"_c, "Ks"_c), Board{{"2s"_c, "7h"_c, "9d"_c}});
+
+    auto exact_result = sim.simulate(cache, exact, {Range{"QQ"_r}}, 50, 1);
+    auto monte_carlo_result = sim.simulate(cache, monte_carlo, {Range{"QQ"_r}}, 50, 1);
+
+    EXPECT_EQ(cache.stats().misses, 2u);
+    EXPECT_EQ(cache.stats().hits, 0u);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(monte_carlo_result.trials, 50u);
+    EXPECT_NE(exact_result.trials, monte_carlo_result.trials);
+
+    sim.simulate(cache, monte_carlo, {Range{"QQ"_r}}, 50, 2);
+    EXPECT_EQ(cache.stats().hits, 1u);
+}
+
+TEST(EquityCache, EvictsLeastRecentlyUsed) {
+    Simulator::EquityCache cache{2, 1};
+    auto deck = Factory::DeckFactory::createStandardDeck();
+    auto key = [&](int iterations) {
+        return Simulator::makeEquityKey(Range{"AA"_r}, Board{}, deck, {Range{"KK"_r}}, iterations);
+    };
+
+    cache.insert(key(1), makeResult(0.1, 0.9));
+    cache.insert(key(2), makeResult(0.2, 0.8));
+    ASSERT_TRUE(cache.find(key(1)).has_value()); // 2 is now least recently used
+    cache.insert(key(3), makeResult(0.3, 0.7));
+
+    EXPECT_TRUE(cache.find(key(1)).has_value());
+    EXPECT_FALSE(cache.find(key(2)).has_value());
+    EXPECT_TRUE(cache.find(key(3)).has_value());
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(EquityCache, ConcurrentCallersSeeConsistentCounts) {
+    Simulator::EquityCache cache{1024};
+    auto deck = Factory::DeckFactory::createStandardDeck();
+    std::vector<Simulator::EquityKey> keys;
+    for (int i = 1; i <= 32; ++i) keys.push_back(Simulator::makeEquityKey(Range{"AA"_r}, Board{}, deck, {Range{"KK"_r}}, i));
+
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 200;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&, t] {
+                for (int r = 0; r < ROUNDS; ++r) {
+                    const auto& key = keys[(t + r) % keys.size()];
+                    auto result = cache.getOrCompute(key, [&] { return makeResult(1.0, 0.0, key.words[2]); });
+                    EXPECT_EQ(result.trials, key.words[2]);
+                }
+            });
+        }
+    }
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, static_cast<uint64_t>(THREADS * ROUNDS));
+    EXPECT_EQ(cache.size(), keys.size());
+    EXPECT_EQ(stats.evictions, 0u);
+}
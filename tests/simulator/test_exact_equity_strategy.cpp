@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+#include "PokerEngine/simulator/poker_simulator.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    // Reference equity from the vector based evaluator on every river
+    double bruteForceEquity(const std::vector<Card>& board, const std::vector<Card>& hero, const std::vector<Card>& villain) {
+        Evaluator::HandEvaluator eval{};
+        auto deck = Factory::DeckFactory::createStandardDeck();
+        deck.remove(board);
+        deck.remove(hero);
+        deck.remove(villain);
+
+        std::vector<Card> cards(deck.begin(), deck.end());
+        double won = 0.0, total = 0.0;
+        for (const auto& river : cards) {
+            auto h = hero; h.insert(h.end(), board.begin(), board.end()); h.push_back(river);
+            auto v = villain; v.insert(v.end(), board.begin(), board.end()); v.push_back(river);
+            auto hs = eval.evaluate(h).score, vs = eval.evaluate(v).score;
+            won += hs > vs ? 1.0 : (hs == vs ? 0.5 : 0.0);
+            total += 1.0;
+        }
+        return won / total;
+    }
+}
+
+TEST(ExactEquityStrategy, HandVsHandMatchesBruteForce) {
+    std::vector<Card> board{"2h"_c, "7d"_c, "9c"_c, "Kd"_c};
+    Range hero, villain;
+    hero.addCombo("Ah"_c, "Ad"_c);
+    villain.addCombo("8d"_c, "Td"_c);
+
+    Simulator::PokerSimulator sim{hero, Board{board}, 1, Factory::DeckFactory::createStandardDeck()};
+    auto result = sim.simulate(Simulator::ExactNLHStrategy{}, {villain}, 0);
+
+    EXPECT_NEAR(result.win + result.tie / 2.0, bruteForceEquity(board, {"Ah"_c, "Ad"_c}, {"8d"_c, "Td"_c}), 1e-12);
+    EXPECT_NEAR(result.win + result.tie + result.loss, 1.0, 1e-12);
+}
+
+TEST(ExactEquityStrategy, RangeVsRangeWeightsPairs) {
+    std::vector<Card> board{"2h"_c, "7d"_c, "9c"_c, "Kd"_c};
+    Range hero, villain;
+    hero.addCombo("Ah"_c, "Ad"_c, 1.0);
+    hero.addCombo("Qs"_c, "Js"_c, 3.0);
+    villain.addCombo("8d"_c, "Td"_c);
+
+    Simulator::ExactNLHStrategy strategy{};
+    auto result = strategy.run(hero, Board{board}, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+
+    double expected = (1.0 * bruteForceEquity(board, {"Ah"_c, "Ad"_c}, {"8d"_c, "Td"_c}) +
+                       3.0 * bruteForceEquity(board, {"Qs"_c, "Js"_c}, {"8d"_c, "Td"_c})) / 4.0;
+    EXPECT_NEAR(result.win + result.tie / 2.0, expected, 1e-12);
+}
+
+TEST(ExactEquityStrategy, MemoisesIsomorphicPairs) {
+    Simulator::ExactNLHStrategy strategy{};
+    // on a monotone board the three other suits are interchangeable, so AKs vs QQ collapses to a few classes
+    Range hero{"AKs"_r};
+    Range villain{"QQ"_r};
+    auto board = Board{{"2h"_c, "7h"_c, "9h"_c, "3h"_c}};
+
+    strategy.run(hero, board, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+    EXPECT_LT(strategy.memoSize(), hero.size() * villain.size());
+
+    auto before = strategy.memoSize();
+    strategy.run(hero, board, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+    EXPECT_EQ(strategy.memoSize(), before);
+}
+
+TEST(ExactEquityStrategy, MemoIsBoundedAndOptional) {
+    const Range hero{"AKs"_r};
+    Range villain{"QQ"_r};
+    villain.addCombo("JJ"_r);
+    const auto board = Board{{"2h"_c, "7d"_c, "9c"_c, "3s"_c}};
+
+    Simulator::ExactNLHStrategy bounded{Simulator::ResultMode::Aggregate, 4};
+    const auto expected = bounded.run(hero, board, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+    EXPECT_LE(bounded.memoSize(), 4u);
+
+    // moves keep the memo, no memo gives the same answer
+    Simulator::ExactNLHStrategy moved = std::move(bounded);
+    EXPECT_LE(moved.memoSize(), 4u);
+    Simulator::ExactNLHStrategy unmemoised{Simulator::ResultMode::Aggregate, 0};
+    const auto result = unmemoised.run(hero, board, 1, Factory::DeckFactory::createStandardDeck(), {villain});
+    EXPECT_EQ(unmemoised.memoSize(), 0u);
+    EXPECT_DOUBLE_EQ(result.win, expected.win);
+    EXPECT_DOUBLE_EQ(result.tie, expected.tie);
+}
+
+TEST(ExactEquityStrategy, RejectsMultiway) {
+    Simulator::ExactNLHStrategy strategy{};
+    Range r{"AA"_r};
+    EXPECT_THROW(strategy.run(r, Board{}, 2, Factory::DeckFactory::createStandardDeck(), {r, r}), std::invalid_argument);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/hand_strength.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    CardMask mask(std::vector<Card> cards) { return cardsMask(cards); }
+}
+
+TEST(HandStrength, SingleVillainComboMatchesExactEquity) {
+    Simulator::HandStrengthEngine engine{10};
+    const CardMask board = mask({"2c"_c, "7d"_c, "9h"_c});
+    Range villain{};
+    villain.addCombo("Ks"_c, "Kd"_c);
+
+    auto hs = engine.compute(mask({"Ah"_c, "As"_c}), board, villain);
+    // one villain hand, so every runout is a full weight comparison and EHS is the exact equity
+    Simulator::ExactNLHStrategy exact{};
+    auto expected = exact.pairEquity(board, mask({"Ah"_c, "As"_c}), mask({"Ks"_c, "Kd"_c}), (1ULL << NUM_CARDS) - 1);
+
+    EXPECT_EQ(hs.runouts, 990u);
+    EXPECT_NEAR(hs.ehs, expected.win + expected.tie / 2.0, 1e-12);
+    EXPECT_NEAR(std::accumulate(hs.histogram.begin(), hs.histogram.end(), 0.0), 1.0, 1e-12);
+    // equity on the river is 0, 0.5 or 1 against a single hand
+    EXPECT_NEAR(hs.histogram.front() + hs.histogram[5] + hs.histogram.back(), 1.0, 1e-12);
+}
+
+TEST(HandStrength, RiverHasOneRunout) {
+    Simulator::HandStrengthEngine engine{};
+    const CardMask board = mask({"As"_c, "Ks"_c, "Qs"_c, "2c"_c, "7d"_c});
+
+    auto hs = engine.compute(mask({"Js"_c, "Ts"_c}), board);
+    EXPECT_EQ(hs.runouts, 1u);
+    EXPECT_DOUBLE_EQ(hs.ehs, 1.0); // royal flush, nothing beats or ties it
+    EXPECT_DOUBLE_EQ(hs.ehs2, 1.0);
+    EXPECT_DOUBLE_EQ(hs.histogram.back(), 1.0);
+}
+
+TEST(HandStrength, DrawHasHigherSpreadThanMadeHand) {
+    Simulator::HandStrengthEngine engine{20};
+    const CardMask board = mask({"2h"_c, "7h"_c, "Kc"_c, "4d"_c});
+
+    auto draw = engine.compute(mask({"Ah"_c, "9h"_c}), board);
+    auto made = engine.compute(mask({"7c"_c, "7s"_c}), board);
+
+    EXPECT_EQ(draw.runouts, 46u);
+    EXPECT_GE(draw.ehs2, draw.ehs * draw.ehs);
+    EXPECT_GT(made.ehs, draw.ehs);
+    EXPECT_GT(draw.ehs2 - draw.ehs * draw.ehs, made.ehs2 - made.ehs * made.ehs);
+}
+
+TEST(HandStrength, RejectsInvalidInput) {
+    Simulator::HandStrengthEngine engine{};
+    EXPECT_THROW(engine.compute(mask({"Ah"_c, "9h"_c}), mask({"2c"_c, "7d"_c})), std::invalid_argument);
+    EXPECT_THROW(engine.compute(mask({"Ah"_c, "2c"_c}), mask({"2c"_c, "7d"_c, "9h"_c})), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/core/card_mask.hpp"
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/monte_carlo_strategy.hpp"
+#include "PokerEngine/simulator/parallel_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    Range heroRange() {
+        Range r{};
+        r.addCombo("Ah"_c, "Ad"_c);
+        r.addCombo("7c"_c, "2d"_c);
+        return r;
+    }
+
+    Range villainRange() {
+        Range r{};
+        r.addCombo("Qs"_c, "Qc"_c);
+        return r;
+    }
+}
+
+TEST(MonteCarloStrategy, SameSeedSameResult) {
+    Simulator::MonteCarloNLHStrategy strategy{};
+    auto deck = Factory::DeckFactory::createStandardDeck();
+
+    auto r1 = strategy.run(heroRange(), Board{}, 1, deck, {villainRange()}, 2000, 42);
+    auto r2 = strategy.run(heroRange(), Board{}, 1, deck, {villainRange()}, 2000, 42);
+    EXPECT_EQ(r1.win, r2.win);
+    EXPECT_EQ(r1.tie, r2.tie);
+    EXPECT_EQ(r1.trials, 2000);
+}
+
+TEST(MonteCarloStrategy, PerComboBreakdown) {
+    Simulator::MonteCarloNLHStrategy strategy{Simulator::ResultMode::PerCombo};
+    auto deck = Factory::DeckFactory::createStandardDeck();
+
+    auto result = strategy.run(heroRange(), Board{}, 1, deck, {villainRange()}, 20000, 7);
+    ASSERT_EQ(result.combos.size(), NUM_COMBOS);
+
+    const auto& aces = result.combos[comboIndex(Combo{"Ah"_c, "Ad"_c, 1.0})];
+    const auto& seven_deuce = result.combos[comboIndex(Combo{"7c"_c, "2d"_c, 1.0})];
+    EXPECT_NEAR(aces.equity(), 0.81, 0.03);
+    EXPECT_NEAR(seven_deuce.equity(), 0.12, 0.03);
+
+    double total = 0.0, wins = 0.0;
+    for (const auto& tally : result.combos) {
+        total += tally.total();
+        wins += tally.win;
+    }
+    EXPECT_DOUBLE_EQ(total, 20000.0);
+    EXPECT_NEAR(wins / total, result.win, 1e-12);
+}
+
+TEST(MonteCarloStrategy, ParallelMergesThreads) {
+    Simulator::ParallelStrategy strategy{Simulator::MonteCarloNLHStrategy{Simulator::ResultMode::PerCombo}, 4};
+    auto deck = Factory::DeckFactory::createStandardDeck();
+
+    auto result = strategy.run(heroRange(), Board{}, 1, deck, {villainRange()}, 10001, 3);
+    EXPECT_EQ(result.trials, 10001);
+    EXPECT_NEAR(result.win + result.tie + result.loss, 1.0, 1e-12);
+
+    double total = 0.0;
+    for (const auto& tally : result.combos) total += tally.total();
+    EXPECT_DOUBLE_EQ(total, 10001.0);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/preflop_table.hpp"
+#include "PokerEngine/simulator/poker_simulator.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    // Table with exact AA vs KK entries and a recognisable placeholder everywhere else
+    std::string writeTestTable() {
+        std::vector<float> win(Simulator::PreflopEquityTable::COMBO_CELLS, 0.25f);
+        std::vector<float> tie(Simulator::PreflopEquityTable::COMBO_CELLS, 0.5f);
+
+        Simulator::ExactNLHStrategy exact{};
+        const CardMask deck = (CardMask{1} << NUM_CARDS) - 1;
+        const Range aces_range{"AA"_r}, kings_range{"KK"_r};
+        for (const auto& aces : aces_range.combos()) {
+            for (const auto& kings : kings_range.combos()) {
+                auto r = exact.pairEquity(0, comboMask(aces), comboMask(kings), deck);
+                size_t cell = static_cast<size_t>(comboIndex(aces)) * NUM_COMBOS + comboIndex(kings);
+                win[cell] = static_cast<float>(r.win);
+                tie[cell] = static_cast<float>(r.tie);
+            }
+        }
+
+        auto path = (std::filesystem::temp_directory_path() / "poker_engine_test_preflop.bin").string();
+        Simulator::PreflopEquityTable::write(path, win, tie);
+        return path;
+    }
+}
+
+TEST(PreflopTable, HandClassIndex) {
+    using Simulator::handClassIndex;
+    EXPECT_EQ(handClassIndex("AA"_r), 12 * 13 + 12);
+    EXPECT_EQ(handClassIndex("AKs"_r), handClassIndex(cardIndex("Ah"_c), cardIndex("Kh"_c)));
+    EXPECT_EQ(handClassIndex("AKo"_r), handClassIndex(cardIndex("Ah"_c), cardIndex("Kd"_c)));
+    EXPECT_NE(handClassIndex("AKs"_r), handClassIndex("AKo"_r));
+}
+
+TEST(PreflopTable, RoundTripsThroughMappedFile) {
+    auto path = writeTestTable();
+    {
+        Simulator::PreflopEquityTable table{path};
+
+        auto placeholder = table.comboEquity(comboIndex(Combo{"2h"_c, "3h"_c, 1.0}), comboIndex(Combo{"4d"_c, "5d"_c, 1.0}));
+        EXPECT_FLOAT_EQ(placeholder.win, 0.25f);
+        EXPECT_FLOAT_EQ(placeholder.tie, 0.5f);
+
+        Simulator::ExactNLHStrategy exact{};
+        auto expected = exact.run(Range{"AA"_r}, Board{}, 1, Factory::DeckFactory::createStandardDeck(), {Range{"KK"_r}});
+        auto from_table = table.rangeEquity(Range{"AA"_r}, Range{"KK"_r});
+        EXPECT_NEAR(from_table.win, expected.win, 1e-6);
+        EXPECT_NEAR(from_table.tie, expected.tie, 1e-6);
+
+        // class cell is the average over all AA vs KK combo pairs
+        auto cls = table.classEquity(Simulator::handClassIndex("AA"_r), Simulator::handClassIndex("KK"_r));
+        EXPECT_NEAR(cls.win, expected.win, 1e-6);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(PreflopTable, SimulatorUsesTableOnEmptyBoard) {
+    auto path = writeTestTable();
+    {
+        auto table = std::make_shared<const Simulator::PreflopEquityTable>(path);
+        Simulator::PokerSimulator preflop{Range{"AA"_r}, Board{}, 1, Factory::DeckFactory::createStandardDeck()};
+        preflop.usePreflopTable(table);
+
+        auto result = preflop.simulate(Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, 10);
+        EXPECT_NEAR(result.win, table->rangeEquity(Range{"AA"_r}, Range{"KK"_r}).win, 1e-12);
+        EXPECT_EQ(result.trials, 36u);
+
+        Simulator::PokerSimulator flop{Range{"AA"_r}, Board{{"2h"_c, "7d"_c, "9c"_c}}, 1, Factory::DeckFactory::createStandardDeck()};
+        flop.usePreflopTable(table);
+        EXPECT_EQ(flop.simulate(Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, 10).trials, 10u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(PreflopTable, RejectsWrongFile) {
+    auto path = (std::filesystem::temp_directory_path() / "poker_engine_not_a_table.bin").string();
+    { std::ofstream out(path); out << "not a table"; }
+    EXPECT_THROW(Simulator::PreflopEquityTable{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
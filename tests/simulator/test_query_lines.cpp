@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "PokerEngine/simulator/query_lines.hpp"
+
+using namespace PokerEngine::Simulator;
+
+TEST(QueryLinesTest, ParsesQueryFields) {
+    const EquityQuery q = parseEquityQuery(
+        R"({"id": "n\"7", "hero": "AsAd", "villain_range": "KK+, AKs", "board": "2h3cTs", "iterations": 50000, "extra": true})");
+    EXPECT_EQ(q.id, R"("n\"7")");
+    EXPECT_EQ(q.hero, "AsAd");
+    EXPECT_TRUE(q.hero_range.empty());
+    EXPECT_EQ(q.villain_range, "KK+, AKs");
+    EXPECT_EQ(q.board, "2h3cTs");
+    EXPECT_EQ(q.trials(), 50000);
+
+    const EquityQuery a = parseEquityQuery(R"({"id":3,"hero_range":"QQ+","villain":null,"accuracy":0.005})");
+    EXPECT_EQ(a.id, "3");
+    EXPECT_EQ(a.hero_range, "QQ+");
+    EXPECT_EQ(a.trials(), 10000);
+    EXPECT_EQ(parseEquityQuery("{}").trials(), 10000);
+    EXPECT_EQ(parseEquityQuery(R"({"id": -1.5e3})").id, "-1.5e3");
+    EXPECT_EQ(parseEquityQuery(R"({"id": true})").id, "true");
+    EXPECT_EQ(parseEquityQuery(R"({"id": null})").id, "null");
+}
+
+TEST(QueryLinesTest, RejectsMalformedLines) {
+    EXPECT_THROW(parseEquityQuery("hero=AsAd"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"hero": "AsAd")"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"hero": ["AsAd"]})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"hero": 5})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"iterations": "many"})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"iterations": 0})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"hero": "AsAd"} x)"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"accuracy": nan})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"accuracy": inf})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"accuracy": -inf, "iterations": 100})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"iterations": nan})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"iterations": inf})"), std::invalid_argument);
+    // the id is echoed verbatim, so bare tokens would make the output line invalid JSON
+    EXPECT_THROW(parseEquityQuery(R"({"id": abc})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"id": 01})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"id": +1})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"id": 1.})"), std::invalid_argument);
+    EXPECT_THROW(parseEquityQuery(R"({"id": nan})"), std::invalid_argument);
+}
+
+TEST(QueryLinesTest, TrialsAreAtLeastOne) {
+    EquityQuery q{};
+    q.accuracy = 10.0;
+    EXPECT_EQ(q.trials(), 1);
+    q.accuracy = 1e-12;
+    EXPECT_EQ(q.trials(), 1000000000);
+    q.accuracy = 0.0;
+    q.iterations = 0;
+    EXPECT_EQ(q.trials(), 1);
+}
+
+TEST(QueryLinesTest, FormatsResultsAndErrors) {
+    EquityQuery q{};
+    q.id = "12";
+    SimResult r{};
+    r.win = 0.5;
+    r.tie = 0.1;
+    r.loss = 0.4;
+    EXPECT_EQ(formatEquityResult(q, r, 1000),
+              R"({"id":12,"win":0.500000,"tie":0.100000,"loss":0.400000,"equity":0.550000,"iterations":1000})");
+    EXPECT_EQ(formatEquityError("", "bad \"card\"\n"), R"({"error":"bad \"card\"\n"})");
+}
+
+TEST(QueryLinesTest, AnswersInInputOrderWithBoundedReadAhead) {
+    std::ostringstream input;
+    for (int i = 0; i < 200; ++i) input << i << (i % 50 == 0 ? "\n\n" : "\n");
+    std::istringstream in(input.str());
+    std::ostringstream out;
+
+    std::atomic<int> in_flight{0};
+    std::atomic<int> peak{0};
+    const size_t answered = answerLinesInOrder(in, out, [&](std::string_view line) {
+        const int now = ++in_flight;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        // later lines finish first
+        const int n = std::stoi(std::string(line));
+        std::this_thread::sleep_for(std::chrono::microseconds((200 - n) % 7 * 50));
+        --in_flight;
+        return "r" + std::string(line);
+    }, 4, 8);
+
+    EXPECT_EQ(answered, 200u);
+    EXPECT_LE(peak.load(), 8);
+    std::istringstream lines(out.str());
+    std::string line;
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(std::getline(lines, line));
+        EXPECT_EQ(line, "r" + std::to_string(i));
+    }
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
+TEST(QueryLinesTest, RethrowsAfterEarlierAnswers) {
+    std::istringstream in("1\n2\nboom\n4\n");
+    std::ostringstream out;
+    EXPECT_THROW(answerLinesInOrder(in, out, [](std::string_view line) {
+        if (line == "boom") throw std::runtime_error("boom");
+        return std::string(line);
+    }, 1, 4), std::runtime_error);
+    EXPECT_EQ(out.str(), "1\n2\n");
+}
+
+TEST(QueryLinesTest, WaitsForSlowerEarlierLinesBeforeRethrowing) {
+    std::istringstream in("slow\nbad\n");
+    std::ostringstream out;
+    EXPECT_THROW(answerLinesInOrder(in, out, [](std::string_view line) {
+        if (line == "bad") throw std::runtime_error("bad");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::string(line);
+    }, 2, 4), std::runtime_error);
+    EXPECT_EQ(out.str(), "slow\n");
+}
+
+TEST(QueryLinesTest, RangeCacheKeepsRangesInUseAcrossEvictions) {
+    // one worker answering more distinct ranges than the cache holds, as a long batch does
+    RangeCache cache;
+    std::istringstream in([&] {
+        std::string lines;
+        for (size_t i = 0; i < RangeCache::DEFAULT_CAPACITY + 100; ++i) lines += std::to_string(i) + "\n";
+        return lines;
+    }());
+    std::ostringstream out;
+
+    size_t misses = 0;
+    auto parse = [&](std::string_view hand) {
+        return [&misses, hand] {
+            ++misses;
+            PokerEngine::Core::Range range{};
+            range.addCombo(PokerEngine::Core::Card(hand.substr(0, 2)), PokerEngine::Core::Card(hand.substr(2, 2)));
+            return range;
+        };
+    };
+    const size_t answered = answerLinesInOrder(in, out, [&](std::string_view line) {
+        const std::string n(line);
+        const auto hero = cache.get("hero " + n, parse("AsAh"));
+        const auto villain = cache.get("villain " + n, parse("KsKh"));
+        EXPECT_LE(cache.size(), cache.capacity());
+        return std::to_string(hero->combos().size() + villain->combos().size());
+    }, 1);
+
+    EXPECT_EQ(answered, RangeCache::DEFAULT_CAPACITY + 100);
+    EXPECT_EQ(misses, 2 * answered);
+    std::istringstream written(out.str());
+    std::string line;
+    while (std::getline(written, line)) ASSERT_EQ(line, "2");
+
+    const auto kept = cache.get("villain 0", parse("QsQh"));
+    EXPECT_EQ(cache.get("villain 0", parse("JsJh")), kept);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "PokerEngine/simulator/river_sweep.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    // pairwise reference: equity of each combo of mine against every live combo of theirs
+    std::vector<double> bruteForce(const Range& mine, const Range& theirs, CardMask board) {
+        Evaluator::HandEvaluator eval{};
+        std::vector<double> result;
+        for (const auto& m : mine.combos()) {
+            const CardMask mm = comboMask(m);
+            double won = 0.0, total = 0.0;
+            for (const auto& t : theirs.combos()) {
+                const CardMask tm = comboMask(t);
+                if (mm & board || tm & (board | mm)) continue;
+                const auto ms = eval.score(board | mm), ts = eval.score(board | tm);
+                won += t.weight * (ms > ts ? 1.0 : ms == ts ? 0.5 : 0.0);
+                total += t.weight;
+            }
+            result.push_back(total > 0.0 ? won / total : 0.0);
+        }
+        return result;
+    }
+
+    Range randomRange(std::mt19937& rng, int size) {
+        Range r{};
+        std::uniform_int_distribution<int> card(0, NUM_CARDS - 1);
+        std::uniform_real_distribution<double> weight(0.1, 1.0);
+        while (static_cast<int>(r.size()) < size) {
+            const int a = card(rng), b = card(rng);
+            if (a == b) continue;
+            r.addCombo(cardFromIndex(a), cardFromIndex(b), weight(rng));
+        }
+        return r;
+    }
+}
+
+TEST(RiverSweep, MatchesPairwiseComparisonWithCardRemoval) {
+    std::mt19937 rng(17);
+    const Board board{{"Ah"_c, "Kh"_c, "7h"_c, "7c"_c, "2d"_c}};
+    const CardMask board_mask = cardsMask(board.get());
+
+    for (int round = 0; round < 5; ++round) {
+        Range hero = randomRange(rng, 150);
+        Range villain = randomRange(rng, 200);
+        // shared combos exercise the identical combo correction
+        for (size_t i = 0; i < 20; ++i) {
+            const auto& c = hero.combos()[i];
+            villain.addCombo(c.c1, c.c2, 0.5);
+        }
+
+        const auto result = Simulator::riverEquities(hero, villain, board);
+        const auto hero_expected = bruteForce(hero, villain, board_mask);
+        const auto villain_expected = bruteForce(villain, hero, board_mask);
+
+        ASSERT_EQ(result.hero.equity.size(), hero.size());
+        ASSERT_EQ(result.villain.equity.size(), villain.size());
+        for (size_t i = 0; i < hero.size(); ++i) EXPECT_NEAR(result.hero.equity[i], hero_expected[i], 1e-9);
+        for (size_t i = 0; i < villain.size(); ++i) EXPECT_NEAR(result.villain.equity[i], villain_expected[i], 1e-9);
+    }
+}
+
+TEST(RiverSweep, BoardBlockedCombosHaveNoWeight) {
+    const Board board{{"Ah"_c, "Kh"_c, "7h"_c, "7c"_c, "2d"_c}};
+    Range hero{};
+    hero.addCombo("Ah"_c, "Ad"_c);
+    hero.addCombo("Qh"_c, "Jh"_c);
+    Range villain{"QQ"_r};
+
+    const auto result = Simulator::riverEquities(hero, villain, board);
+    for (size_t i = 0; i < hero.size(); ++i) {
+        if (hero.combos()[i].c1 == "Ad"_c || hero.combos()[i].c2 == "Ad"_c) {
+            EXPECT_EQ(result.hero.live_weight[i], 0.0);
+        } else {
+            EXPECT_DOUBLE_EQ(result.hero.equity[i], 1.0); // flush against the three queens combos without Qh
+            EXPECT_DOUBLE_EQ(result.hero.live_weight[i], 3.0);
+        }
+    }
+}
+
+TEST(RiverSweep, OverlappingTokensCountTheComboOnce) {
+    const Board board{{"Ah"_c, "8h"_c, "7h"_c, "7c"_c, "2d"_c}};
+    // KK is added twice, the sweep sees it once with double weight
+    Range hero{"QQ+"_r};
+    hero.addCombo("KK"_r);
+    Range villain{"QQ+"_r};
+    villain.addCombo("KK"_r);
+    villain.addCombo("AK"_r);
+
+    const auto result = Simulator::riverEquities(hero, villain, board);
+    const CardMask board_mask = cardsMask(board.get());
+    const auto hero_expected = bruteForce(hero, villain, board_mask);
+    const auto villain_expected = bruteForce(villain, hero, board_mask);
+
+    ASSERT_EQ(result.hero.equity.size(), hero.size());
+    ASSERT_EQ(result.villain.equity.size(), villain.size());
+    for (size_t i = 0; i < hero.size(); ++i) EXPECT_NEAR(result.hero.equity[i], hero_expected[i], 1e-9);
+    for (size_t i = 0; i < villain.size(); ++i) EXPECT_NEAR(result.villain.equity[i], villain_expected[i], 1e-9);
+
+    const std::vector<CardMask> hands{cardsMask({"Kc"_c, "Kd"_c})};
+    const std::vector<CardMask> repeated{cardsMask({"Qc"_c, "Qd"_c}), cardsMask({"Qd"_c, "Qc"_c})};
+    EXPECT_THROW((Simulator::RiverSweep{hands, repeated, board_mask}), std::invalid_argument);
+}
+
+TEST(RiverSweep, RequiresCompleteBoard) {
+    EXPECT_THROW(Simulator::riverEquities(Range{"AA"_r}, Range{"KK"_r}, Board{{"2c"_c, "3d"_c, "4h"_c}}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/runout_explorer.hpp"
+#include "PokerEngine/simulator/exact_equity_strategy.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    double equity(const Simulator::SimResult& r) { return r.win + r.tie / 2.0; }
+
+    Board with(const Board& board, Card card) {
+        auto cards = board.get();
+        cards.push_back(card);
+        return Board{cards};
+    }
+}
+
+TEST(RunoutExplorer, EnumerateMatchesExactEquityPerTurnCard) {
+    Board flop{{"Ah"_c, "7d"_c, "2c"_c}};
+    Range hero{"AK"_r};
+    hero.addCombo("8h"_c, "9h"_c);
+    Range villain{"77"_r};
+    villain.addCombo("QQ"_r);
+
+    Simulator::RunoutExplorer explorer{hero, flop, 1, Factory::DeckFactory::createStandardDeck()};
+    auto table = explorer.enumerate(villain);
+    ASSERT_EQ(table.size(), 49u);
+
+    Simulator::ExactNLHStrategy exact{};
+    for (size_t i = 0; i < table.size(); i += 6) {
+        const auto& entry = table[i];
+        auto expected = exact.run(hero, with(flop, entry.card), 1, Factory::DeckFactory::createStandardDeck(), {villain});
+        EXPECT_NEAR(entry.result.win, expected.win, 1e-9) << "turn " << i;
+        EXPECT_NEAR(entry.result.tie, expected.tie, 1e-9) << "turn " << i;
+    }
+}
+
+TEST(RunoutExplorer, SimulateAgreesWithEnumerate) {
+    Board flop{{"Kh"_c, "9h"_c, "4d"_c}};
+    Range hero{};
+    hero.addCombo("Ah"_c, "Qh"_c);
+    Range villain{"99"_r};
+    villain.addCombo("KQ"_r);
+
+    Simulator::RunoutExplorer explorer{hero, flop, 1, Factory::DeckFactory::createStandardDeck()};
+    auto exact = explorer.enumerate(villain);
+    auto sampled = explorer.simulate({villain}, 200000, 3);
+    ASSERT_EQ(exact.size(), sampled.size());
+
+    size_t trials = 0;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        EXPECT_EQ(exact[i].card, sampled[i].card);
+        trials += sampled[i].result.trials;
+        if (exact[i].result.trials == 0) {
+            EXPECT_EQ(sampled[i].result.trials, 0u) << "card " << i;
+            continue;
+        }
+        EXPECT_NEAR(equity(sampled[i].result), equity(exact[i].result), 0.05) << "card " << i;
+    }
+    EXPECT_EQ(trials, 2u * 200000u); // every flop deal feeds both of its runout cards
+}
+
+TEST(RunoutExplorer, RiverCardsFromTurn) {
+    Board turn{{"Ah"_c, "7d"_c, "2c"_c, "Ts"_c}};
+    Range hero{"KK"_r};
+    Range villain{"AQ"_r};
+
+    Simulator::RunoutExplorer explorer{hero, turn, 1, Factory::DeckFactory::createStandardDeck()};
+    auto table = explorer.enumerate(villain);
+    ASSERT_EQ(table.size(), 48u);
+    for (const auto& entry : table) {
+        if (entry.card.rank() == Rank::King) {
+            EXPECT_GT(equity(entry.result), 0.99);
+        } else if (entry.card.rank() == Rank::Three) {
+            EXPECT_LT(equity(entry.result), 0.01);
+        }
+    }
+}
+
+TEST(RunoutExplorer, RejectsBoardWithoutNextCard) {
+    Simulator::RunoutExplorer preflop{Range{"AA"_r}, Board{}, 1, Factory::DeckFactory::createStandardDeck()};
+    EXPECT_THROW(preflop.enumerate(Range{"KK"_r}), std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <atomic>
+
+#include "PokerEngine/core/factory/deck_factory.hpp"
+#include "PokerEngine/simulator/simulation_job.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    Simulator::PokerSimulator makeSim() {
+        return Simulator::PokerSimulator{Range{"AA"_r}, Board{}, 1, Factory::DeckFactory::createStandardDeck()};
+    }
+}
+
+TEST(SimulationJob, RunsToMaxIterationsWithProgress) {
+    std::atomic<int> snapshots{0};
+    Simulator::JobOptions options{};
+    options.max_iterations = 5000;
+    options.chunk_iterations = 1000;
+    options.on_progress = [&](const Simulator::SimResult& r) {
+        ++snapshots;
+        EXPECT_NEAR(r.win + r.tie + r.loss, 1.0, 1e-9);
+    };
+
+    auto job = Simulator::simulateAsync(makeSim(), Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, options, 1);
+    auto result = job.get();
+
+    EXPECT_EQ(result.trials, 5000u);
+    EXPECT_EQ(snapshots.load(), 5);
+    EXPECT_NEAR(result.win, 0.81, 0.04);
+}
+
+TEST(SimulationJob, DeadlineReturnsBestEstimate) {
+    Simulator::JobOptions options{};
+    options.chunk_iterations = 500;
+    options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+
+    auto start = std::chrono::steady_clock::now();
+    auto job = Simulator::simulateAsync(makeSim(), Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, options, 2);
+    auto result = job.get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GT(result.trials, 0u);
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
+
+TEST(SimulationJob, DeadlineStartsWithProbeChunk) {
+    Simulator::JobOptions options{};
+    options.chunk_iterations = 100000000;
+    options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    std::vector<size_t> trials;
+    options.on_progress = [&](const Simulator::SimResult& r) { trials.push_back(r.trials); };
+
+    auto job = Simulator::simulateAsync(makeSim(), Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, options, 3);
+    job.get();
+
+    ASSERT_FALSE(trials.empty());
+    EXPECT_LE(trials.front(), static_cast<size_t>(Simulator::PROBE_ITERATIONS));
+}
+
+TEST(SimulationJob, StopTokenCancels) {
+    std::stop_source source;
+    Simulator::JobOptions options{};
+    options.chunk_iterations = 200;
+    options.stop_token = source.get_token();
+
+    auto job = Simulator::simulateAsync(makeSim(), Simulator::MonteCarloNLHStrategy{}, {Range{"KK"_r}}, options, 3);
+    while (job.snapshot().trials == 0) std::this_thread::yield();
+    source.request_stop();
+
+    auto result = job.get();
+    EXPECT_GT(result.trials, 0u);
+    EXPECT_TRUE(job.ready());
+}
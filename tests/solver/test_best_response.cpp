@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "PokerEngine/solver/best_response.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    const Board RIVER{{"As"_c, "Ks"_c, "Qd"_c, "7c"_c, "2h"_c}};
+    const Board TURN{{"As"_c, "Ks"_c, "Qd"_c, "7c"_c}};
+
+    Range range(std::initializer_list<RangeToken> tokens) {
+        Range r{};
+        for (const auto& t : tokens) r.addCombo(t);
+        return r;
+    }
+
+    // every action equally likely for every hand
+    void uniform(size_t, CardMask, std::span<const CardMask> hands, std::span<double> strategy) {
+        const double p = static_cast<double>(hands.size()) / static_cast<double>(strategy.size());
+        std::fill(strategy.begin(), strategy.end(), p);
+    }
+
+    Solver::GameTree turnTree() {
+        Solver::GameTreeConfig config{};
+        config.board_size = 4;
+        config.pot = 100;
+        config.stacks = {150, 150};
+        for (auto& street : config.streets) {
+            street.bet_sizes = {0.75};
+            street.max_raises = 1;
+        }
+        return Solver::GameTree{config};
+    }
+}
+
+TEST(BestResponse, MatchesRiverSolverExploitability) {
+    const Range oop = range({"AA"_r, "KK"_r, "QQ"_r, "JJ"_r, "AK"_r, "AQ"_r});
+    const Range ip = range({"KK"_r, "QQ"_r, "JJ"_r, "TT"_r, "AK"_r, "KQ"_r});
+    Solver::RiverSolver solver{oop, ip, RIVER, 100, 200, 200};
+    solver.solve(100, 0.0, 100);
+
+    const Solver::BestResponse engine{solver.tree(), oop, ip, RIVER, 4};
+    const auto result = engine.compute(Solver::averageStrategyProfile(solver));
+    EXPECT_NEAR(result.exploitability, solver.exploitability(), 1e-9);
+    EXPECT_GE(result.exploitability, 0.0);
+}
+
+TEST(BestResponse, UniformStrategyIsExploitable) {
+    const auto tree = turnTree();
+    const Solver::BestResponse engine{tree, range({"AA"_r, "KK"_r, "QQ"_r, "JJ"_r}),
+                                      range({"AK"_r, "AQ"_r, "KQ"_r, "TT"_r}), TURN, 4};
+    const auto result = engine.compute(uniform);
+
+    EXPECT_GT(result.exploitability, 0.0);
+    // each best response at least matches folding or checking down with the whole range
+    EXPECT_GT(result.values[0] + result.values[1], tree.pot());
+}
+
+TEST(BestResponse, ThreadsDoNotChangeTheResult) {
+    const auto tree = turnTree();
+    const Solver::BestResponse serial{tree, range({"AA"_r, "KK"_r}), range({"AK"_r, "QQ"_r}), TURN, 1};
+
+    // fewer threads than root actions, spare threads handed down to the subtrees, and many threads
+    for (const unsigned threads : {2u, 3u, 5u, 64u}) {
+        const Solver::BestResponse parallel{tree, range({"AA"_r, "KK"_r}), range({"AK"_r, "QQ"_r}), TURN, threads};
+        for (int p = 0; p < 2; ++p) {
+            const auto a = serial.handValues(p, uniform);
+            const auto b = parallel.handValues(p, uniform);
+            ASSERT_EQ(a.size(), b.size());
+            for (size_t h = 0; h < a.size(); ++h) EXPECT_NEAR(a[h], b[h], 1e-9);
+        }
+    }
+}
+
+TEST(BestResponse, WorkerExceptionsReachTheCaller) {
+    const auto tree = turnTree();
+    const Solver::BestResponse engine{tree, range({"AA"_r, "KK"_r}), range({"AK"_r, "QQ"_r}), TURN, 4};
+    // fails only on the river, inside the chance node's worker threads
+    auto throwing = [](size_t node, CardMask board, std::span<const CardMask> hands, std::span<double> strategy) {
+        if (std::popcount(board) == 5) throw std::invalid_argument("Profile hands do not match");
+        uniform(node, board, hands, strategy);
+    };
+    EXPECT_THROW(engine.compute(throwing), std::invalid_argument);
+}
+
+TEST(BestResponse, TrainingReducesMCCFRExploitability) {
+    const auto tree = turnTree();
+    const Range oop = range({"AA"_r, "KK"_r, "QQ"_r, "JJ"_r}), ip = range({"AK"_r, "AQ"_r, "KQ"_r, "TT"_r});
+    const Solver::BestResponse engine{tree, oop, ip, TURN, 4};
+
+    // exact abstraction for a fixed turn: the combo, and on the river the river card too
+    const CardMask turn = cardsMask(TURN.get());
+    Solver::CardAbstraction exact{{NUM_COMBOS, NUM_COMBOS, NUM_COMBOS * NUM_CARDS}, [turn](CardMask hero, CardMask board) {
+        const auto combo = static_cast<uint32_t>(comboIndex(std::countr_zero(hero), 63 - std::countl_zero(hero)));
+        const CardMask river = board & ~turn;
+        return river ? combo * NUM_CARDS + std::countr_zero(river) : combo;
+    }};
+
+    Solver::MCCFROptions options{};
+    options.threads = 4;
+    Solver::MCCFRSolver solver{tree, oop, ip, TURN, exact, options};
+    solver.run(2000);
+    const double early = engine.compute(Solver::averageStrategyProfile(solver)).exploitability;
+    solver.run(400000);
+    const double late = engine.compute(Solver::averageStrategyProfile(solver)).exploitability;
+
+    EXPECT_LT(late, early);
+    EXPECT_LT(late, 0.06 * tree.pot());
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "PokerEngine/solver/game_tree.hpp"
+
+using namespace PokerEngine;
+using Solver::TreeNode;
+using Solver::BetAction;
+
+namespace {
+    Solver::GameTreeConfig turnConfig() {
+        Solver::GameTreeConfig config{};
+        config.board_size = 4;
+        config.pot = 100;
+        config.stacks = {500, 400};
+        for (auto& street : config.streets) {
+            street.bet_sizes = {0.5, 1.0};
+            street.raise_sizes = {1.0};
+            street.max_raises = 1;
+        }
+        return config;
+    }
+}
+
+TEST(GameTree, EstimateMatchesBuiltTree) {
+    const auto config = turnConfig();
+    const auto size = Solver::GameTree::estimate(config);
+    const Solver::GameTree tree{config};
+
+    EXPECT_EQ(tree.size(), size.nodes);
+    EXPECT_EQ(tree.numActions(), size.actions);
+    EXPECT_EQ(size.treeBytes(), size.nodes * sizeof(TreeNode));
+    EXPECT_EQ(size.storageBytes(10, sizeof(double)), size.actions * 10 * sizeof(double));
+
+    size_t action_nodes = 0, next_offset = 0;
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& node = tree.node(i);
+        if (i > 0) {
+            EXPECT_LT(node.parent, i);
+        }
+        for (const auto& c : tree.children(i)) EXPECT_EQ(&tree.node(c.parent), &node);
+        if (node.type != TreeNode::Type::Action) continue;
+        ++action_nodes;
+        // action slots are handed out in node order without gaps
+        EXPECT_EQ(node.action_offset, next_offset);
+        next_offset += node.num_children;
+    }
+    EXPECT_EQ(action_nodes, size.action_nodes);
+}
+
+TEST(GameTree, LegalActionsFollowStacks) {
+    const Solver::GameTree tree{turnConfig()};
+
+    // check, bet 50, bet 100, all-in capped at the shorter stack
+    const auto root = tree.children(0);
+    ASSERT_EQ(root.size(), 4u);
+    EXPECT_EQ(root[0].action.kind, BetAction::Kind::Check);
+    EXPECT_EQ(root[1].action.amount, 50);
+    EXPECT_EQ(root[2].action.amount, 100);
+    EXPECT_EQ(root[3].action.amount, 400);
+
+    // check-check on the turn deals the river, where player 0 acts first again
+    const auto after_check = tree.children(tree.root().first_child);
+    ASSERT_EQ(after_check[0].type, TreeNode::Type::Chance);
+    EXPECT_EQ(after_check[0].board_size, 5);
+    const auto& river = tree.node(after_check[0].first_child);
+    EXPECT_EQ(river.player, 0);
+    EXPECT_EQ(river.board_size, 5);
+
+    // calling an all-in goes straight to showdown, with the turn board
+    const auto facing_all_in = tree.children(tree.root().first_child + 3);
+    ASSERT_EQ(facing_all_in.size(), 2u);
+    EXPECT_EQ(facing_all_in[1].type, TreeNode::Type::Showdown);
+    EXPECT_EQ(facing_all_in[1].board_size, 4);
+    EXPECT_EQ(facing_all_in[1].commit, (std::array<int32_t, 2>{400, 400}));
+}
+
+TEST(GameTree, PayoffsFollowPot) {
+    const Solver::GameTree tree{turnConfig()};
+    const size_t bet = tree.root().first_child + 1;
+    const auto& fold = tree.children(bet)[0];
+    ASSERT_EQ(fold.type, TreeNode::Type::Fold);
+
+    // player 1 folds to a 50 bet: player 0 wins the pot and gets the bet back
+    EXPECT_DOUBLE_EQ(tree.payoff(fold, 0), 100.0);
+    EXPECT_DOUBLE_EQ(tree.payoff(fold, 1), 0.0);
+
+    const auto& call = tree.children(bet)[1];
+    ASSERT_EQ(call.type, TreeNode::Type::Chance);
+    EXPECT_THROW(tree.payoff(tree.node(call.first_child), 0), std::invalid_argument);
+
+    const auto& all_in_call = tree.children(tree.root().first_child + 3)[1];
+    EXPECT_DOUBLE_EQ(tree.payoff(all_in_call, 0, 1), 500.0);
+    EXPECT_DOUBLE_EQ(tree.payoff(all_in_call, 0, -1), -400.0);
+    EXPECT_DOUBLE_EQ(tree.payoff(all_in_call, 1, 0), 50.0);
+}
+
+TEST(GameTree, SavesAndMapsBack) {
+    const Solver::GameTree tree{turnConfig()};
+    const auto path = (std::filesystem::temp_directory_path() / "game_tree_test.pegt").string();
+    tree.save(path);
+
+    {
+        const auto loaded = Solver::GameTree::load(path);
+        ASSERT_EQ(loaded.size(), tree.size());
+        EXPECT_EQ(loaded.numActions(), tree.numActions());
+        EXPECT_EQ(loaded.pot(), 100);
+        EXPECT_EQ(loaded.stacks(), (std::array<int, 2>{500, 400}));
+        EXPECT_EQ(loaded.boardSize(), 4);
+        for (size_t i = 0; i < tree.size(); ++i) {
+            EXPECT_EQ(loaded.node(i).first_child, tree.node(i).first_child);
+            EXPECT_EQ(loaded.node(i).action.amount, tree.node(i).action.amount);
+            EXPECT_EQ(loaded.node(i).commit, tree.node(i).commit);
+        }
+
+        Solver::ActionTable<float> regrets{loaded, 3};
+        EXPECT_EQ(regrets.values().size(), loaded.numActions() * 3);
+        EXPECT_EQ(regrets.at(loaded.root()).size(), loaded.root().num_children * 3u);
+    }
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(Solver::GameTree::load(path), std::runtime_error);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+#include "PokerEngine/solver/mccfr.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+using Solver::TreeNode;
+
+namespace {
+    const Board RIVER{{"As"_c, "Ks"_c, "Qd"_c, "7c"_c, "2h"_c}};
+
+    Solver::GameTree polarisedTree() {
+        Solver::GameTreeConfig config{};
+        config.board_size = 5;
+        config.pot = 100;
+        config.stacks = {100, 100};
+        config.streets[2].bet_sizes = {1.0};
+        config.streets[2].max_raises = 0;
+        config.streets[2].all_in = false;
+        return Solver::GameTree{config};
+    }
+
+    Range polarisedRange() {
+        Range range{};
+        range.addCombo("Ah"_c, "Ad"_c);
+        range.addCombo("Ah"_c, "Ac"_c);
+        range.addCombo("Ad"_c, "Ac"_c);
+        range.addCombo("4c"_c, "3d"_c);
+        range.addCombo("4d"_c, "3c"_c);
+        range.addCombo("4h"_c, "3c"_c);
+        return range;
+    }
+
+    uint32_t comboBucket(Card a, Card b) {
+        return static_cast<uint32_t>(comboIndex(cardIndex(a), cardIndex(b)));
+    }
+}
+
+TEST(MCCFRSolver, ConvergesOnPolarisedRiver) {
+    // OOP holds the nuts or air, IP only bluff catchers: a pot sized bet is made with one bluff per two
+    // value hands and called half the time
+    const auto tree = polarisedTree();
+    Solver::MCCFROptions options{};
+    options.threads = 4;
+    Solver::MCCFRSolver solver{tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::comboAbstraction(), options};
+    solver.run(200000);
+    EXPECT_EQ(solver.iterations(), 200000u);
+
+    const size_t root = 0;
+    const size_t bet = tree.root().first_child + 1;
+    ASSERT_EQ(tree.node(bet).action.kind, Solver::BetAction::Kind::Bet);
+
+    const double value_bet = solver.averageStrategy(root, comboBucket("Ah"_c, "Ad"_c))[1];
+    const double bluff = (solver.averageStrategy(root, comboBucket("4c"_c, "3d"_c))[1] +
+                          solver.averageStrategy(root, comboBucket("4d"_c, "3c"_c))[1] +
+                          solver.averageStrategy(root, comboBucket("4h"_c, "3c"_c))[1]) / 3.0;
+    // combos of a class are interchangeable, only the class totals are pinned down
+    double call = 0.0;
+    const Range catchers{"88"_r};
+    for (const auto& combo : catchers.combos()) {
+        call += solver.averageStrategy(bet, comboBucket(combo.c1, combo.c2))[1] / 6.0;
+    }
+
+    EXPECT_GT(value_bet, 0.9);
+    EXPECT_NEAR(bluff, 0.5, 0.15);
+    EXPECT_NEAR(call, 0.5, 0.15);
+}
+
+TEST(MCCFRSolver, PlaysThroughLaterStreets) {
+    Solver::GameTreeConfig config{};
+    config.board_size = 4;
+    config.stacks = {200, 200};
+    for (auto& street : config.streets) {
+        street.bet_sizes = {0.75};
+        street.max_raises = 1;
+    }
+    const Solver::GameTree tree{config};
+    const Board turn{{"As"_c, "Ks"_c, "Qd"_c, "7c"_c}};
+
+    Solver::MCCFROptions options{};
+    options.threads = 2;
+    Solver::MCCFRSolver solver{tree, Range{"JJ"_r}, Range{"AK"_r}, turn, Solver::comboAbstraction(), options};
+    solver.run(20000);
+
+    // river nodes were reached: some river action node has strategy sums for a hand in range
+    const uint32_t jj = comboBucket("Jh"_c, "Jd"_c);
+    bool visited_river = false;
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& node = tree.node(i);
+        if (node.type != TreeNode::Type::Action) continue;
+        const auto strategy = solver.averageStrategy(i, jj);
+        EXPECT_NEAR(std::accumulate(strategy.begin(), strategy.end(), 0.0), 1.0, 1e-9);
+        if (node.board_size == 5 && node.player == 0 && strategy[0] != 1.0 / strategy.size()) visited_river = true;
+    }
+    EXPECT_TRUE(visited_river);
+}
+
+TEST(MCCFRSolver, CheckpointsAndResumes) {
+    const auto tree = polarisedTree();
+    const auto path = (std::filesystem::temp_directory_path() / "mccfr_test.pemc").string();
+
+    Solver::MCCFROptions options{};
+    options.threads = 2;
+    options.checkpoint_path = path;
+    options.checkpoint_every = 500;
+    std::vector<uint64_t> checkpoints;
+    options.on_checkpoint = [&](uint64_t iterations) { checkpoints.push_back(iterations); };
+
+    Solver::MCCFRSolver solver{tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::comboAbstraction(), options};
+    solver.run(1200);
+    EXPECT_EQ(checkpoints, (std::vector<uint64_t>{500, 1000}));
+    solver.saveCheckpoint(path);
+
+    Solver::MCCFRSolver resumed{tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::comboAbstraction()};
+    resumed.loadCheckpoint(path);
+    EXPECT_EQ(resumed.iterations(), 1200u);
+    const uint32_t aces = comboBucket("Ah"_c, "Ad"_c);
+    EXPECT_EQ(resumed.averageStrategy(0, aces), solver.averageStrategy(0, aces));
+
+    Solver::GameTreeConfig other{};
+    const Solver::GameTree other_tree{other};
+    Solver::MCCFRSolver mismatched{other_tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::comboAbstraction()};
+    EXPECT_THROW(mismatched.loadCheckpoint(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(MCCFRSolver, AccumulatesPastFloatPrecision) {
+    // resume at iteration 2^26 with strategy sums near (2^26)^2 / 2: a float sum's rounding step there is
+    // 2^28, so the at most 2^26 an iteration adds would round away and the average would freeze
+    const auto tree = polarisedTree();
+    const auto path = (std::filesystem::temp_directory_path() / "mccfr_precision_test.pemc").string();
+    Solver::MCCFROptions options{};
+    options.threads = 2;
+    Solver::MCCFRSolver solver{tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::comboAbstraction(), options};
+    solver.run(1000);
+    solver.saveCheckpoint(path);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    Solver::MCCFRSolver::CheckpointHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.iterations = uint64_t{1} << 26;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    const uint32_t aces = comboBucket("Ah"_c, "Ad"_c);
+    const size_t sums = sizeof(header) + header.num_actions * header.slots * sizeof(double);
+    for (size_t a = 0; a < 2; ++a) {
+        const double sum = 0x1p51;
+        const size_t offset = sums + ((tree.root().action_offset + a) * header.slots + aces) * sizeof(double);
+        std::memcpy(bytes.data() + offset, &sum, sizeof(sum));
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    solver.loadCheckpoint(path);
+    EXPECT_DOUBLE_EQ(solver.averageStrategy(0, aces)[1], 0.5);
+    solver.run(1000);
+    EXPECT_EQ(solver.iterations(), (uint64_t{1} << 26) + 1000);
+    // the aces mostly bet, so the late iterations still pull the average towards betting
+    EXPECT_GT(solver.averageStrategy(0, aces)[1], 0.5);
+    std::filesystem::remove(path);
+}
+
+TEST(MCCFRSolver, RejectsMismatchedBoard) {
+    const auto tree = polarisedTree();
+    const Board flop{{"As"_c, "Ks"_c, "Qd"_c}};
+    EXPECT_THROW((Solver::MCCFRSolver{tree, polarisedRange(), Range{"88"_r}, flop, Solver::comboAbstraction()}),
+                 std::invalid_argument);
+    EXPECT_THROW((Solver::MCCFRSolver{tree, polarisedRange(), Range{"88"_r}, RIVER, Solver::CardAbstraction{}}),
+                 std::invalid_argument);
+}
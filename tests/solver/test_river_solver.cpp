@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "PokerEngine/solver/river_solver.hpp"
+
+using namespace PokerEngine;
+using namespace PokerEngine::Core;
+using namespace PokerEngine::Core::literals;
+
+namespace {
+    const Board BOARD{{"As"_c, "Ks"_c, "Qd"_c, "7c"_c, "2h"_c}};
+
+    size_t child(const Solver::RiverSolver& solver, size_t node, Solver::BetAction::Kind kind) {
+        const auto& n = solver.nodes()[node];
+        for (size_t c = 0; c < n.num_children; ++c) {
+            if (solver.nodes()[n.first_child + c].action.kind == kind) return n.first_child + c;
+        }
+        throw std::logic_error("no such action");
+    }
+
+    // mean probability of taking the action over the hands matching the predicate
+    template<typename Pred>
+    double frequency(const Solver::RiverSolver& solver, size_t node, size_t action, Pred pred) {
+        const auto& n = solver.nodes()[node];
+        const auto& hands = solver.hands(n.player);
+        const auto strategy = solver.averageStrategy(node);
+        double total = 0.0, count = 0.0;
+        for (size_t h = 0; h < hands.size(); ++h) {
+            if (!pred(hands[h])) continue;
+            total += strategy[action * hands.size() + h];
+            count += 1.0;
+        }
+        return total / count;
+    }
+}
+
+TEST(RiverSolver, BuildsBettingTree) {
+    Solver::RiverSolverConfig config{};
+    config.bet_sizes = {0.5, 1.0};
+    config.raise_sizes = {1.0};
+    config.max_raises = 1;
+    Solver::RiverSolver solver{Range{"AA"_r}, Range{"KK"_r}, BOARD, 100, 400, 300, config};
+
+    const auto& root = solver.root();
+    ASSERT_EQ(root.num_children, 4); // check, bet 50, bet 100, all-in 300
+    EXPECT_EQ(solver.nodes()[root.first_child].action.kind, Solver::BetAction::Kind::Check);
+    EXPECT_EQ(solver.nodes()[root.first_child + 1].action.amount, 50);
+    EXPECT_EQ(solver.nodes()[root.first_child + 2].action.amount, 100);
+    EXPECT_EQ(solver.nodes()[root.first_child + 3].action.amount, 300);
+
+    // facing a 50 bet: fold, call, raise to 50 + 200 = 250, all-in
+    const auto& facing = solver.nodes()[root.first_child + 1];
+    ASSERT_EQ(facing.num_children, 4);
+    EXPECT_EQ(solver.nodes()[facing.first_child + 2].action.amount, 250);
+    EXPECT_EQ(solver.nodes()[facing.first_child + 3].action.amount, 300);
+}
+
+TEST(RiverSolver, PolarisedBettorBluffsAtIndifferenceFrequency) {
+    // OOP holds the nuts or air, IP only bluff catchers. A pot sized all-in bet should be made with
+    // one bluff per two value hands and called half the time.
+    Range oop{};
+    oop.addCombo("Ah"_c, "Ad"_c);
+    oop.addCombo("Ah"_c, "Ac"_c);
+    oop.addCombo("Ad"_c, "Ac"_c);
+    oop.addCombo("4c"_c, "3d"_c);
+    oop.addCombo("4d"_c, "3c"_c);
+    oop.addCombo("4h"_c, "3c"_c);
+    Range ip{"88"_r};
+
+    Solver::RiverSolverConfig config{};
+    config.bet_sizes = {1.0};
+    config.max_raises = 0;
+    config.all_in = false;
+    Solver::RiverSolver solver{oop, ip, BOARD, 100, 100, 100, config};
+
+    const double exploitability = solver.solve(2000, 0.001);
+    EXPECT_LT(exploitability, 0.1);
+
+    const CardMask aces = cardMask("Ah"_c) | cardMask("Ad"_c) | cardMask("Ac"_c);
+    const size_t bet = child(solver, 0, Solver::BetAction::Kind::Bet);
+    const size_t bet_action = bet - solver.root().first_child;
+    EXPECT_NEAR(frequency(solver, 0, bet_action, [&](CardMask h) { return (h & aces) != 0; }), 1.0, 0.02);
+    EXPECT_NEAR(frequency(solver, 0, bet_action, [&](CardMask h) { return (h & aces) == 0; }), 0.5, 0.05);
+
+    const size_t call = child(solver, bet, Solver::BetAction::Kind::Call) - solver.nodes()[bet].first_child;
+    EXPECT_NEAR(frequency(solver, bet, call, [](CardMask) { return true; }), 0.5, 0.05);
+}
+
+TEST(RiverSolver, ConvergesOnRealRanges) {
+    Range oop{"AK"_r};
+    for (auto token : {"KQ"_r, "QJ"_r, "JT"_r, "77"_r, "22"_r, "A5s"_r, "65s"_r}) oop.addCombo(token);
+    Range ip{"AQ"_r};
+    for (auto token : {"KJ"_r, "QQ"_r, "TT"_r, "99"_r, "88"_r, "T9s"_r, "A4s"_r}) ip.addCombo(token);
+
+    Solver::RiverSolver solver{oop, ip, BOARD, 100, 200, 200};
+    std::vector<double> measured;
+    const double exploitability = solver.solve(1000, 0.005, 50, [&](int, double e) { measured.push_back(e); });
+
+    ASSERT_FALSE(measured.empty());
+    EXPECT_LT(exploitability, 0.005 * solver.pot() + 1e-9);
+    EXPECT_LT(measured.back(), measured.front());
+
+    // EVs of the two players add up to the pot against equilibrium strategies
+    auto weighted_ev = [&](int p) {
+        const auto ev = solver.expectedValues(p);
+        return std::accumulate(ev.begin(), ev.end(), 0.0) / ev.size();
+    };
+    EXPECT_GT(weighted_ev(0), 0.0);
+    EXPECT_GT(weighted_ev(1), 0.0);
+}
+
+TEST(RiverSolver, OverlappingTokensMatchSummedWeights) {
+    // KK added twice is the same range as KK once at double weight
+    Range overlapping{"QQ+"_r};
+    overlapping.addCombo("KK"_r);
+    Range summed{"QQ+"_r};
+    for (size_t i = 0; i < summed.size(); ++i) {
+        if (summed.combos()[i].c1.rank() == Rank::King) summed.setWeight(i, 2.0);
+    }
+    const Range ip{"AK"_r};
+
+    Solver::RiverSolver a{overlapping, ip, BOARD, 100, 200, 200};
+    Solver::RiverSolver b{summed, ip, BOARD, 100, 200, 200};
+    ASSERT_EQ(a.hands(0).size(), b.hands(0).size());
+    a.solve(200, 0.0, 200);
+    b.solve(200, 0.0, 200);
+    EXPECT_NEAR(a.exploitability(), b.exploitability(), 1e-9);
+    const auto ev_a = a.expectedValues(1), ev_b = b.expectedValues(1);
+    for (size_t h = 0; h < ev_a.size(); ++h) EXPECT_NEAR(ev_a[h], ev_b[h], 1e-9);
+}
+
+TEST(RiverSolver, RejectsIncompleteBoard) {
+    EXPECT_THROW((Solver::RiverSolver{Range{"AA"_r}, Range{"KK"_r}, Board{{"2c"_c, "3d"_c, "4h"_c}}, 100, 100, 100}),
+                 std::invalid_argument);
+}
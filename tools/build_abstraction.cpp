@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <mutex>
+
+#include "PokerEngine/abstraction/abstraction_builder.hpp"
+
+using namespace PokerEngine;
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " OUTPUT_FILE BOARD_SIZE BUCKETS [THREADS] [BINS]\n"
+                  << "  BOARD_SIZE is 3 (flop), 4 (turn) or 5 (river)\n";
+        return 1;
+    }
+
+    Abstraction::AbstractionOptions options{};
+    const std::string path = argv[1];
+    options.board_size = std::stoi(argv[2]);
+    const unsigned long buckets = std::stoul(argv[3]);
+    if (buckets == 0 || buckets > std::numeric_limits<uint16_t>::max()) {
+        std::cerr << "BUCKETS must be between 1 and " << std::numeric_limits<uint16_t>::max() << "\n";
+        return 1;
+    }
+    options.num_buckets = static_cast<uint16_t>(buckets);
+    if (argc > 4) options.threads = static_cast<unsigned>(std::stoul(argv[4]));
+    if (argc > 5) options.bins = std::stoul(argv[5]);
+
+    // histogram workers report every block of situations, print only when the percentage moves;
+    // clustering reports once per iteration, so every report is printed
+    std::mutex print_mutex;
+    size_t printed_percent = 0;
+    options.progress = [&](const char* stage, size_t done, size_t total) {
+        const bool clustering = std::string(stage) == "clustering";
+        const size_t percent = total > 0 ? done * 100 / total : 100;
+        std::lock_guard lock(print_mutex);
+        if (!clustering && percent <= printed_percent && done != total) return;
+        printed_percent = percent;
+        std::cerr << "\r" << stage << ": " << done << " / " << total << "        " << std::flush;
+    };
+
+    try {
+        const auto stats = Abstraction::buildAbstraction(path, options);
+        std::cerr << "\nClustered " << stats.situations << " situations in " << stats.iterations
+                  << " iterations, wrote " << path << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "\nAbstraction error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <mutex>
+
+#include "PokerEngine/simulator/preflop_table.hpp"
+
+using namespace PokerEngine;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " OUTPUT_FILE [THREADS]\n";
+        return 1;
+    }
+
+    const std::string path = argv[1];
+    const unsigned threads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : std::thread::hardware_concurrency();
+
+    std::mutex print_mutex;
+    try {
+        Simulator::generatePreflopTable(path, threads, [&](size_t done, size_t total) {
+            if (done % 100 != 0 && done != total) return;
+            std::lock_guard lock(print_mutex);
+            std::cerr << "\r" << done << " / " << total << " isomorphism classes" << std::flush;
+        });
+        std::cerr << "\nWrote " << path << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "\nGeneration error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}